@@ -0,0 +1,59 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+// Times a function and prints the mean duration of a call.
+// With --quick (as in CTest), each function runs once, to check that the
+// benchmark still works without waiting for the measure.
+class Benchmark {
+ public:
+  Benchmark(int argc, char** argv)
+      : quick_(argc > 1 && strcmp(argv[1], "--quick") == 0) {}
+
+  bool quick() const {
+    return quick_;
+  }
+
+  // Calls fn() for about half a second, and prints the time per call, and the
+  // throughput if bytes (the input size of a call) isn't zero
+  template <typename TFunction>
+  void run(const char* name, size_t bytes, TFunction fn) {
+    using clock = std::chrono::steady_clock;
+    fn();  // warm up
+    long calls = 0;
+    auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+    do {
+      fn();
+      calls++;
+      elapsed = clock::now() - start;
+    } while (!quick_ && elapsed < std::chrono::milliseconds(500));
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    double us = seconds * 1e6 / static_cast<double>(calls);
+    if (bytes)
+      printf("%-40s %10.2f us %10.1f MB/s\n", name, us,
+             static_cast<double>(bytes) * static_cast<double>(calls) /
+                 seconds / 1e6);
+    else
+      printf("%-40s %10.2f us\n", name, us);
+  }
+
+ private:
+  bool quick_;
+};
+
+// Prevents the compiler from optimizing away a result
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__)
+  __asm__ __volatile__("" : : "g"(&value) : "memory");
+#else
+  (void)value;
+#endif
+}
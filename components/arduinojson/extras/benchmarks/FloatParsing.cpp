@@ -0,0 +1,63 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Measures the parsing of floating-point numbers, compared to strtod().
+// This file is compiled twice: with ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING set
+// to 1, and with the default.
+
+#include <ArduinoJson.h>
+
+#include <stdlib.h>
+
+#include "Benchmark.hpp"
+
+using namespace ArduinoJson;
+
+// An array of pseudo-random numbers with the given number of significant
+// digits, spread over a few orders of magnitude
+static std::string makeNumbers(int count, int precision) {
+  std::string json = "[";
+  char buffer[64];
+  srand(42);
+  for (int i = 0; i < count; i++) {
+    double value = double(rand()) / RAND_MAX * 1000 + double(rand()) / 1e6;
+    snprintf(buffer, sizeof(buffer), "%s%.*g", i ? "," : "", precision,
+             value);
+    json += buffer;
+  }
+  json += "]";
+  return json;
+}
+
+int main(int argc, char** argv) {
+  Benchmark benchmark(argc, argv);
+  printf("ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING=%d\n",
+         ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING);
+
+  int count = benchmark.quick() ? 100 : 10000;
+  std::string shortNumbers = makeNumbers(count, 6);  // like sensor readings
+  std::string longNumbers = makeNumbers(count, 17);  // like printf("%.17g")
+
+  JsonDocument doc;
+  benchmark.run("6 digits, deserializeJson()", shortNumbers.size(), [&]() {
+    doNotOptimize(
+        deserializeJson(doc, shortNumbers.data(), shortNumbers.size()));
+  });
+  benchmark.run("17 digits, deserializeJson()", longNumbers.size(), [&]() {
+    doNotOptimize(deserializeJson(doc, longNumbers.data(), longNumbers.size()));
+  });
+
+  // the same numbers, with strtod() instead of the parser
+  benchmark.run("17 digits, strtod()", longNumbers.size(), [&]() {
+    const char* p = longNumbers.c_str() + 1;
+    double sum = 0;
+    while (*p) {
+      char* end;
+      sum += strtod(p, &end);
+      p = end + 1;
+    }
+    doNotOptimize(sum);
+  });
+  return 0;
+}
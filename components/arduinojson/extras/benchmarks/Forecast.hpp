@@ -0,0 +1,44 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <stdio.h>
+#include <string>
+
+// Generates a payload shaped like a daily weather forecast: long phrases,
+// URLs, dates, short decimals, and a few nested objects per day
+inline std::string makeForecast(int days) {
+  std::string json =
+      "{\"Headline\":{\"EffectiveDate\":\"2024-03-12T07:00:00+01:00\","
+      "\"EffectiveEpochDate\":1710223200,\"Severity\":4,"
+      "\"Text\":\"Expect showery weather Wednesday morning through Thursday "
+      "evening\",\"Category\":\"rain\",\"MobileLink\":\"http://www.accuweather."
+      "com/en/fr/paris/623/daily-weather-forecast/623?lang=en-us\"},"
+      "\"DailyForecasts\":[";
+  char buffer[1024];
+  for (int i = 0; i < days; i++) {
+    snprintf(
+        buffer, sizeof(buffer),
+        "%s{\"Date\":\"2024-03-%02dT07:00:00+01:00\",\"EpochDate\":%d,"
+        "\"Sun\":{\"Rise\":\"2024-03-%02dT07:13:00+01:00\",\"Set\":\"2024-03-"
+        "%02dT18:44:00+01:00\"},\"Temperature\":{\"Minimum\":{\"Value\":%d.%d,"
+        "\"Unit\":\"C\",\"UnitType\":17},\"Maximum\":{\"Value\":%d.%d,"
+        "\"Unit\":\"C\",\"UnitType\":17}},\"Day\":{\"Icon\":%d,\"IconPhrase\":"
+        "\"Mostly cloudy w/ showers\",\"HasPrecipitation\":true,"
+        "\"LongPhrase\":\"Cloudy with a couple of showers, mainly later in the "
+        "day; breezy in the afternoon \\u2013 gusts up to %d km/h\","
+        "\"RainProbability\":%d,\"Wind\":{\"Speed\":{\"Value\":%d.%d,"
+        "\"Unit\":\"km/h\"},\"Direction\":{\"Degrees\":%d,\"English\":\"SW\"}}}"
+        ",\"Link\":\"http://www.accuweather.com/en/fr/paris/623/daily-weather-"
+        "forecast/623?day=%d&lang=en-us\"}",
+        i ? "," : "", 12 + i % 18, 1710223200 + i * 86400, 12 + i % 18,
+        12 + i % 18, -4 + i % 9, i % 10, 11 + i % 7, (i * 3) % 10, 12 + i % 20,
+        40 + i % 30, (i * 7) % 100, 10 + i % 25, (i * 9) % 10, (i * 37) % 360,
+        i + 1);
+    json += buffer;
+  }
+  json += "]}";
+  return json;
+}
@@ -0,0 +1,53 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Compares deserializeJsonInPlace() with the copying deserializeJson(), in
+// time and in peak heap, on a forecast payload of the size of the station's
+// 23000-byte receive buffer.
+
+#include <ArduinoJson.h>
+
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "Forecast.hpp"
+
+using namespace ArduinoJson;
+
+int main(int argc, char** argv) {
+  Benchmark benchmark(argc, argv);
+  std::string json = makeForecast(34);
+  std::vector<char> buffer(json.size());
+  printf("payload: %zu bytes\n", json.size());
+
+  InstrumentedAllocator copyingAllocator;
+  size_t copyingParses = 0;
+  benchmark.run("deserializeJson()", json.size(), [&]() {
+    memcpy(buffer.data(), json.data(), json.size());
+    JsonDocument doc(&copyingAllocator);
+    DeserializationError err = deserializeJson(
+        doc, static_cast<const char*>(buffer.data()), buffer.size());
+    doNotOptimize(err);
+    copyingParses++;
+  });
+
+  InstrumentedAllocator inPlaceAllocator;
+  size_t inPlaceParses = 0;
+  benchmark.run("deserializeJsonInPlace()", json.size(), [&]() {
+    memcpy(buffer.data(), json.data(), json.size());
+    JsonDocument doc(&inPlaceAllocator);
+    DeserializationError err =
+        deserializeJsonInPlace(doc, buffer.data(), buffer.size());
+    doNotOptimize(err);
+    inPlaceParses++;
+  });
+
+  printf("peak heap: %zu bytes copying, %zu bytes in place\n",
+         copyingAllocator.stats().peakBytes,
+         inPlaceAllocator.stats().peakBytes);
+  printf("allocations per parse: %zu copying, %zu in place\n",
+         copyingAllocator.stats().allocations / copyingParses,
+         inPlaceAllocator.stats().allocations / inPlaceParses);
+  return 0;
+}
@@ -0,0 +1,66 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Measures the documents with many distinct strings, whose pool is searched
+// each time a string is saved or released.
+// This file is compiled twice: with ARDUINOJSON_ENABLE_STRING_INDEX set to 1,
+// and with the default.
+
+#include <ArduinoJson.h>
+
+#include "Benchmark.hpp"
+
+using namespace ArduinoJson;
+
+static std::string makeStrings(int count) {
+  std::string json = "[";
+  char buffer[32];
+  for (int i = 0; i < count; i++) {
+    snprintf(buffer, sizeof(buffer), "%s\"sensor-%05d\"", i ? "," : "", i);
+    json += buffer;
+  }
+  json += "]";
+  return json;
+}
+
+static void runAll(Benchmark& benchmark, int count) {
+  std::string json = makeStrings(count);
+  JsonDocument doc;
+  char name[64];
+
+  snprintf(name, sizeof(name), "%d strings, deserializeJson()", count);
+  benchmark.run(name, json.size(), [&]() {
+    doNotOptimize(deserializeJson(doc, json));
+  });
+
+  // the same strings again: each one is found in the pool
+  JsonDocument copy;
+  snprintf(name, sizeof(name), "%d strings, copy", count);
+  benchmark.run(name, json.size(), [&]() {
+    copy.clear();
+    for (JsonVariant value : doc.as<JsonArray>())
+      copy.add(value.as<std::string>());
+    doNotOptimize(copy);
+  });
+
+  // each removal releases a string; the first element is the fastest to find
+  snprintf(name, sizeof(name), "%d strings, remove one by one", count);
+  benchmark.run(name, json.size(), [&]() {
+    copy.set(doc);
+    for (int i = 0; i < count; i++)
+      copy.remove(0);
+    doNotOptimize(copy);
+  });
+}
+
+int main(int argc, char** argv) {
+  Benchmark benchmark(argc, argv);
+  printf("ARDUINOJSON_ENABLE_STRING_INDEX=%d\n",
+         ARDUINOJSON_ENABLE_STRING_INDEX);
+
+  runAll(benchmark, 1000);
+  if (!benchmark.quick())
+    runAll(benchmark, 10000);
+  return 0;
+}
@@ -0,0 +1,51 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Measures the kernels of StringScanner.hpp on a long string, and their
+// effect on deserializeJson(): a NUL-terminated input is scanned one
+// character at a time, a sized input with the kernels.
+
+#include <ArduinoJson.h>
+
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "Forecast.hpp"
+
+using namespace ArduinoJson;
+using namespace ArduinoJson::detail;
+
+int main(int argc, char** argv) {
+  Benchmark benchmark(argc, argv);
+
+  std::vector<char> text(64 * 1024, 'a');
+  text.back() = '"';
+  const char* begin = text.data();
+  const char* end = begin + text.size();
+  SpecialCharInString match('"');
+
+  benchmark.run("findFirstScalar()", text.size(), [&]() {
+    doNotOptimize(findFirstScalar(begin, end, match));
+  });
+#if ARDUINOJSON_SIZEOF_POINTER >= 4
+  benchmark.run("findFirstSwar()", text.size(), [&]() {
+    doNotOptimize(findFirstSwar(begin, end, match));
+  });
+#endif
+#if ARDUINOJSON_ENABLE_SIMD
+  benchmark.run("findFirstSimd()", text.size(), [&]() {
+    doNotOptimize(findFirstSimd(begin, end, match));
+  });
+#endif
+
+  std::string json = makeForecast(34);
+  JsonDocument doc;
+  benchmark.run("deserializeJson(const char*)", json.size(), [&]() {
+    doNotOptimize(deserializeJson(doc, json.c_str()));
+  });
+  benchmark.run("deserializeJson(const char*, size_t)", json.size(), [&]() {
+    doNotOptimize(deserializeJson(doc, json.data(), json.size()));
+  });
+  return 0;
+}
@@ -0,0 +1,61 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Measures deserializeJson() on multi-megabyte inputs. This file is compiled
+// twice: with ARDUINOJSON_ENABLE_STRUCTURAL_INDEX set to 1 for the two-stage
+// parser, and with the default for the regular one.
+
+#include <ArduinoJson.h>
+
+#include "Benchmark.hpp"
+#include "Forecast.hpp"
+
+using namespace ArduinoJson;
+
+// An array of records with many numbers and few strings
+static std::string makeMeasurements(int count) {
+  std::string json = "[";
+  char buffer[128];
+  for (int i = 0; i < count; i++) {
+    snprintf(buffer, sizeof(buffer),
+             "%s{\"t\":%d,\"temp\":%d.%d,\"hum\":%d,\"ok\":%s}", i ? "," : "",
+             1710223200 + i * 60, 15 + i % 10, i % 10, 40 + i % 50,
+             i % 7 ? "true" : "false");
+    json += buffer;
+  }
+  json += "]";
+  return json;
+}
+
+int main(int argc, char** argv) {
+  Benchmark benchmark(argc, argv);
+  printf("ARDUINOJSON_ENABLE_STRUCTURAL_INDEX=%d\n",
+         ARDUINOJSON_ENABLE_STRUCTURAL_INDEX);
+
+  // smaller inputs with --quick, so that CTest doesn't wait
+  int scale = benchmark.quick() ? 1 : 100;
+
+  std::string forecast = makeForecast(40 * scale);
+  std::string measurements = makeMeasurements(500 * scale);
+  printf("forecast: %zu bytes, measurements: %zu bytes\n", forecast.size(),
+         measurements.size());
+
+  JsonDocument doc;
+  benchmark.run("forecast", forecast.size(), [&]() {
+    doNotOptimize(deserializeJson(doc, forecast.data(), forecast.size()));
+  });
+  benchmark.run("measurements", measurements.size(), [&]() {
+    doNotOptimize(
+        deserializeJson(doc, measurements.data(), measurements.size()));
+  });
+
+#if ARDUINOJSON_ENABLE_STRUCTURAL_INDEX
+  // stage 1 alone
+  benchmark.run("forecast, index only", forecast.size(), [&]() {
+    detail::StructuralIndex index(detail::DefaultAllocator::instance());
+    doNotOptimize(index.build(forecast.data(), forecast.size()));
+  });
+#endif
+  return 0;
+}
@@ -0,0 +1,55 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Differential fuzzer: parses the input as a NUL-terminated string, which
+// scans one character at a time, and as a sized buffer, which scans with the
+// word-at-a-time or SIMD kernels, and in place; all must agree.
+// With ARDUINOJSON_ENABLE_STRUCTURAL_INDEX, the first two use the two-stage
+// parser, and the third one the regular parser.
+
+#include <ArduinoJson.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+using namespace ArduinoJson;
+
+static std::string serialize(const JsonDocument& doc) {
+  std::string output;
+  serializeJson(doc, output);
+  return output;
+}
+
+static void check(bool condition) {
+  if (!condition)
+    abort();
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  // the NUL-terminated parser would stop at the first '\0'
+  std::string input(reinterpret_cast<const char*>(data), size);
+  input.resize(strlen(input.c_str()));
+
+  JsonDocument scalar, kernels, inPlace;
+  DeserializationError scalarError = deserializeJson(scalar, input.c_str());
+  DeserializationError kernelsError =
+      deserializeJson(kernels, input.data(), input.size());
+  check(scalarError == kernelsError);
+  if (!scalarError)
+    check(serialize(scalar) == serialize(kernels));
+
+  // deserializeJsonInPlace() truncates the strings at "\u0000"
+  if (input.find("u0000") == std::string::npos) {
+    std::string buffer = input;
+    DeserializationError inPlaceError =
+        deserializeJsonInPlace(inPlace, &buffer[0], buffer.size());
+    check(inPlaceError == kernelsError);
+    if (!inPlaceError)
+      check(serialize(inPlace) == serialize(kernels));
+  }
+
+  return 0;
+}
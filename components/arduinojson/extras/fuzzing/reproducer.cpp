@@ -0,0 +1,88 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Runs a fuzzer without libFuzzer: on the files passed as arguments, or, if
+// there are none, on random mutations of the seed inputs.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+static void run(const std::string& input) {
+  LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()),
+                         input.size());
+}
+
+static std::string readFile(const char* path) {
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+// The strings are long enough to cross several blocks of the kernels
+static const char* seeds[] = {
+    "{\"LongPhrase\":\"Cloudy with a couple of showers, mainly later\"}",
+    "[\"http://www.accuweather.com/en/fr/paris/623/daily-weather-forecast\"]",
+    "{'single':'quoted \\' strings with \\\"escapes\\\" and \\u00e9'}",
+    "{\"a\":[1,2.5,-3e10,true,false,null,"
+    "{\"b\":\"\\\\\\\"\\/\\b\\f\\n\\r\\t\"}]}",
+    "[\"abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyzabcdefghijklmn\"]",
+    "{\"nested\":{\"strings\":[\"x\",\"yy\",\"zzz\",\"\",\"\\u0041\"]}}",
+};
+
+// The bytes that change the meaning of the input
+static const char specials[] = "\"'\\{}[]:,\0 \x80\xff/u0n";
+
+static std::string mutate(std::string input) {
+  int mutations = 1 + rand() % 4;
+  for (int i = 0; i < mutations; i++) {
+    size_t position = input.empty() ? 0 : size_t(rand()) % input.size();
+    char c = rand() % 2 ? specials[size_t(rand()) % (sizeof(specials) - 1)]
+                        : static_cast<char>(rand() % 256);
+    switch (rand() % 3) {
+      case 0:
+        input.insert(position, 1, c);
+        break;
+      case 1:
+        if (!input.empty())
+          input[position] = c;
+        break;
+      default:
+        if (!input.empty())
+          input.erase(position, 1);
+        break;
+    }
+  }
+  return input;
+}
+
+int main(int argc, const char* argv[]) {
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) {
+      printf("Loading %s\n", argv[i]);
+      run(readFile(argv[i]));
+    }
+    return 0;
+  }
+
+  srand(1);
+  const size_t seedCount = sizeof(seeds) / sizeof(seeds[0]);
+  for (int i = 0; i < 50000; i++) {
+    std::string input = seeds[size_t(i) % seedCount];
+    // grow the input, so that the special characters land at every offset
+    // of the blocks
+    size_t position = size_t(rand()) % input.size();
+    input.insert(position, std::string(size_t(rand()) % 40, 'x'));
+    run(mutate(input));
+  }
+  return 0;
+}
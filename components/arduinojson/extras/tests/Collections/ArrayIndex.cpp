@@ -0,0 +1,138 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+// Fails the allocations while failing is set
+class FailingAllocator : public Allocator {
+ public:
+  virtual ~FailingAllocator() {}
+
+  void* allocate(size_t size) override {
+    return failing ? nullptr : upstream_.allocate(size);
+  }
+
+  void deallocate(void* ptr) override {
+    upstream_.deallocate(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t size) override {
+    return failing ? nullptr : upstream_.reallocate(ptr, size);
+  }
+
+  size_t blocks() const {
+    return upstream_.stats().blocks;
+  }
+
+  bool failing = false;
+
+ private:
+  InstrumentedAllocator upstream_;
+};
+
+// Builds [0,1,2,...]
+std::string arrayJson(int n) {
+  std::string json = "[";
+  for (int i = 0; i < n; i++) {
+    if (i)
+      json += ",";
+    json += std::to_string(i);
+  }
+  return json + "]";
+}
+
+// Checks the elements from the last to the first, to use the index
+bool hasAllElements(JsonArrayConst array, int n) {
+  bool ok = array.size() == size_t(n);
+  for (int i = n - 1; i >= 0; i--)
+    ok = ok && array[size_t(i)] == i;
+  return ok && array[size_t(n)].isNull();
+}
+
+}  // namespace
+
+TEST_CASE("ArrayIndex: accessing a far element builds the index") {
+  FailingAllocator allocator;
+  JsonDocument doc(&allocator);
+  CHECK(deserializeJson(doc, arrayJson(100)) == DeserializationError::Ok);
+  size_t blocks = allocator.blocks();
+
+  const JsonDocument& constDoc = doc;
+  CHECK(constDoc[size_t(detail::ArrayIndex::minElements - 1)] ==
+        int(detail::ArrayIndex::minElements - 1));
+  CHECK(allocator.blocks() == blocks);
+
+  CHECK(hasAllElements(constDoc.as<JsonArrayConst>(), 100));
+  CHECK(allocator.blocks() == blocks + 1);
+}
+
+TEST_CASE("ArrayIndex: the added elements are indexed") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, arrayJson(20)) == DeserializationError::Ok);
+  CHECK(hasAllElements(doc.as<JsonArray>(), 20));
+
+  // past the capacity of the first table, so it grows
+  for (int i = 20; i < 300; i++)
+    doc.add(i);
+  CHECK(hasAllElements(doc.as<JsonArray>(), 300));
+
+  doc[350] = 350;  // fills the gap with nulls
+  CHECK(doc.size() == 351);
+  CHECK(doc[300].isNull());
+  CHECK(doc[349].isNull());
+  CHECK(doc[350] == 350);
+}
+
+TEST_CASE("ArrayIndex: the removals keep the positions right") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, arrayJson(100)) == DeserializationError::Ok);
+  CHECK(hasAllElements(doc.as<JsonArray>(), 100));
+
+  doc.remove(99);  // the last one
+  CHECK(hasAllElements(doc.as<JsonArray>(), 99));
+
+  doc.remove(0);  // shifts all the others
+  CHECK(doc.size() == 98);
+  for (size_t i = 0; i < 98; i++)
+    CHECK(doc[i] == i + 1);
+  CHECK(doc[98].isNull());
+
+  doc.remove(50);
+  CHECK(doc[49] == 50);
+  CHECK(doc[50] == 52);
+  CHECK(doc[96] == 98);
+}
+
+TEST_CASE("ArrayIndex: the accesses work without memory for the index") {
+  FailingAllocator allocator;
+  JsonDocument doc(&allocator);
+  CHECK(deserializeJson(doc, arrayJson(100)) == DeserializationError::Ok);
+  size_t blocks = allocator.blocks();
+
+  allocator.failing = true;
+  CHECK(hasAllElements(doc.as<JsonArray>(), 100));
+  CHECK(allocator.blocks() == blocks);
+}
+
+TEST_CASE("ArrayIndex: the copies and compact() keep the elements") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, arrayJson(100)) == DeserializationError::Ok);
+  CHECK(hasAllElements(doc.as<JsonArray>(), 100));
+
+  JsonDocument copy(doc);
+  CHECK(hasAllElements(copy.as<JsonArray>(), 100));
+
+  doc.remove(99);
+  CHECK(doc.compact());
+  doc.add(99);
+  CHECK(hasAllElements(doc.as<JsonArray>(), 100));
+}
@@ -0,0 +1,148 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+static_assert(ARDUINOJSON_CACHE_COLLECTION_SIZE,
+              "this test checks the cached size");
+
+namespace {
+
+// Counts the elements without the cached size
+size_t countElements(JsonArrayConst array) {
+  size_t n = 0;
+  for (auto it = array.begin(); it != array.end(); ++it)
+    n++;
+  return n;
+}
+
+size_t countMembers(JsonObjectConst object) {
+  size_t n = 0;
+  for (auto it = object.begin(); it != object.end(); ++it)
+    n++;
+  return n;
+}
+
+bool sizeIsRight(JsonArrayConst array) {
+  return array.size() == countElements(array);
+}
+
+bool sizeIsRight(JsonObjectConst object) {
+  return object.size() == countMembers(object);
+}
+
+// Has room for a few slots only, and no string
+class TinyAllocator : public Allocator {
+ public:
+  virtual ~TinyAllocator() {}
+
+  void* allocate(size_t size) override {
+    return size <= limit ? upstream_.allocate(size) : nullptr;
+  }
+
+  void deallocate(void* ptr) override {
+    upstream_.deallocate(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t size) override {
+    return size <= limit ? upstream_.reallocate(ptr, size) : nullptr;
+  }
+
+  size_t limit = 0;
+
+ private:
+  InstrumentedAllocator upstream_;
+};
+
+}  // namespace
+
+TEST_CASE("CollectionSize: arrays") {
+  JsonDocument doc;
+  JsonArray array = doc.to<JsonArray>();
+  CHECK(array.size() == 0);
+
+  for (int i = 0; i < 50; i++)
+    array.add(i);
+  CHECK(array.size() == 50);
+  CHECK(sizeIsRight(array));
+
+  array.remove(0);
+  array.remove(48);  // the last one
+  array.remove(20);
+  CHECK(array.size() == 47);
+  CHECK(sizeIsRight(array));
+
+  CHECK(array.removeIf([](JsonVariant v) { return v.as<int>() % 2 == 0; }) ==
+        24);
+  CHECK(array.size() == 23);
+  CHECK(sizeIsRight(array));
+
+  array[30] = 1;  // fills the gap with nulls
+  CHECK(array.size() == 31);
+  CHECK(sizeIsRight(array));
+
+  array.clear();
+  CHECK(array.size() == 0);
+  array.add(1);
+  CHECK(array.size() == 1);
+}
+
+TEST_CASE("CollectionSize: objects") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, "{\"a\":1,\"b\":2,\"c\":3,\"d\":4,\"a\":5}") ==
+        DeserializationError::Ok);
+  JsonObject object = doc.as<JsonObject>();
+  CHECK(sizeIsRight(object));
+
+  object["e"] = 6;
+  object["b"] = 7;  // replaces the value
+  CHECK(sizeIsRight(object));
+
+  object.remove("c");
+  object.remove("z");  // not there
+  CHECK(sizeIsRight(object));
+
+  object.removeIf([](JsonPair p) { return p.value().as<int>() > 5; });
+  CHECK(sizeIsRight(object));
+
+  object.clear();
+  CHECK(object.size() == 0);
+}
+
+TEST_CASE("CollectionSize: the copies and compact()") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, "{\"list\":[1,2,3,[4,5]],\"x\":{\"y\":1}}") ==
+        DeserializationError::Ok);
+  doc["list"].remove(1);
+
+  JsonDocument copy(doc);
+  CHECK(copy["list"].size() == 3);
+  CHECK(sizeIsRight(copy["list"].as<JsonArray>()));
+  CHECK(copy["list"][2].size() == 2);
+  CHECK(copy.size() == 2);
+
+  CHECK(doc.compact());
+  CHECK(doc["list"].size() == 3);
+  CHECK(sizeIsRight(doc["list"].as<JsonArray>()));
+  CHECK(doc["x"].size() == 1);
+}
+
+TEST_CASE("CollectionSize: a failed insertion doesn't count") {
+  TinyAllocator allocator;
+  JsonDocument doc(&allocator);
+  allocator.limit = 1024;  // room for a pool, but no second one
+  JsonArray array = doc.to<JsonArray>();
+  while (array.add(1)) {
+  }
+  CHECK(doc.overflowed());
+  CHECK(sizeIsRight(array));
+
+  JsonObject object = array.add<JsonObject>();
+  CHECK(object.isNull());
+  CHECK(sizeIsRight(array));
+}
@@ -0,0 +1,138 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+// Fails the allocations while failing is set
+class FailingAllocator : public Allocator {
+ public:
+  virtual ~FailingAllocator() {}
+
+  void* allocate(size_t size) override {
+    return failing ? nullptr : upstream_.allocate(size);
+  }
+
+  void deallocate(void* ptr) override {
+    upstream_.deallocate(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t size) override {
+    return failing ? nullptr : upstream_.reallocate(ptr, size);
+  }
+
+  size_t blocks() const {
+    return upstream_.stats().blocks;
+  }
+
+  bool failing = false;
+
+ private:
+  InstrumentedAllocator upstream_;
+};
+
+std::string key(int i) {
+  return "key" + std::to_string(i);
+}
+
+// Builds {"key0":0,"key1":1,...}
+std::string objectJson(int n) {
+  std::string json = "{";
+  for (int i = 0; i < n; i++) {
+    if (i)
+      json += ",";
+    json += "\"" + key(i) + "\":" + std::to_string(i);
+  }
+  return json + "}";
+}
+
+bool hasAllMembers(JsonObjectConst obj, int n) {
+  bool ok = obj.size() == size_t(n);
+  for (int i = 0; i < n; i++)
+    ok = ok && obj[key(i)] == i;
+  return ok;
+}
+
+}  // namespace
+
+TEST_CASE("ObjectIndex: the large objects get an index") {
+  // a member more costs a string, and the index when it reaches minMembers
+  const int n = int(detail::ObjectIndex::minMembers);
+  FailingAllocator small, large;
+  JsonDocument smallDoc(&small), largeDoc(&large);
+  CHECK(deserializeJson(smallDoc, objectJson(n)) == DeserializationError::Ok);
+  CHECK(deserializeJson(largeDoc, objectJson(n + 1)) ==
+        DeserializationError::Ok);
+  CHECK(large.blocks() == small.blocks() + 2);
+
+  const JsonDocument& constDoc = largeDoc;
+  CHECK(hasAllMembers(constDoc.as<JsonObjectConst>(), n + 1));
+  CHECK(constDoc["key100"].isNull());
+  CHECK(constDoc["key"].isNull());
+}
+
+TEST_CASE("ObjectIndex: the added members are indexed") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, objectJson(20)) == DeserializationError::Ok);
+  CHECK(hasAllMembers(doc.as<JsonObject>(), 20));
+
+  // past the capacity of the first table, so it's rebuilt
+  for (int i = 20; i < 300; i++)
+    doc[key(i)] = i;
+  CHECK(hasAllMembers(doc.as<JsonObject>(), 300));
+
+  doc["key7"] = 700;  // replaces the value, doesn't add a member
+  CHECK(doc.size() == 300);
+  CHECK(doc["key7"] == 700);
+}
+
+TEST_CASE("ObjectIndex: the removed members aren't found") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, objectJson(100)) == DeserializationError::Ok);
+  CHECK(hasAllMembers(doc.as<JsonObject>(), 100));
+
+  for (int i = 0; i < 100; i += 2)
+    doc.remove(key(i));
+  CHECK(doc.size() == 50);
+  for (int i = 0; i < 100; i++)
+    CHECK(doc[key(i)].isNull() == (i % 2 == 0));
+
+  for (int i = 0; i < 100; i += 2)
+    doc[key(i)] = i;
+  CHECK(hasAllMembers(doc.as<JsonObject>(), 100));
+}
+
+TEST_CASE("ObjectIndex: the lookups work without memory for the index") {
+  FailingAllocator allocator;
+  JsonDocument doc(&allocator);
+  CHECK(deserializeJson(doc, objectJson(100)) == DeserializationError::Ok);
+  size_t blocks = allocator.blocks();
+
+  allocator.failing = true;
+  CHECK(hasAllMembers(doc.as<JsonObject>(), 100));
+  CHECK(allocator.blocks() == blocks);
+  CHECK(doc["key100"].isNull());
+}
+
+TEST_CASE("ObjectIndex: the copies and compact() keep the members") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, objectJson(100)) == DeserializationError::Ok);
+  CHECK(hasAllMembers(doc.as<JsonObject>(), 100));
+
+  JsonDocument copy(doc);
+  CHECK(hasAllMembers(copy.as<JsonObject>(), 100));
+
+  doc.remove("key50");
+  CHECK(doc.compact());
+  CHECK(doc["key50"].isNull());
+  doc["key50"] = 50;
+  CHECK(hasAllMembers(doc.as<JsonObject>(), 100));
+}
@@ -0,0 +1,187 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+static_assert(ARDUINOJSON_ENABLE_PACKED_ARRAYS,
+              "this test checks the packed arrays");
+
+namespace {
+
+const size_t slotSize = sizeof(detail::VariantSlot);
+
+// Builds [0,1,2,...]
+std::string arrayJson(int n) {
+  std::string json = "[";
+  for (int i = 0; i < n; i++) {
+    if (i)
+      json += ",";
+    json += std::to_string(i);
+  }
+  return json + "]";
+}
+
+bool isPacked(JsonVariantConst variant) {
+  auto data = detail::VariantAttorney::getData(variant);
+  return data && data->isPackedArray();
+}
+
+// Checks the elements with operator[], then with an iterator
+bool hasAllElements(JsonArrayConst array, int n) {
+  bool ok = array.size() == size_t(n);
+  for (int i = 0; i < n; i++)
+    ok = ok && array[size_t(i)] == i;
+  int i = 0;
+  for (JsonVariantConst element : array)
+    ok = ok && element == i++;
+  return ok && i == n && array[size_t(n)].isNull();
+}
+
+// The size of the pools of the document
+size_t poolBytes(const JsonDocument& doc) {
+  return doc.allocationProfile().pools.peakBytes;
+}
+
+}  // namespace
+
+TEST_CASE("PackedArrays: the reads don't unpack") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, "{\"a\":" + arrayJson(20) + "}") ==
+        DeserializationError::Ok);
+  CHECK(isPacked(doc["a"]));
+
+  const JsonDocument& constDoc = doc;
+  CHECK(constDoc["a"][3] == 3);
+  CHECK(constDoc["a"][20].isNull());
+  CHECK(hasAllElements(constDoc["a"].as<JsonArrayConst>(), 20));
+  CHECK(isPacked(doc["a"]));
+
+  // through the proxies of a non-const document
+  CHECK(doc["a"][3] == 3);
+  CHECK(doc["a"][4].as<int>() == 4);
+  CHECK(doc["a"][5].is<int>());
+  CHECK(!doc["a"][6].isNull());
+  CHECK(doc["a"][20].isNull());
+  CHECK(doc["a"][3]["x"].isNull());
+  int value = doc["a"][7];
+  CHECK(value == 7);
+  CHECK(doc["a"].size() == 20);
+  CHECK(doc["a"].is<JsonArrayConst>());
+  CHECK(isPacked(doc["a"]));
+
+  // the serialization and the comparisons
+  JsonDocument copy(doc);
+  CHECK(doc["a"] == copy["a"]);
+  CHECK(doc["a"] == copy["a"].as<JsonArrayConst>());
+  copy["a"][0] = 1;
+  CHECK(doc["a"] != copy["a"]);
+  std::string json;
+  serializeJson(doc, json);
+  CHECK(json == "{\"a\":" + arrayJson(20) + "}");
+  CHECK(isPacked(doc["a"]));
+}
+
+TEST_CASE("PackedArrays: the root array") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, arrayJson(20)) == DeserializationError::Ok);
+
+  const JsonDocument& constDoc = doc;
+  CHECK(constDoc[19] == 19);
+  CHECK(doc[18] == 18);
+  CHECK(hasAllElements(doc.as<JsonArrayConst>(), 20));
+  CHECK(isPacked(doc.as<JsonVariantConst>()));
+}
+
+TEST_CASE("PackedArrays: a JsonVariantConst keeps its element") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, "{\"a\":" + arrayJson(20) + "}") ==
+        DeserializationError::Ok);
+
+  JsonVariantConst three = doc["a"][3];  // the proxy is gone
+  JsonVariantConst copy = three;
+  JsonVariantConst other;
+  other = doc["a"][4];
+  CHECK(three == 3);
+  CHECK(copy == 3);
+  CHECK(other == 4);
+  other = copy;
+  CHECK(other == 3);
+
+  JsonArrayConst array = doc["a"];
+  auto it = array.begin();
+  ++it;
+  CHECK(it->as<int>() == 1);
+  CHECK(isPacked(doc["a"]));
+}
+
+TEST_CASE("PackedArrays: the modifications unpack") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, "{\"a\":" + arrayJson(20) + "}") ==
+        DeserializationError::Ok);
+
+  doc["a"][3] = 42;
+  CHECK(!isPacked(doc["a"]));
+  CHECK(doc["a"][3] == 42);
+  CHECK(doc["a"][4] == 4);
+  CHECK(doc["a"].size() == 20);
+
+  CHECK(deserializeJson(doc, "{\"a\":" + arrayJson(20) + "}") ==
+        DeserializationError::Ok);
+  JsonVariant element = doc["a"][5];
+  CHECK(!isPacked(doc["a"]));
+  element.set(50);
+  CHECK(doc["a"][5] == 50);
+
+  CHECK(deserializeJson(doc, arrayJson(20)) == DeserializationError::Ok);
+  doc.remove(0);
+  CHECK(!isPacked(doc.as<JsonVariantConst>()));
+  CHECK(doc[0] == 1);
+  CHECK(doc.size() == 19);
+}
+
+TEST_CASE("PackedArrays: ExactSize reserves the slots in use at once") {
+  const size_t packedSlots = detail::PackedArray::minElements;
+
+  // the slots of the first elements are freed when the array is packed
+  JsonDocument doc1;
+  CHECK(deserializeJson(doc1, arrayJson(200),
+                        DeserializationOption::ExactSize()) ==
+        DeserializationError::Ok);
+  CHECK(isPacked(doc1.as<JsonVariantConst>()));
+  CHECK(poolBytes(doc1) == (packedSlots + 1) * slotSize);
+
+  // the second array reuses them
+  JsonDocument doc2;
+  CHECK(deserializeJson(
+            doc2, "[" + arrayJson(100) + "," + arrayJson(100) + "]",
+            DeserializationOption::ExactSize()) == DeserializationError::Ok);
+  CHECK(isPacked(doc2[1]));
+  CHECK(poolBytes(doc2) == (packedSlots + 3) * slotSize);
+
+  // an element that can't be packed moves them all back to the slots
+  std::string json = arrayJson(100);
+  json.back() = ',';
+  JsonDocument doc3;
+  CHECK(deserializeJson(doc3, json + "\"x\"]",
+                        DeserializationOption::ExactSize()) ==
+        DeserializationError::Ok);
+  CHECK(!isPacked(doc3.as<JsonVariantConst>()));
+  CHECK(doc3.size() == 101);
+  CHECK(poolBytes(doc3) == 102 * slotSize);
+
+  // and so does a number of another kind
+  JsonDocument doc4;
+  CHECK(deserializeJson(doc4, json + "1.5]",
+                        DeserializationOption::ExactSize()) ==
+        DeserializationError::Ok);
+  CHECK(!isPacked(doc4.as<JsonVariantConst>()));
+  CHECK(doc4[100] == 1.5);
+  CHECK(poolBytes(doc4) == 102 * slotSize);
+}
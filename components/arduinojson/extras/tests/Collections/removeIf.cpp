@@ -0,0 +1,199 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+#include <vector>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+static_assert(ARDUINOJSON_ENABLE_ARRAY_INDEX &&
+                  ARDUINOJSON_ENABLE_OBJECT_INDEX &&
+                  ARDUINOJSON_CACHE_COLLECTION_SIZE,
+              "this test checks the indexes and the cached size");
+
+namespace {
+
+// Enough elements for the indexes
+const int count = 100;
+
+std::string key(int i) {
+  return "key" + std::to_string(i);
+}
+
+// The predicates, applied to the values 0 to count-1
+bool none(int) {
+  return false;
+}
+
+bool all(int) {
+  return true;
+}
+
+bool even(int i) {
+  return i % 2 == 0;
+}
+
+bool first(int i) {
+  return i == 0;
+}
+
+bool last(int i) {
+  return i == count - 1;
+}
+
+bool tail(int i) {
+  return i >= count / 2;
+}
+
+bool middle(int i) {
+  return i >= 10 && i < 90;
+}
+
+typedef bool (*Predicate)(int);
+const Predicate predicates[] = {none, all, even, first, last, tail, middle};
+
+// Fills the array, then reads the last element, which builds the index
+JsonArray makeArray(JsonDocument& doc) {
+  JsonArray array = doc.to<JsonArray>();
+  for (int i = 0; i < count; i++)
+    array.add(i);
+  CHECK(array[count - 1] == count - 1);
+  return array;
+}
+
+// Fills the object, which builds the index
+JsonObject makeObject(JsonDocument& doc) {
+  JsonObject object = doc.to<JsonObject>();
+  for (int i = 0; i < count; i++)
+    object[key(i)] = i;
+  CHECK(object[key(count - 1)] == count - 1);
+  return object;
+}
+
+std::vector<int> survivors(Predicate predicate) {
+  std::vector<int> values;
+  for (int i = 0; i < count; i++) {
+    if (!predicate(i))
+      values.push_back(i);
+  }
+  return values;
+}
+
+// Checks the size, the iteration, and the access by position
+bool hasElements(JsonArrayConst array, const std::vector<int>& values) {
+  bool ok = array.size() == values.size();
+  size_t n = 0;
+  for (JsonVariantConst element : array)
+    ok = ok && n < values.size() && element == values[n++];
+  ok = ok && n == values.size();
+  // from the last to the first, to use the index
+  for (size_t i = values.size(); i > 0; i--)
+    ok = ok && array[i - 1] == values[i - 1];
+  return ok && array[values.size()].isNull();
+}
+
+// Checks the size, the iteration, and the access by key
+bool hasMembers(JsonObjectConst object, const std::vector<int>& values) {
+  bool ok = object.size() == values.size();
+  size_t n = 0;
+  for (JsonPairConst member : object) {
+    ok = ok && n < values.size() && member.key().c_str() == key(values[n]) &&
+         member.value() == values[n];
+    n++;
+  }
+  ok = ok && n == values.size();
+  std::vector<bool> kept(count, false);
+  for (int value : values)
+    kept[size_t(value)] = true;
+  for (int i = 0; i < count; i++) {
+    if (kept[size_t(i)])
+      ok = ok && object[key(i)] == i;
+    else
+      ok = ok && !object.containsKey(key(i));
+  }
+  return ok;
+}
+
+}  // namespace
+
+TEST_CASE("removeIf() on arrays") {
+  for (Predicate predicate : predicates) {
+    JsonDocument doc;
+    JsonArray array = makeArray(doc);
+    std::vector<int> values = survivors(predicate);
+
+    size_t removed =
+        array.removeIf([predicate](JsonVariant v) { return predicate(v); });
+    CHECK(removed == count - values.size());
+    CHECK(hasElements(array, values));
+
+    // the new elements go at the end
+    array.add(count);
+    values.push_back(count);
+    CHECK(hasElements(array, values));
+    array.remove(0);
+    values.erase(values.begin());
+    CHECK(hasElements(array, values));
+  }
+}
+
+TEST_CASE("removeIf() on objects") {
+  for (Predicate predicate : predicates) {
+    InstrumentedAllocator allocator;
+    JsonDocument doc(&allocator);
+    JsonObject object = makeObject(doc);
+    std::vector<int> values = survivors(predicate);
+
+    size_t removed = object.removeIf(
+        [predicate](JsonPair p) { return predicate(p.value()); });
+    CHECK(removed == count - values.size());
+
+    // the lookups find the index, instead of building another one
+    size_t blocks = allocator.stats().blocks;
+    CHECK(hasMembers(object, values));
+    CHECK(allocator.stats().blocks == blocks);
+
+    // the new members go at the end, and are found by key
+    object[key(count)] = count;
+    values.push_back(count);
+    CHECK(object[key(count)] == count);
+    object[key(1)] = 1;  // back, or already there
+    if (predicate(1))
+      values.push_back(1);
+    object.remove(key(values[0]));
+    values.erase(values.begin());
+    CHECK(hasMembers(object, values));
+  }
+}
+
+TEST_CASE("removeIf() frees the removed values") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  JsonArray array = doc.to<JsonArray>();
+  for (int i = 0; i < count; i++)
+    array.add<JsonObject>()["name"] = "a string that needs memory " + key(i);
+  size_t bytes = allocator.stats().bytes;
+
+  CHECK(array.removeIf([](JsonVariant v) { return v["name"] != ""; }) ==
+        size_t(count));
+  CHECK(array.size() == 0);
+  CHECK(allocator.stats().bytes < bytes);
+
+  // the slots are reused
+  size_t blocks = allocator.stats().blocks;
+  for (int i = 0; i < count; i++)
+    array.add(i);
+  CHECK(allocator.stats().blocks == blocks);
+}
+
+TEST_CASE("removeIf() on a null collection") {
+  JsonArray array;
+  CHECK(array.removeIf([](JsonVariant) { return true; }) == 0);
+  JsonObject object;
+  CHECK(object.removeIf([](JsonPair) { return true; }) == 0);
+}
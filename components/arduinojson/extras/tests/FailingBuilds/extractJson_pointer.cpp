@@ -0,0 +1,11 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+// The string would be destroyed at the end of the parsing
+int main() {
+  const char* value = nullptr;
+  extractJson("[\"hello\"]", ArduinoJson::jsonPath(0), value);
+}
@@ -0,0 +1,12 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+// A negative index is rejected in a constant expression
+int main() {
+  constexpr auto path = ArduinoJson::jsonPath("values", -1);
+  int value = 0;
+  extractJson("{\"values\":[1]}", path, value);
+}
@@ -0,0 +1,59 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <stdio.h>
+
+// A minimal test runner: each TEST_CASE registers itself, and the main() of
+// TestMain.cpp runs them all. A failed CHECK() is reported, and the test goes
+// on.
+namespace test {
+struct TestCase {
+  const char* name;
+  void (*run)();
+  TestCase* next;
+};
+
+inline TestCase*& testCases() {
+  static TestCase* first = nullptr;
+  return first;
+}
+
+inline int& failureCount() {
+  static int count = 0;
+  return count;
+}
+
+struct TestCaseRegistrar {
+  TestCaseRegistrar(TestCase& testCase) {
+    testCase.next = testCases();
+    testCases() = &testCase;
+  }
+};
+
+inline void fail(const char* file, int line, const char* expression) {
+  printf("%s:%d: CHECK(%s) failed\n", file, line, expression);
+  failureCount()++;
+}
+}  // namespace test
+
+#define TEST_CONCAT_(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_(a, b)
+
+#define TEST_CASE_(function, name)                                      \
+  static void function();                                               \
+  static test::TestCase TEST_CONCAT(function, Case) = {name, function,  \
+                                                       nullptr};        \
+  static test::TestCaseRegistrar TEST_CONCAT(function, Registrar)(      \
+      TEST_CONCAT(function, Case));                                     \
+  static void function()
+
+#define TEST_CASE(name) TEST_CASE_(TEST_CONCAT(testCase, __LINE__), name)
+
+#define CHECK(expression)                              \
+  do {                                                 \
+    if (!(expression))                                 \
+      test::fail(__FILE__, __LINE__, #expression);     \
+  } while (0)
@@ -0,0 +1,18 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include "Test.hpp"
+
+int main() {
+  int count = 0;
+  for (auto testCase = test::testCases(); testCase; testCase = testCase->next) {
+    int failures = test::failureCount();
+    testCase->run();
+    if (test::failureCount() != failures)
+      printf("in \"%s\"\n", testCase->name);
+    count++;
+  }
+  printf("%d test cases, %d failed checks\n", count, test::failureCount());
+  return test::failureCount() == 0 ? 0 : 1;
+}
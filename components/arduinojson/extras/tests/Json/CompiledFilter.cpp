@@ -0,0 +1,191 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Applies each filter to each input, once as a Filter and once as a
+// CompiledFilter, and checks that the documents and the errors are the same.
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+const char* filters[] = {
+    "true",
+    "false",
+    "null",
+    "{}",
+    "[]",
+    "{\"a\":true}",
+    "{\"a\":false,\"b\":true}",
+    "{\"a\":{\"x\":true}}",
+    "{\"a\":{\"x\":{\"deep\":true}},\"c\":true}",
+    "{\"*\":{\"x\":true}}",
+    "{\"*\":true,\"a\":false}",
+    "{\"a\":null,\"*\":{\"y\":true}}",
+    "{\"a\":true,\"a\":false}",
+    "{\"missing\":true,\"other\":{\"x\":true}}",
+    "{\"a\":[true]}",
+    "{\"a\":[{\"x\":true}]}",
+    "[{\"x\":true}]",
+    "[{\"*\":{\"y\":true}}]",
+    "{\"*\":[{\"x\":true,\"y\":false}]}",
+    "{\"a\":[[{\"x\":true}]]}",
+    "{\"ab\":true,\"a\":true,\"abc\":true,\"b\":true,\"\":true}",
+    "{\"z\":1,\"y\":1,\"x\":1,\"d\":1,\"c\":1,\"b\":1,\"a\":1}",
+};
+
+const char* inputs[] = {
+    "{\"a\":1,\"b\":2,\"c\":3}",
+    "{\"a\":{\"x\":1,\"y\":2},\"b\":{\"x\":3,\"y\":4},\"c\":{\"z\":5}}",
+    "{\"a\":{\"x\":{\"deep\":1,\"other\":2},\"y\":[1,2]},\"c\":[{\"x\":1}]}",
+    "{\"a\":[{\"x\":1,\"y\":2},{\"y\":3},{\"x\":[4,5]},7,null]}",
+    "{\"a\":[[{\"x\":1,\"y\":2}],[{\"x\":3}],[]],\"b\":[[{\"x\":4}]]}",
+    "[{\"x\":1,\"y\":2},{\"y\":{\"y\":3}},{\"z\":{\"y\":4}},[1],\"s\"]",
+    "{\"ab\":1,\"abc\":2,\"abcd\":3,\"\":4,\"b\":5,\"a\":6,\"ba\":7}",
+    "{\"z\":1,\"c\":2,\"x\":3,\"q\":4,\"a\":5}",
+    "{\"unknown\":{\"x\":1},\"other\":{\"x\":2,\"y\":3}}",
+    "{\"a\":1,\"a\":{\"x\":2}}",
+    "{}",
+    "[]",
+    "42",
+    "\"string\"",
+    "null",
+    // errors, inside and outside the filtered parts
+    "{\"a\":{\"x\":1,}}",
+    "{\"b\":[1,2}",
+    "{\"a\":[{\"x\":1},{\"x\":2]}",
+    "{\"a\":1",
+    "",
+};
+
+std::string describe(DeserializationError err, const JsonDocument& doc) {
+  std::string result = err.c_str();
+  result += ' ';
+  serializeJson(doc, result);
+  return result;
+}
+
+bool check(const char* filterJson, const char* input,
+           DeserializationOption::NestingLimit limit =
+               DeserializationOption::NestingLimit()) {
+  JsonDocument filter;
+  deserializeJson(filter, filterJson);
+
+  JsonDocument expectedDoc;
+  std::string expected = describe(
+      deserializeJson(expectedDoc, input, DeserializationOption::Filter(filter),
+                      limit),
+      expectedDoc);
+
+  DeserializationOption::CompiledFilter compiled(filter);
+  filter.clear();  // the CompiledFilter doesn't need the filter document
+  JsonDocument actualDoc;
+  std::string actual = describe(
+      deserializeJson(actualDoc, input, compiled, limit), actualDoc);
+
+  if (actual == expected)
+    return true;
+  printf("filter: %s\ninput: %s\nexpected: %s\nactual: %s\n", filterJson,
+         input, expected.c_str(), actual.c_str());
+  return false;
+}
+
+// Fails the allocations above the specified size
+class SmallAllocator : public Allocator {
+ public:
+  virtual ~SmallAllocator() {}
+
+  void* allocate(size_t size) override {
+    return size > maxSize ? nullptr : malloc(size);
+  }
+
+  void deallocate(void* ptr) override {
+    free(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t size) override {
+    return size > maxSize ? nullptr : realloc(ptr, size);
+  }
+
+  size_t maxSize = 0;
+};
+
+}  // namespace
+
+TEST_CASE("CompiledFilter: same result as Filter") {
+  for (const char* filter : filters) {
+    for (const char* input : inputs)
+      CHECK(check(filter, input));
+  }
+}
+
+TEST_CASE("CompiledFilter: same nesting limit as Filter") {
+  for (uint8_t limit = 0; limit < 5; limit++) {
+    for (const char* filter : filters) {
+      for (const char* input : inputs)
+        CHECK(check(filter, input, DeserializationOption::NestingLimit(limit)));
+    }
+  }
+}
+
+TEST_CASE("CompiledFilter: with the nesting limit first") {
+  JsonDocument filter;
+  filter["a"][0]["x"] = true;
+  DeserializationOption::CompiledFilter compiled(filter);
+
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, "{\"a\":[{\"x\":1,\"y\":2}],\"b\":3}",
+                        DeserializationOption::NestingLimit(3),
+                        compiled) == DeserializationError::Ok);
+  std::string json;
+  serializeJson(doc, json);
+  CHECK(json == "{\"a\":[{\"x\":1}]}");
+
+  CHECK(deserializeJson(doc, "{\"a\":[{\"x\":1,\"y\":2}],\"b\":3}",
+                        DeserializationOption::NestingLimit(2),
+                        compiled) == DeserializationError::TooDeep);
+}
+
+TEST_CASE("CompiledFilter: applied many times") {
+  JsonDocument filter;
+  filter["list"][0]["id"] = true;
+  DeserializationOption::CompiledFilter compiled(filter);
+
+  for (int i = 0; i < 3; i++) {
+    JsonDocument doc;
+    std::string input = "{\"list\":[{\"id\":" + std::to_string(i) +
+                        ",\"name\":\"x\"}],\"total\":1}";
+    CHECK(deserializeJson(doc, input, compiled) == DeserializationError::Ok);
+    std::string json;
+    serializeJson(doc, json);
+    CHECK(json == "{\"list\":[{\"id\":" + std::to_string(i) + "}]}");
+  }
+}
+
+TEST_CASE("CompiledFilter: the allocation fails") {
+  JsonDocument filter;
+  filter["a"] = true;
+
+  SmallAllocator allocator;
+  DeserializationOption::CompiledFilter compiled(filter, &allocator);
+  CHECK(compiled.overflowed());
+
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, "{\"a\":1,\"b\":2}", compiled) ==
+        DeserializationError::Ok);
+  CHECK(doc.isNull());
+
+  // "true" and "false" don't allocate
+  filter.set(true);
+  DeserializationOption::CompiledFilter allowAll(filter, &allocator);
+  CHECK(!allowAll.overflowed());
+  CHECK(deserializeJson(doc, "{\"a\":1}", allowAll) ==
+        DeserializationError::Ok);
+  CHECK(doc["a"] == 1);
+}
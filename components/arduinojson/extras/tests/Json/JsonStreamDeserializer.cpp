@@ -0,0 +1,166 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Splits each input at every position, feeds the pieces to a
+// JsonStreamDeserializer, and compares the document and the error with the
+// ones of deserializeJson().
+
+#include <ArduinoJson.h>
+
+#include <string>
+#include <vector>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+const char* documents[] = {
+    "{\"a\":1,\"b\":[true,false,null],\"c\":{\"d\":-2.5e3}}",
+    "  [ { \"id\" : 1 , \"name\" : \"first\" } ,\n"
+    "\t{ \"id\":2,\"name\":\"\" } ] ",
+    "[\"escapes: \\\" \\\\ \\/ \\b \\f \\n \\r \\t\",'single \\' quote']",
+    "[\"\\u00e9\\u4e2d\\ud83d\\ude00\",\"\\u0041BC\"]",
+    "{unquoted_key:1,other:[2]}",
+    "[18446744073709551615,-9223372036854775808,1e400,0.1,-0,123456789]",
+    "{\"a\":1,\"a\":2,\"a\":null}",
+    "[[[[[[]]]]]]",
+    "{}",
+    "[]",
+    "\"root string\"",
+    "42",
+    "true",
+    "null",
+    "[1] trailing",
+    "{\"a\":1}x",
+    // invalid
+    "[1,2,]",
+    "{\"a\" 1}",
+    "[1 2]",
+    "[tru]",
+    "[nulll]",
+    "[1.2.3]",
+    "[\"\\q\"]",
+    "[\"\\u00zz\"]",
+    "{\"a\":1,}",
+    "[}",
+    "42x",
+    "",
+    "   ",
+};
+
+std::string describe(DeserializationError err, const JsonDocument& doc) {
+  std::string result = err.c_str();
+  result += ' ';
+  serializeJson(doc, result);
+  return result;
+}
+
+std::string expectedResult(const std::string& input,
+                           DeserializationOption::NestingLimit limit) {
+  JsonDocument doc;
+  DeserializationError err =
+      deserializeJson(doc, input.data(), input.size(), limit);
+  return describe(err, doc);
+}
+
+// Feeds the input split at the specified positions
+std::string streamedResult(const std::string& input,
+                           const std::vector<size_t>& splits,
+                           DeserializationOption::NestingLimit limit) {
+  JsonDocument doc;
+  JsonStreamDeserializer parser(doc, limit);
+  size_t start = 0;
+  for (size_t split : splits) {
+    parser.feed(input.data() + start, split - start);
+    start = split;
+  }
+  parser.feed(input.data() + start, input.size() - start);
+  return describe(parser.finish(), doc);
+}
+
+bool check(const std::string& input, const std::vector<size_t>& splits,
+           DeserializationOption::NestingLimit limit =
+               DeserializationOption::NestingLimit()) {
+  std::string expected = expectedResult(input, limit);
+  std::string actual = streamedResult(input, splits, limit);
+  if (actual == expected)
+    return true;
+  printf("input: %s\nsplits:", input.c_str());
+  for (size_t split : splits)
+    printf(" %zu", split);
+  printf("\nexpected: %s\nactual: %s\n", expected.c_str(), actual.c_str());
+  return false;
+}
+
+}  // namespace
+
+TEST_CASE("JsonStreamDeserializer: in one piece") {
+  for (const char* document : documents)
+    CHECK(check(document, {}));
+}
+
+TEST_CASE("JsonStreamDeserializer: split in two at every position") {
+  for (const char* document : documents) {
+    std::string input(document);
+    for (size_t i = 0; i <= input.size(); i++)
+      CHECK(check(input, {i}));
+  }
+}
+
+TEST_CASE("JsonStreamDeserializer: split in three at every position") {
+  for (const char* document : documents) {
+    std::string input(document);
+    for (size_t i = 0; i <= input.size(); i++) {
+      for (size_t j = i; j <= input.size(); j++)
+        CHECK(check(input, {i, j}));
+    }
+  }
+}
+
+TEST_CASE("JsonStreamDeserializer: one character at a time") {
+  for (const char* document : documents) {
+    std::string input(document);
+    std::vector<size_t> splits;
+    for (size_t i = 1; i < input.size(); i++)
+      splits.push_back(i);
+    CHECK(check(input, splits));
+  }
+}
+
+TEST_CASE("JsonStreamDeserializer: the truncated documents") {
+  for (const char* document : documents) {
+    std::string input(document);
+    for (size_t n = 0; n < input.size(); n++) {
+      for (size_t i = 0; i <= n; i++)
+        CHECK(check(input.substr(0, n), {i}));
+    }
+  }
+}
+
+TEST_CASE("JsonStreamDeserializer: the nesting limit") {
+  for (uint8_t limit = 0; limit < 8; limit++) {
+    std::string input = "{\"a\":[[{\"b\":[1]}],[]]}";
+    for (size_t i = 0; i <= input.size(); i++)
+      CHECK(check(input, {i}, DeserializationOption::NestingLimit(limit)));
+  }
+}
+
+TEST_CASE("JsonStreamDeserializer: the long strings") {
+  std::string input = "[\"" + std::string(200, 'x') + "\\n" +
+                      std::string(100, 'y') + "\",{\"" +
+                      std::string(150, 'k') + "\":1}]";
+  for (size_t i = 0; i <= input.size(); i++)
+    CHECK(check(input, {i}));
+}
+
+TEST_CASE("JsonStreamDeserializer: the chunks after an error are ignored") {
+  JsonDocument doc;
+  JsonStreamDeserializer parser(doc);
+  CHECK(parser.feed("[1,", 3) == DeserializationError::Ok);
+  CHECK(parser.feed("x", 1) == DeserializationError::InvalidInput);
+  CHECK(parser.feed("2]", 2) == DeserializationError::InvalidInput);
+  CHECK(parser.finish() == DeserializationError::InvalidInput);
+}
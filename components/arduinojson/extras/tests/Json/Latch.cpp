@@ -0,0 +1,150 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Checks peek() and advance() on the contiguous readers, and the Latch that
+// reads them.
+
+#include <ArduinoJson.h>
+
+#include <string>
+#include <vector>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+using namespace ArduinoJson::detail;
+
+static_assert(is_contiguous_reader<Reader<const char*>>::value, "char*");
+static_assert(is_contiguous_reader<Reader<std::string>>::value, "string");
+static_assert(is_contiguous_reader<Reader<std::vector<char>>>::value,
+              "vector<char>");
+static_assert(is_contiguous_reader<BoundedReader<const char*>>::value,
+              "sized buffer");
+static_assert(!is_contiguous_reader<Reader<std::vector<unsigned char>>>::value,
+              "only the containers of char are read as a span");
+
+namespace {
+
+// Walks the input with clear(), and returns the characters seen by current()
+template <typename TReader>
+std::string readAll(TReader reader) {
+  Latch<TReader> latch(reader);
+  std::string result;
+  while (latch.current()) {
+    result += latch.current();
+    latch.clear();
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST_CASE("Reader<const char*>: peek() stops at the terminator") {
+  const char* input = "hello";
+  auto reader = makeReader(input);
+  const char* end;
+  CHECK(reader.peek(end) == input);
+  CHECK(end == nullptr);
+
+  reader.advance(2);
+  CHECK(reader.peek(end) == input + 2);
+  CHECK(reader.read() == 'l');
+  CHECK(reader.peek(end) == input + 3);
+}
+
+TEST_CASE("Reader<std::string>: peek() returns the whole string") {
+  std::string input("he\0llo", 6);
+  auto reader = makeReader(input);
+  const char* end;
+  const char* ptr = reader.peek(end);
+  CHECK(ptr == input.data());
+  CHECK(end == input.data() + 6);
+
+  reader.advance(3);
+  CHECK(reader.peek(end) == input.data() + 3);
+  CHECK(reader.read() == 'l');
+  reader.advance(2);
+  CHECK(reader.peek(end) == end);
+  CHECK(reader.read() == -1);
+}
+
+TEST_CASE("BoundedReader<const char*>: peek() stops at the size") {
+  const char* input = "hello";
+  auto reader = makeReader(input, 3);
+  const char* end;
+  CHECK(reader.peek(end) == input);
+  CHECK(end == input + 3);
+
+  char buffer[8];
+  CHECK(reader.readBytes(buffer, sizeof(buffer)) == 3);
+  CHECK(reader.peek(end) == input + 3);
+  CHECK(reader.read() == -1);
+}
+
+TEST_CASE("Latch: reads the contiguous inputs like the others") {
+  const char* input = "hello";
+  CHECK(readAll(makeReader(input)) == "hello");
+  CHECK(readAll(makeReader(input, 3)) == "hel");
+  CHECK(readAll(makeReader(std::string("hello"))) == "hello");
+  std::vector<char> vector(input, input + 4);
+  CHECK(readAll(makeReader(vector)) == "hell");
+}
+
+TEST_CASE("Latch: clear() doesn't move past the terminator") {
+  const char* input = "a\0b";
+  auto reader = makeReader(input);
+  Latch<decltype(reader)> latch(reader);
+  const char* end;
+
+  CHECK(latch.current() == 'a');
+  latch.clear();
+  CHECK(latch.current() == 0);
+  latch.clear();  // already at the end
+  CHECK(latch.peek(end) == input + 1);
+  CHECK(latch.last() == 0);
+}
+
+TEST_CASE("Latch: clear() doesn't move past the size") {
+  const char* input = "ab";
+  auto reader = makeReader(input, 1);
+  Latch<decltype(reader)> latch(reader);
+  const char* end;
+
+  latch.clear();
+  latch.clear();  // already at the end
+  CHECK(latch.peek(end) == input + 1);
+  CHECK(end == input + 1);
+  CHECK(latch.last() == 0);
+}
+
+TEST_CASE("deserializeJson(): the same result from every contiguous input") {
+  const char json[] = "{\"a\":[1,2.5,\"x\\ny\"],\"b\":true} 12";
+  std::string expected;
+  {
+    JsonDocument doc;
+    CHECK(deserializeJson(doc, json) == DeserializationError::Ok);
+    serializeJson(doc, expected);
+  }
+
+  std::string string(json);
+  std::vector<char> vector(json, json + sizeof(json) - 1);
+  JsonDocument doc1, doc2, doc3;
+  CHECK(deserializeJson(doc1, string) == DeserializationError::Ok);
+  CHECK(deserializeJson(doc2, vector) == DeserializationError::Ok);
+  CHECK(deserializeJson(doc3, json, sizeof(json) - 1) ==
+        DeserializationError::Ok);
+  CHECK(doc1.as<std::string>() == expected);
+  CHECK(doc2.as<std::string>() == expected);
+  CHECK(doc3.as<std::string>() == expected);
+
+  // a number at the very end of the input
+  for (size_t n = 1; n <= 4; n++) {
+    JsonDocument doc;
+    CHECK(deserializeJson(doc, "12.5", n) == DeserializationError::Ok);
+    CHECK(deserializeJson(doc, std::string("12.5", n)) ==
+          DeserializationError::Ok);
+  }
+  CHECK(deserializeJson(doc1, "12.5") == DeserializationError::Ok);
+  CHECK(doc1 == 12.5);
+}
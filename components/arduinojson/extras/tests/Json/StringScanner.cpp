@@ -0,0 +1,154 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Checks the word-at-a-time and SIMD kernels of StringScanner.hpp against the
+// scalar path, on all the lengths and positions around the block boundaries.
+
+#include <ArduinoJson.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson::detail;
+
+namespace {
+
+// Longer than four 16-byte blocks, so that every kernel loops
+const size_t maxLength = 72;
+
+// Room to shift the input to every alignment
+const size_t maxOffset = 16;
+
+// The characters that stop a scan, plus the ones that differ from them by a
+// single bit, to catch a sloppy comparison
+const char interestingChars[] = {
+    '"',  '\'', '\\', '\0', '[',  ']',  '{',  '}',  '\x22' ^ 1, '\'' ^ 1,
+    '\\' ^ 1, '\x01', '\x80', '\xa2', '\xdc', '\xff', '{' ^ 0x20, '}' ^ 0x20,
+    '[' ^ 1, '{' ^ 4, 'a',  ' '};
+
+template <typename TMatcher>
+void checkKernels(const char* begin, const char* end, TMatcher match) {
+  const char* expected = findFirstScalar(begin, end, match);
+#if ARDUINOJSON_SIZEOF_POINTER >= 4
+  CHECK(findFirstSwar(begin, end, match) == expected);
+#endif
+#if ARDUINOJSON_ENABLE_SIMD
+  CHECK(findFirstSimd(begin, end, match) == expected);
+#endif
+  CHECK(findFirst(begin, end, match) == expected);
+}
+
+void checkAllMatchers(const char* begin, const char* end) {
+  checkKernels(begin, end, SpecialCharInString('"'));
+  checkKernels(begin, end, SpecialCharInString('\''));
+  checkKernels(begin, end, StructuralChar());
+}
+
+}  // namespace
+
+TEST_CASE("StringScanner: no match at every length and alignment") {
+  char buffer[maxOffset + maxLength];
+  memset(buffer, 'a', sizeof(buffer));
+  for (size_t offset = 0; offset < maxOffset; offset++)
+    for (size_t length = 0; length <= maxLength; length++)
+      checkAllMatchers(buffer + offset, buffer + offset + length);
+}
+
+TEST_CASE("StringScanner: one character at every position") {
+  char buffer[maxOffset + maxLength];
+  for (char c : interestingChars) {
+    for (size_t offset = 0; offset < maxOffset; offset += 3) {
+      for (size_t length = 1; length <= maxLength; length++) {
+        for (size_t i = 0; i < length; i++) {
+          memset(buffer, 'a', sizeof(buffer));
+          buffer[offset + i] = c;
+          checkAllMatchers(buffer + offset, buffer + offset + length);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("StringScanner: a match right after the end is ignored") {
+  char buffer[maxLength + 1];
+  for (size_t length = 0; length <= maxLength; length++) {
+    memset(buffer, 'a', sizeof(buffer));
+    buffer[length] = '"';
+    CHECK(findFirst(buffer, buffer + length, SpecialCharInString('"')) ==
+          buffer + length);
+  }
+}
+
+TEST_CASE("StringScanner: random inputs") {
+  char buffer[maxOffset + maxLength];
+  srand(42);
+  for (int run = 0; run < 20000; run++) {
+    // mostly plain characters, so that the first match can be anywhere
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+      size_t r = static_cast<size_t>(rand());
+      buffer[i] = r % 8 == 0
+                      ? interestingChars[r / 8 % sizeof(interestingChars)]
+                      : static_cast<char>(' ' + r / 8 % 95);
+    }
+    size_t offset = static_cast<size_t>(rand()) % maxOffset;
+    size_t length = static_cast<size_t>(rand()) % (maxLength + 1);
+    checkAllMatchers(buffer + offset, buffer + offset + length);
+  }
+}
+
+TEST_CASE("StringScanner: NUL-terminated inputs use the scalar path") {
+  const char input[] = "abc\"def";
+  CHECK(findFirst(input, nullptr, SpecialCharInString('"')) == input + 3);
+}
+
+TEST_CASE("deserializeJson(): same strings with and without the kernels") {
+  // A NUL-terminated input is scanned one character at a time, a sized input
+  // with the kernels
+  char json[256];
+  char expected[256];
+  srand(7);
+  for (int run = 0; run < 5000; run++) {
+    size_t length = static_cast<size_t>(rand()) % 100;
+    char* p = expected;
+    *p++ = '"';
+    for (size_t i = 0; i < length; i++) {
+      int r = rand() % 16;
+      if (r == 0) {
+        *p++ = '\\';
+        *p++ = '"';
+      } else if (r == 1) {
+        *p++ = '\\';
+        *p++ = 'n';
+      } else if (r == 2) {
+        *p++ = '\'';
+      } else {
+        *p++ = static_cast<char>('a' + r);
+      }
+    }
+    *p++ = '"';
+    *p = 0;
+    size_t n = strlen(expected);
+    memcpy(json, expected, n + 1);
+
+    ArduinoJson::JsonDocument scalar, kernels;
+    CHECK(deserializeJson(scalar, json) ==
+          ArduinoJson::DeserializationError::Ok);
+    CHECK(deserializeJson(kernels, json, n) ==
+          ArduinoJson::DeserializationError::Ok);
+    CHECK(scalar == kernels);
+
+    // and in single quotes
+    expected[0] = expected[n - 1] = '\'';
+    memcpy(json, expected, n + 1);
+    ArduinoJson::DeserializationError scalarError =
+        deserializeJson(scalar, json);
+    ArduinoJson::DeserializationError kernelsError =
+        deserializeJson(kernels, json, n);
+    CHECK(scalarError == kernelsError);
+    if (!scalarError)
+      CHECK(scalar == kernels);
+  }
+}
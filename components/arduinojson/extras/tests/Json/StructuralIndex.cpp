@@ -0,0 +1,154 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Compares the two-stage parser, which reads the contiguous inputs, with the
+// regular parser, which reads the streams: the results and the errors must be
+// the same.
+
+#include <ArduinoJson.h>
+
+#include <sstream>
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+static_assert(ARDUINOJSON_ENABLE_STRUCTURAL_INDEX,
+              "this test checks the two-stage parser");
+
+namespace {
+
+const char* documents[] = {
+    "{\"a\":1,\"b\":[true,false,null],\"c\":{\"d\":-2.5e3}}",
+    "[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25]",
+    "  [ { \"id\" : 1 , \"name\" : \"first\" } ,\n\t{ \"id\":2,\"name\":\"\" } ] ",
+    "{\"long\":\"a string that is longer than a block of sixty-four bytes, to "
+    "check the carries\",\"next\":[\"\\\"quoted\\\" \\\\ and \\/ escapes\"]}",
+    "{\"unicode\":\"\\u00e9\\u4e2d\\ud83d\\ude00\",\"tab\":\"\\t\"}",
+    "[18446744073709551615,-9223372036854775808,1e400,0.1,-0,123456789]",
+    "{\"list\":[{\"id\":1,\"x\":[[]]},{\"id\":2,\"x\":{}},{\"x\":0}]}",
+    "[[[[[[]]]]]]",
+    "{}",
+    "[]",
+    // not standard JSON, or invalid: the regular parser takes over
+    "{'single':'quotes'}",
+    "{unquoted:1}",
+    "[1,2,]",
+    "{\"a\" 1}",
+    "[1 2]",
+    "[\"a\"\\]",
+    "[tru]",
+    "[nulll]",
+    "[1.2.3]",
+    "\"root string\"",
+    "42",
+    "[1] trailing",
+    "",
+    "   ",
+};
+
+// Each filter applies to every document
+const char* filters[] = {
+    nullptr,
+    "{\"a\":true,\"long\":true}",
+    "{\"list\":[{\"id\":true}]}",
+    "[true]",
+    "false",
+};
+
+std::string describe(DeserializationError err, const JsonDocument& doc) {
+  std::string result = err.c_str();
+  result += ' ';
+  serializeJson(doc, result);
+  return result;
+}
+
+// Parses the input with both parsers, with every filter and some nesting
+// limits, and returns true if they agree
+bool parsersAgree(const std::string& input) {
+  bool agree = true;
+  for (const char* filterJson : filters) {
+    JsonDocument filter;
+    if (filterJson)
+      deserializeJson(filter, filterJson);
+    for (uint8_t limit = 0; limit < 8; limit += 3) {
+      JsonDocument indexed, regular;
+      std::istringstream stream(input);
+      DeserializationError indexedError, regularError;
+      if (filterJson) {
+        indexedError =
+            deserializeJson(indexed, input.c_str(),
+                            DeserializationOption::Filter(filter),
+                            DeserializationOption::NestingLimit(limit));
+        regularError =
+            deserializeJson(regular, stream,
+                            DeserializationOption::Filter(filter),
+                            DeserializationOption::NestingLimit(limit));
+      } else {
+        indexedError = deserializeJson(
+            indexed, input, DeserializationOption::NestingLimit(limit));
+        regularError = deserializeJson(
+            regular, stream, DeserializationOption::NestingLimit(limit));
+      }
+      std::string expected = describe(regularError, regular);
+      std::string actual = describe(indexedError, indexed);
+      if (actual != expected) {
+        printf("input: %s\nexpected: %s\nactual: %s\n", input.c_str(),
+               expected.c_str(), actual.c_str());
+        agree = false;
+      }
+    }
+  }
+  return agree;
+}
+
+}  // namespace
+
+TEST_CASE("StructuralIndex: the documents") {
+  for (const char* document : documents)
+    CHECK(parsersAgree(document));
+}
+
+TEST_CASE("StructuralIndex: the truncated documents") {
+  for (const char* document : documents) {
+    std::string input(document);
+    for (size_t n = 0; n < input.size(); n++)
+      CHECK(parsersAgree(input.substr(0, n)));
+  }
+}
+
+TEST_CASE("StructuralIndex: the documents with a missing character") {
+  for (const char* document : documents) {
+    std::string input(document);
+    for (size_t i = 0; i < input.size(); i++)
+      CHECK(parsersAgree(std::string(input).erase(i, 1)));
+  }
+}
+
+TEST_CASE("StructuralIndex: the documents with a changed character") {
+  const char replacements[] = "\"\\{}[]:, x1";
+  for (const char* document : documents) {
+    std::string input(document);
+    for (size_t i = 0; i < input.size(); i++) {
+      for (size_t j = 0; j < sizeof(replacements) - 1; j++) {
+        std::string changed(input);
+        changed[i] = replacements[j];
+        CHECK(parsersAgree(changed));
+      }
+    }
+  }
+}
+
+TEST_CASE("StructuralIndex: the contiguous inputs use the index") {
+  // the index is the only temporary allocation
+  InstrumentedAllocator indexed, regular;
+  JsonDocument indexedDoc(&indexed), regularDoc(&regular);
+  std::istringstream stream(documents[0]);
+  CHECK(deserializeJson(indexedDoc, documents[0]) == DeserializationError::Ok);
+  CHECK(deserializeJson(regularDoc, stream) == DeserializationError::Ok);
+  CHECK(indexed.stats().allocations > regular.stats().allocations);
+  CHECK(indexed.stats().deallocations > regular.stats().deallocations);
+  CHECK(indexedDoc == regularDoc);
+}
@@ -0,0 +1,39 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string.h>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+TEST_CASE("extractJson(): keys and indexes") {
+  const char* input = "{\"a\":[10,{\"b\":\"hello\"}],\"c\":true}";
+  int a0 = 0;
+  char b[8] = "";
+  bool c = false;
+  DeserializationError err =
+      extractJson(input, jsonPath("a", 0), a0, jsonPath("a", 1, "b"), b,
+                  jsonPath("c"), c);
+  CHECK(err == DeserializationError::Ok);
+  CHECK(a0 == 10);
+  CHECK(strcmp(b, "hello") == 0);
+  CHECK(c == true);
+}
+
+TEST_CASE("extractJson(): a negative index matches nothing") {
+  int index = -1;  // not a constant, so it compiles
+  int value = 42;
+  DeserializationError err = extractJson("[1,2,3]", jsonPath(index), value);
+  CHECK(err == DeserializationError::Ok);
+  CHECK(value == 42);
+}
+
+TEST_CASE("extractJson(): a string longer than the char array") {
+  char s[4] = "abc";
+  DeserializationError err = extractJson("[\"hello\"]", jsonPath(0), s);
+  CHECK(err == DeserializationError::NoMemory);
+}
@@ -0,0 +1,163 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <sstream>
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+static_assert(ARDUINOJSON_EVENT_STRING_SIZE == 64,
+              "the tests below rely on the default buffer size");
+
+namespace {
+
+// Writes each event in a log, like "{ k:a 1 }"
+struct LoggingHandler : JsonEventHandler {
+  void onStartObject() {
+    log += "{ ";
+  }
+  void onKeyPart(JsonString key) {
+    log += "kp:" + std::string(key.c_str(), key.size()) + " ";
+  }
+  void onKey(JsonString key) {
+    log += "k:" + std::string(key.c_str(), key.size()) + " ";
+  }
+  void onEndObject() {
+    log += "} ";
+  }
+  void onStartArray() {
+    log += "[ ";
+  }
+  void onEndArray() {
+    log += "] ";
+  }
+  void onStringPart(JsonString s) {
+    log += "sp:" + std::string(s.c_str(), s.size()) + " ";
+  }
+  void onString(JsonString s) {
+    log += "s:" + std::string(s.c_str(), s.size()) + " ";
+  }
+  void onNumber(JsonVariantConst value) {
+    std::string number;
+    serializeJson(value, number);
+    log += number + " ";
+  }
+  void onBoolean(bool value) {
+    log += value ? "true " : "false ";
+  }
+  void onNull() {
+    log += "null ";
+  }
+
+  std::string log;
+};
+
+// Only counts the complete strings
+struct StringCounter : JsonEventHandler {
+  void onString(JsonString) {
+    strings++;
+  }
+
+  int strings = 0;
+};
+
+std::string logEvents(const char* input, DeserializationError expected =
+                                             DeserializationError::Ok) {
+  LoggingHandler handler;
+  DeserializationError err = parseJsonEvents(input, handler);
+  if (err != expected)
+    printf("parseJsonEvents(\"%s\") returned %s\n", input, err.c_str());
+  CHECK(err == expected);
+  return handler.log;
+}
+
+}  // namespace
+
+TEST_CASE("parseJsonEvents(): the sequence of events") {
+  CHECK(logEvents("{\"a\":1,\"b\":[true,false,null],\"c\":\"hi\",\"d\":-2}") ==
+        "{ k:a 1 k:b [ true false null ] k:c s:hi k:d -2 } ");
+  CHECK(logEvents("[]") == "[ ] ");
+  CHECK(logEvents("{}") == "{ } ");
+  CHECK(logEvents(" \"root\" ") == "s:root ");
+  CHECK(logEvents("42") == "42 ");
+  CHECK(logEvents("['single',\"e\\n\\u00e9\"]") ==
+        "[ s:single s:e\n\xc3\xa9 ] ");
+}
+
+TEST_CASE("parseJsonEvents(): nesting") {
+  CHECK(logEvents("[[{\"a\":[{}]}],[]]") == "[ [ { k:a [ { } ] } ] [ ] ] ");
+
+  LoggingHandler handler;
+  CHECK(parseJsonEvents("[[[1]]]", handler,
+                        DeserializationOption::NestingLimit(3)) ==
+        DeserializationError::Ok);
+  CHECK(parseJsonEvents("[[[1]]]", handler,
+                        DeserializationOption::NestingLimit(2)) ==
+        DeserializationError::TooDeep);
+}
+
+TEST_CASE("parseJsonEvents(): the long strings come in parts") {
+  std::string a64(64, 'a'), b64(64, 'b');
+
+  // a full buffer is only passed as a part if more characters follow
+  CHECK(logEvents(("[\"" + a64 + "\"]").c_str()) == "[ s:" + a64 + " ] ");
+  CHECK(logEvents(("[\"" + a64 + "x\"]").c_str()) ==
+        "[ sp:" + a64 + " s:x ] ");
+  CHECK(logEvents(("[\"" + a64 + b64 + "\"]").c_str()) ==
+        "[ sp:" + a64 + " s:" + b64 + " ] ");
+
+  // the keys too
+  CHECK(logEvents(("{\"" + a64 + b64 + "c\":1}").c_str()) ==
+        "{ kp:" + a64 + " kp:" + b64 + " k:c 1 } ");
+
+  // an escape sequence at the boundary
+  CHECK(logEvents(("[\"" + std::string(63, 'a') + "\\n\\\"z\"]").c_str()) ==
+        "[ sp:" + std::string(63, 'a') + "\n s:\"z ] ");
+}
+
+TEST_CASE("parseJsonEvents(): the same parts from every reader") {
+  std::string json = "{\"" + std::string(100, 'k') + "\":\"" +
+                     std::string(150, 's') + "\"}";
+  std::string expected = logEvents(json.c_str());
+
+  LoggingHandler sized, string, stream;
+  std::istringstream input(json);
+  CHECK(parseJsonEvents(json.c_str(), json.size(), sized) ==
+        DeserializationError::Ok);
+  CHECK(parseJsonEvents(json, string) == DeserializationError::Ok);
+  CHECK(parseJsonEvents(input, stream) == DeserializationError::Ok);
+  CHECK(sized.log == expected);
+  CHECK(string.log == expected);
+  CHECK(stream.log == expected);
+}
+
+TEST_CASE("parseJsonEvents(): a handler can ignore the parts") {
+  StringCounter handler;
+  std::string json = "[\"" + std::string(1000, 'x') + "\",\"y\"]";
+  CHECK(parseJsonEvents(json, handler) == DeserializationError::Ok);
+  CHECK(handler.strings == 2);
+}
+
+TEST_CASE("parseJsonEvents(): the errors") {
+  // the events before the error are delivered
+  CHECK(logEvents("[1,2", DeserializationError::IncompleteInput) == "[ 1 2 ");
+  CHECK(logEvents("{\"a\":1 \"b\":2}", DeserializationError::InvalidInput) ==
+        "{ k:a 1 ");
+  CHECK(logEvents("[\"abc", DeserializationError::IncompleteInput) == "[ ");
+  CHECK(logEvents("[tru]", DeserializationError::InvalidInput) == "[ ");
+  CHECK(logEvents("[1,]", DeserializationError::InvalidInput) == "[ 1 ");
+  CHECK(logEvents("{\"a\"}", DeserializationError::InvalidInput) == "{ ");
+  CHECK(logEvents("12x", DeserializationError::InvalidInput) ==
+        "12 ");  // the trailing characters are checked at the end
+  CHECK(logEvents("", DeserializationError::EmptyInput) == "");
+
+  // the error in a long string comes after its parts
+  std::string json = "[\"" + std::string(70, 'x') + "\\q\"]";
+  CHECK(logEvents(json.c_str(), DeserializationError::InvalidInput) ==
+        "[ sp:" + std::string(64, 'x') + " ");
+}
@@ -0,0 +1,103 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Checks what the filters accept in the collections they skip: without
+// comments, JsonLexer::skipCollection() only tracks the brackets and the
+// strings, and doesn't validate the rest.
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+static_assert(!ARDUINOJSON_ENABLE_COMMENTS,
+              "skipCollection_comments.cpp checks the comments");
+
+namespace {
+
+// Deserializes the input, keeping only the "keep" member
+DeserializationError deserializeKeep(JsonDocument& doc, const char* input,
+                                     uint8_t nestingLimit = 10) {
+  JsonDocument filter;
+  filter["keep"] = true;
+  return deserializeJson(doc, input, DeserializationOption::Filter(filter),
+                         DeserializationOption::NestingLimit(nestingLimit));
+}
+
+// Returns the smallest nesting limit that doesn't give TooDeep
+uint8_t minNestingLimit(const char* input, bool filtered) {
+  for (uint8_t limit = 0; limit < 20; limit++) {
+    JsonDocument doc;
+    DeserializationError err =
+        filtered ? deserializeKeep(doc, input, limit)
+                 : deserializeJson(doc, input,
+                                   DeserializationOption::NestingLimit(limit));
+    if (err != DeserializationError::TooDeep)
+      return limit;
+  }
+  return 255;
+}
+
+}  // namespace
+
+TEST_CASE("skipCollection(): valid content") {
+  JsonDocument doc;
+  CHECK(deserializeKeep(doc,
+                        "{\"skip\":{\"a\":[1,{\"b\":\"]}\"}],\"c\":\"\\\"{\","
+                        "\"d\":'}]'},\"keep\":1}") == DeserializationError::Ok);
+  CHECK(doc.as<std::string>() == "{\"keep\":1}");
+
+  CHECK(deserializeKeep(doc, "{\"skip\":[],\"keep\":2,\"other\":{}}") ==
+        DeserializationError::Ok);
+  CHECK(doc.as<std::string>() == "{\"keep\":2}");
+}
+
+TEST_CASE("skipCollection(): the content isn't validated") {
+  JsonDocument doc;
+
+  // anything between balanced brackets
+  CHECK(deserializeKeep(doc, "{\"skip\":[1 2 ;; x],\"keep\":1}") ==
+        DeserializationError::Ok);
+  CHECK(doc["keep"] == 1);
+
+  // even a bracket that closes the wrong kind of collection
+  CHECK(deserializeKeep(doc, "{\"skip\":[1,2},\"keep\":1}") ==
+        DeserializationError::Ok);
+  CHECK(doc["keep"] == 1);
+
+  // but the content after the collection is validated
+  CHECK(deserializeKeep(doc, "{\"skip\":[1] x,\"keep\":1}") ==
+        DeserializationError::InvalidInput);
+}
+
+TEST_CASE("skipCollection(): incomplete input") {
+  JsonDocument doc;
+  CHECK(deserializeKeep(doc, "{\"skip\":[1,2") ==
+        DeserializationError::IncompleteInput);
+  CHECK(deserializeKeep(doc, "{\"skip\":[[1],") ==
+        DeserializationError::IncompleteInput);
+  CHECK(deserializeKeep(doc, "{\"skip\":[\"]") ==
+        DeserializationError::IncompleteInput);
+  CHECK(deserializeKeep(doc, "{\"skip\":[\"\\") ==
+        DeserializationError::IncompleteInput);
+}
+
+TEST_CASE("skipCollection(): the nesting limit is the same as the parser's") {
+  const char* inputs[] = {
+      "{\"skip\":[]}",
+      "{\"skip\":[[1],[2]]}",
+      "{\"skip\":{\"a\":[{\"b\":[]}]}}",
+      "{\"skip\":[\"[[[[\",[[{}]]]}",
+  };
+  for (const char* input : inputs)
+    CHECK(minNestingLimit(input, true) == minNestingLimit(input, false));
+  CHECK(minNestingLimit("{\"skip\":[[[[[]]]]]}", true) == 6);
+
+  JsonDocument doc;
+  CHECK(deserializeKeep(doc, "{\"skip\":[[[[[]]]]],\"keep\":1}", 5) ==
+        DeserializationError::TooDeep);
+}
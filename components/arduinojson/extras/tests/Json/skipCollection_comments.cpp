@@ -0,0 +1,56 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Checks the collections that the filters skip with
+// ARDUINOJSON_ENABLE_COMMENTS: as the comments can contain brackets and quotes,
+// JsonLexer::skipCollection() falls back to skipArray() and skipObject(), which
+// validate the content.
+
+#define ARDUINOJSON_ENABLE_COMMENTS 1
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+// Deserializes the input, keeping only the "keep" member
+DeserializationError deserializeKeep(JsonDocument& doc, const char* input,
+                                     uint8_t nestingLimit = 10) {
+  JsonDocument filter;
+  filter["keep"] = true;
+  return deserializeJson(doc, input, DeserializationOption::Filter(filter),
+                         DeserializationOption::NestingLimit(nestingLimit));
+}
+
+}  // namespace
+
+TEST_CASE("skipCollection() with comments: brackets in the comments") {
+  JsonDocument doc;
+  CHECK(deserializeKeep(doc,
+                        "{\"skip\":[1,/* ]} */2,// }]\n3,\"]\"],"
+                        "/* { */\"keep\":1}") == DeserializationError::Ok);
+  CHECK(doc.as<std::string>() == "{\"keep\":1}");
+}
+
+TEST_CASE("skipCollection() with comments: the content is validated") {
+  JsonDocument doc;
+  CHECK(deserializeKeep(doc, "{\"skip\":[1 2],\"keep\":1}") ==
+        DeserializationError::InvalidInput);
+  CHECK(deserializeKeep(doc, "{\"skip\":[1,2},\"keep\":1}") ==
+        DeserializationError::InvalidInput);
+  CHECK(deserializeKeep(doc, "{\"skip\":[1,/* ]") ==
+        DeserializationError::IncompleteInput);
+}
+
+TEST_CASE("skipCollection() with comments: the nesting limit") {
+  JsonDocument doc;
+  CHECK(deserializeKeep(doc, "{\"skip\":[[[[[]]]]],\"keep\":1}", 6) ==
+        DeserializationError::Ok);
+  CHECK(deserializeKeep(doc, "{\"skip\":[[[[[]]]]],\"keep\":1}", 5) ==
+        DeserializationError::TooDeep);
+}
@@ -0,0 +1,128 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+const size_t slotSize = sizeof(detail::VariantSlot);
+
+// Remembers the size of the largest allocation
+class SpyingAllocator : public Allocator {
+ public:
+  virtual ~SpyingAllocator() {}
+
+  void* allocate(size_t size) override {
+    if (size > largest)
+      largest = size;
+    return upstream_.allocate(size);
+  }
+
+  void deallocate(void* ptr) override {
+    upstream_.deallocate(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t size) override {
+    return upstream_.reallocate(ptr, size);
+  }
+
+  size_t blocks() const {
+    return upstream_.stats().blocks;
+  }
+
+  size_t largest = 0;
+
+ private:
+  InstrumentedAllocator upstream_;
+};
+
+// An array of numbers, so that the only string is the pool's
+std::string makeArray(int count) {
+  std::string json = "[";
+  for (int i = 0; i < count; i++)
+    json += (i ? "," : "") + std::to_string(i);
+  return json + "]";
+}
+
+}  // namespace
+
+TEST_CASE("ExactSize reserves exactly the slots") {
+  SpyingAllocator allocator;
+  JsonDocument doc(&allocator);
+  std::string input = makeArray(200);  // more than a pool
+  CHECK(deserializeJson(doc, input, DeserializationOption::ExactSize()) ==
+        DeserializationError::Ok);
+  CHECK(doc.size() == 200);
+  // a single block: the header and the 200 slots
+  CHECK(allocator.largest == 201 * slotSize);
+}
+
+TEST_CASE("ExactSize releases the reservation after the parse") {
+  SpyingAllocator allocator;
+  JsonDocument doc(&allocator);
+  std::string input = makeArray(200);
+  deserializeJson(doc, input, DeserializationOption::ExactSize());
+  CHECK(allocator.blocks() > 0);
+  doc.clear();
+  CHECK(allocator.blocks() == 0);
+}
+
+TEST_CASE("ExactSize keeps the reservation with setKeepCapacity()") {
+  SpyingAllocator allocator;
+  JsonDocument doc(&allocator);
+  doc.setKeepCapacity(true);
+  std::string input = makeArray(200);
+  deserializeJson(doc, input, DeserializationOption::ExactSize());
+  size_t blocks = allocator.blocks();
+  doc.clear();
+  CHECK(allocator.blocks() == blocks);
+
+  // the same input again doesn't allocate
+  allocator.largest = 0;
+  deserializeJson(doc, input);
+  CHECK(allocator.largest == 0);
+  CHECK(allocator.blocks() == blocks);
+}
+
+TEST_CASE("ExactSize restores the previous reservation") {
+  SpyingAllocator allocator;
+  JsonDocument doc(&allocator);
+  doc.reserve(10);
+  std::string input = makeArray(200);
+  deserializeJson(doc, input, DeserializationOption::ExactSize());
+  doc.clear();  // frees the 200 slots
+
+  allocator.largest = 0;
+  deserializeJson(doc, "[1]");
+  CHECK(allocator.largest == 11 * slotSize);  // the 10 reserved slots
+}
+
+TEST_CASE("ExactSize reserves the strings with the same hash") {
+  // "declinate" and "macallums" collide with the 32-bit FNV-1a, and so do
+  // they with the same suffix
+  std::string colliding = "[", different = "[";
+  for (int i = 0; i < 5; i++) {
+    std::string suffix = std::string(100, 'x') + std::to_string(i);
+    colliding += "\"declinate" + suffix + "\",\"macallums" + suffix + "\",";
+    different += "\"declinate" + suffix + "\",\"different" + suffix + "\",";
+  }
+  colliding.back() = ']';
+  different.back() = ']';
+
+  // a document each, as a larger string buffer would be kept
+  SpyingAllocator allocator1, allocator2;
+  JsonDocument doc1(&allocator1), doc2(&allocator2);
+  deserializeJson(doc1, different, DeserializationOption::ExactSize());
+  deserializeJson(doc2, colliding, DeserializationOption::ExactSize());
+  // the pool and the string buffer; none of the strings is on the heap
+  CHECK(allocator1.blocks() == 2);
+  CHECK(allocator2.blocks() == 2);
+  CHECK(doc2.size() == 10);
+}
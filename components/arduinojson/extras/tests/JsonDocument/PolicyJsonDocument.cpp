@@ -0,0 +1,75 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+struct KeepingPolicy : DefaultDocumentPolicy {
+  static const bool keepCapacity = true;
+};
+
+struct NonShrinkingPolicy : DefaultDocumentPolicy {
+  static const bool autoShrink = false;
+};
+
+const char json[] = "[1,2,3,4,5,6,7,8,9,10]";
+
+// Returns true if clear() keeps the memory of the document
+bool keepsCapacity(JsonDocument& doc, InstrumentedAllocator& allocator) {
+  if (doc.allocator() != &allocator)
+    return false;
+  deserializeJson(doc, json);
+  size_t blocks = allocator.stats().blocks;
+  doc.clear();
+  return blocks > 0 && allocator.stats().blocks == blocks;
+}
+
+// Returns true if deserializeJson() shrinks the memory pool
+bool shrinks(JsonDocument& doc, InstrumentedAllocator& allocator) {
+  CHECK(doc.allocator() == &allocator);
+  doc.clear();
+  allocator.resetStats();
+  deserializeJson(doc, json);
+  return allocator.stats().reallocations > 0;
+}
+
+}  // namespace
+
+TEST_CASE("PolicyJsonDocument: the move-constructor takes keepCapacity") {
+  InstrumentedAllocator allocator;
+  PolicyJsonDocument<KeepingPolicy> src(&allocator);
+
+  PolicyJsonDocument<KeepingPolicy> doc(detail::move(src));
+  CHECK(keepsCapacity(doc, allocator));
+  CHECK(keepsCapacity(src, allocator));
+}
+
+TEST_CASE("PolicyJsonDocument: the move-constructor takes autoShrink") {
+  InstrumentedAllocator allocator;
+  JsonDocument control(&allocator);
+  CHECK(shrinks(control, allocator));
+
+  PolicyJsonDocument<NonShrinkingPolicy> src(&allocator);
+  PolicyJsonDocument<NonShrinkingPolicy> doc(detail::move(src));
+  CHECK(!shrinks(doc, allocator));
+  CHECK(!shrinks(src, allocator));
+}
+
+TEST_CASE("PolicyJsonDocument: the move-constructor takes the symbol table") {
+  SymbolTable table;
+  PolicyJsonDocument<> src;
+  src.setSymbolTable(&table);
+  deserializeJson(src, "{\"sensor\":1}");
+
+  PolicyJsonDocument<> doc(detail::move(src));
+  CHECK(doc.symbolTable() == &table);
+  CHECK(src.symbolTable() == nullptr);
+  CHECK(table.documents() == 1);
+  CHECK(doc["sensor"] == 1);
+}
@@ -0,0 +1,154 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+// Overwrites the blocks before freeing them, so that reading a freed key
+// fails reliably
+class ScrubbingAllocator : public Allocator {
+ public:
+  virtual ~ScrubbingAllocator() {}
+
+  void* allocate(size_t size) override {
+    auto block = static_cast<size_t*>(malloc(sizeof(size_t) + size));
+    *block = size;
+    return block + 1;
+  }
+
+  void deallocate(void* ptr) override {
+    if (!ptr)
+      return;
+    auto block = static_cast<size_t*>(ptr) - 1;
+    memset(ptr, 0xFF, *block);
+    free(block);
+  }
+
+  void* reallocate(void*, size_t) override {
+    return nullptr;  // the string pool of a SymbolTable doesn't reallocate
+  }
+};
+
+bool hasKey(JsonObjectConst obj, const char* key) {
+  for (auto kvp : obj) {
+    if (kvp.key() == key)
+      return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+TEST_CASE("SymbolTable: the copy-constructor links to the same keys") {
+  SymbolTable table;
+  JsonDocument doc1;
+  doc1.setSymbolTable(&table);
+  deserializeJson(doc1, "{\"sensor\":1}");
+
+  JsonDocument doc2(doc1);
+  CHECK(doc2.symbolTable() == &table);
+  CHECK(doc2.as<JsonObject>().begin()->key().c_str() ==
+        doc1.as<JsonObject>().begin()->key().c_str());
+  CHECK(table.documents() == 2);
+}
+
+TEST_CASE("SymbolTable: the assignment attaches to the same table") {
+  SymbolTable table;
+  JsonDocument doc1, doc2;
+  doc1.setSymbolTable(&table);
+  deserializeJson(doc1, "{\"sensor\":1}");
+
+  doc2 = doc1;
+  CHECK(doc2.symbolTable() == &table);
+  CHECK(table.documents() == 2);
+  CHECK(!table.clear());
+  CHECK(doc2["sensor"] == 1);
+}
+
+TEST_CASE("SymbolTable: a document that isn't attached copies the keys") {
+  ScrubbingAllocator allocator;
+  SymbolTable table(&allocator);
+  JsonDocument doc2, doc3;
+  {
+    JsonDocument doc1;
+    doc1.setSymbolTable(&table);
+    deserializeJson(doc1, "{\"sensor\":1,\"nested\":{\"temperature\":2}}");
+
+    doc2.set(doc1);
+    doc3["x"] = doc1.as<JsonObject>();
+  }
+  CHECK(table.documents() == 0);
+  CHECK(table.clear());
+
+  CHECK(hasKey(doc2.as<JsonObject>(), "sensor"));
+  CHECK(hasKey(doc2["nested"].as<JsonObject>(), "temperature"));
+  CHECK(hasKey(doc3["x"].as<JsonObject>(), "sensor"));
+  CHECK(hasKey(doc3["x"]["nested"].as<JsonObject>(), "temperature"));
+  CHECK(doc2["sensor"] == 1);
+  CHECK(doc3["x"]["nested"]["temperature"] == 2);
+}
+
+TEST_CASE("SymbolTable: a document attached to another table interns them") {
+  SymbolTable table1, table2;
+  JsonDocument doc1, doc2;
+  doc1.setSymbolTable(&table1);
+  doc2.setSymbolTable(&table2);
+  deserializeJson(doc1, "{\"sensor\":1}");
+
+  doc2.set(doc1);
+  CHECK(table1.size() > 0);
+  CHECK(table2.size() == table1.size());
+  CHECK(doc2.as<JsonObject>().begin()->key().c_str() !=
+        doc1.as<JsonObject>().begin()->key().c_str());
+}
+
+TEST_CASE("SymbolTable: compact() keeps the links") {
+  SymbolTable table;
+  JsonDocument doc;
+  doc.setSymbolTable(&table);
+  deserializeJson(doc, "{\"sensor\":1}");
+  const char* key = doc.as<JsonObject>().begin()->key().c_str();
+
+  CHECK(doc.compact());
+  CHECK(doc.symbolTable() == &table);
+  CHECK(doc.as<JsonObject>().begin()->key().c_str() == key);
+}
+
+TEST_CASE("SymbolTable: the destructor frees the keys") {
+  InstrumentedAllocator allocator;
+  auto table = new SymbolTable(&allocator);
+  JsonDocument doc;
+  doc.setSymbolTable(table);
+  deserializeJson(doc, "{\"sensor\":1}");
+  CHECK(allocator.stats().blocks > 0);
+
+  doc.setSymbolTable(nullptr);  // the documents must be detached first
+  delete table;
+  CHECK(allocator.stats().blocks == 0);
+}
+
+TEST_CASE("SymbolTable: swap() exchanges the tables") {
+  SymbolTable table1, table2;
+  JsonDocument doc1, doc2;
+  doc1.setSymbolTable(&table1);
+  doc2.setSymbolTable(&table2);
+
+  swap(doc1, doc2);
+  CHECK(doc1.symbolTable() == &table2);
+  CHECK(doc2.symbolTable() == &table1);
+  CHECK(table1.documents() == 1);
+  CHECK(table2.documents() == 1);
+
+  doc1.setSymbolTable(nullptr);
+  CHECK(table2.documents() == 0);
+  CHECK(table2.clear());
+}
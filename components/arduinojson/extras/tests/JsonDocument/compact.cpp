@@ -0,0 +1,186 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+// Fails the allocations while failing is set
+class FailingAllocator : public Allocator {
+ public:
+  virtual ~FailingAllocator() {}
+
+  void* allocate(size_t size) override {
+    return failing ? nullptr : upstream_.allocate(size);
+  }
+
+  void deallocate(void* ptr) override {
+    upstream_.deallocate(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t size) override {
+    return failing ? nullptr : upstream_.reallocate(ptr, size);
+  }
+
+  AllocationStats stats() const {
+    return upstream_.stats();
+  }
+
+  bool failing = false;
+
+ private:
+  InstrumentedAllocator upstream_;
+};
+
+// A string too long to be stored in the variant
+std::string longString(int i) {
+  return "a long string value, number " + std::to_string(i);
+}
+
+// Fills an object with n members of every kind
+void fill(JsonObject object, int n) {
+  for (int i = 0; i < n; i++) {
+    JsonObject member = object["member" + std::to_string(i)].to<JsonObject>();
+    member["int"] = i;
+    member["double"] = i + 0.5;
+    member["bool"] = i % 2 == 0;
+    member["null"] = nullptr;
+    member["linked"] = "linked";
+    member["copied"] = longString(i);
+    member["raw"] = serialized("[" + std::to_string(i) + "]");
+    JsonArray array = member["array"].to<JsonArray>();
+    array.add(i);
+    array.add(longString(i + 1));
+    array.add<JsonObject>()["nested"] = i;
+  }
+}
+
+// Returns true if the elements are in increasing slot addresses
+bool inAddressOrder(JsonArrayConst array) {
+  const detail::VariantData* previous = nullptr;
+  for (JsonVariantConst element : array) {
+    auto data = detail::VariantAttorney::getData(element);
+    if (previous && data < previous)
+      return false;
+    previous = data;
+  }
+  return true;
+}
+
+std::string toJson(JsonVariantConst variant) {
+  std::string json;
+  serializeJson(variant, json);
+  return json;
+}
+
+}  // namespace
+
+TEST_CASE("compact() keeps the values") {
+  JsonDocument doc;
+  fill(doc.to<JsonObject>(), 10);
+  std::string before = toJson(doc);
+
+  CHECK(doc.compact());
+  CHECK(toJson(doc) == before);
+  CHECK(doc["member3"]["int"] == 3);
+  CHECK(doc["member3"]["double"] == 3.5);
+  CHECK(doc["member3"]["bool"] == false);
+  CHECK(doc["member3"]["null"].isNull());
+  CHECK(doc["member3"]["copied"] == longString(3));
+  CHECK(doc["member3"]["array"][2]["nested"] == 3);
+}
+
+TEST_CASE("compact() keeps the linked strings linked") {
+  JsonDocument doc;
+  const char* linked = "linked";
+  doc["key"] = linked;
+
+  CHECK(doc.compact());
+  CHECK(doc["key"].as<const char*>() == linked);
+}
+
+TEST_CASE("compact() frees the slots and the strings of the removed values") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  fill(doc.to<JsonObject>(), 30);
+  for (int i = 0; i < 30; i++) {
+    if (i % 10 != 0)
+      doc.remove("member" + std::to_string(i));
+  }
+  std::string survivors = toJson(doc);
+  size_t bytesBefore = allocator.stats().bytes;
+
+  CHECK(doc.compact());
+  CHECK(toJson(doc) == survivors);
+  CHECK(allocator.stats().bytes < bytesBefore);
+
+  // as small as the same document parsed from scratch
+  InstrumentedAllocator parsedAllocator;
+  JsonDocument parsed(&parsedAllocator);
+  deserializeJson(parsed, survivors);
+  CHECK(allocator.stats().bytes <= parsedAllocator.stats().bytes);
+}
+
+TEST_CASE("compact() lays out the slots in depth-first order") {
+  JsonDocument doc;
+  JsonArray array = doc.to<JsonArray>();
+  for (int i = 0; i < 20; i++)
+    array.add(i);
+  for (size_t i = 0; i < 10; i++)
+    array.remove(i);  // the even numbers, which leaves holes in the pool
+  for (int i = 0; i < 10; i++)
+    array.add(100 + i);  // which the new elements fill
+  std::string before = toJson(doc);
+  CHECK(!inAddressOrder(doc.as<JsonArrayConst>()));
+
+  CHECK(doc.compact());
+  CHECK(toJson(doc) == before);
+  CHECK(inAddressOrder(doc.as<JsonArrayConst>()));
+}
+
+TEST_CASE("compact() can be followed by more changes") {
+  JsonDocument doc;
+  fill(doc.to<JsonObject>(), 5);
+  doc.remove("member1");
+  CHECK(doc.compact());
+
+  doc["member1"] = "back";
+  doc["member2"]["array"].add(longString(42));
+  doc.remove("member3");
+  CHECK(doc["member1"] == "back");
+  CHECK(doc["member2"]["array"][3] == longString(42));
+  CHECK(doc["member3"].isNull());
+  CHECK(doc.size() == 4);
+}
+
+TEST_CASE("compact() on an empty document") {
+  JsonDocument doc;
+  CHECK(doc.compact());
+  CHECK(doc.isNull());
+}
+
+TEST_CASE("compact() leaves the document unchanged when it fails") {
+  FailingAllocator allocator;
+  JsonDocument doc(&allocator);
+  fill(doc.to<JsonObject>(), 5);
+  doc.remove("member2");
+  std::string before = toJson(doc);
+  AllocationStats stats = allocator.stats();
+
+  allocator.failing = true;
+  CHECK(!doc.compact());
+  CHECK(toJson(doc) == before);
+  CHECK(allocator.stats().blocks == stats.blocks);
+  CHECK(allocator.stats().bytes == stats.bytes);
+
+  allocator.failing = false;
+  CHECK(doc.compact());
+  CHECK(toJson(doc) == before);
+}
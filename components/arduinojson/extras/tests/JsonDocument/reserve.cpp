@@ -0,0 +1,107 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+const char json[] = "{\"name\":\"sensor\",\"values\":[1,2,3],\"unit\":\"C\"}";
+
+// Returns the number of allocations made by deserializeJson()
+size_t allocationsToDeserialize(JsonDocument& doc,
+                                InstrumentedAllocator& allocator,
+                                const char* input = json) {
+  allocator.resetStats();
+  CHECK(deserializeJson(doc, input) == DeserializationError::Ok);
+  return allocator.stats().allocations + allocator.stats().reallocations;
+}
+
+// Refuses every allocation
+class NullAllocator : public Allocator {
+ public:
+  virtual ~NullAllocator() {}
+
+  void* allocate(size_t) override {
+    return nullptr;
+  }
+
+  void deallocate(void*) override {}
+
+  void* reallocate(void*, size_t) override {
+    return nullptr;
+  }
+};
+
+}  // namespace
+
+TEST_CASE("reserve() allocates one block for the slots, one for the strings") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+
+  CHECK(doc.reserve(20, 256));
+  CHECK(allocator.stats().allocations == 2);
+  CHECK(allocator.stats().blocks == 2);
+
+  CHECK(allocationsToDeserialize(doc, allocator) == 0);
+  CHECK(doc["name"] == "sensor");
+  CHECK(doc["values"][2] == 3);
+}
+
+TEST_CASE("reserve() keeps the blocks across clear()") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  CHECK(doc.reserve(20, 256));
+  AllocationStats reserved = allocator.stats();
+
+  for (int i = 0; i < 3; i++) {
+    CHECK(allocationsToDeserialize(doc, allocator) == 0);
+    doc.clear();
+    CHECK(allocator.stats().deallocations == 0);
+    CHECK(allocator.stats().blocks == reserved.blocks);
+    CHECK(allocator.stats().bytes == reserved.bytes);
+  }
+
+  doc["other"] = "value";  // the setters use the reserved slots too
+  CHECK(allocator.stats().blocks == reserved.blocks);
+}
+
+TEST_CASE("reserve() lets the excess go to the allocator, until clear()") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  CHECK(doc.reserve(2, 8));
+  size_t reservedBlocks = allocator.stats().blocks;
+
+  CHECK(allocationsToDeserialize(doc, allocator) > 0);
+  CHECK(doc["name"] == "sensor");
+  CHECK(doc["values"][2] == 3);
+  CHECK(allocator.stats().blocks > reservedBlocks);
+
+  doc.clear();
+  CHECK(allocator.stats().blocks == reservedBlocks);
+}
+
+TEST_CASE("reserve() frees the blocks when the reservation is removed") {
+  InstrumentedAllocator allocator;
+  {
+    JsonDocument doc(&allocator);
+    CHECK(doc.reserve(20, 256));
+    CHECK(doc.reserve(0, 0));
+    doc.clear();
+    CHECK(allocator.stats().blocks == 0);
+    CHECK(doc.reserve(20, 256));
+  }
+  CHECK(allocator.stats().blocks == 0);
+}
+
+TEST_CASE("reserve() returns false when the allocation fails") {
+  NullAllocator allocator;
+  JsonDocument doc(&allocator);
+  CHECK(!doc.reserve(20));
+  CHECK(!doc.reserve(0, 256));
+  CHECK(doc.reserve(0, 0));
+}
@@ -0,0 +1,66 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+static_assert(ARDUINOJSON_AUTO_SHRINK, "this test checks setAutoShrink()");
+
+namespace {
+
+const char json[] = "[1,2,3]";
+
+// Returns the bytes allocated after deserializeJson()
+size_t bytesAfterDeserialize(JsonDocument& doc,
+                             InstrumentedAllocator& allocator) {
+  CHECK(deserializeJson(doc, json) == DeserializationError::Ok);
+  return allocator.stats().bytes;
+}
+
+}  // namespace
+
+TEST_CASE("setAutoShrink() is enabled by default") {
+  InstrumentedAllocator shrunk, full;
+  JsonDocument control(&full);
+  control.setAutoShrink(false);
+  JsonDocument doc(&shrunk);
+
+  CHECK(bytesAfterDeserialize(doc, shrunk) <
+        bytesAfterDeserialize(control, full));
+  CHECK(shrunk.stats().reallocations > 0);
+  CHECK(full.stats().reallocations == 0);
+
+  // shrinkToFit() does the same thing
+  control.shrinkToFit();
+  CHECK(full.stats().bytes == shrunk.stats().bytes);
+  CHECK(doc == control);
+}
+
+TEST_CASE("setAutoShrink(false) keeps the whole pool") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  size_t shrunk = bytesAfterDeserialize(doc, allocator);
+
+  doc.setAutoShrink(false);
+  size_t full = bytesAfterDeserialize(doc, allocator);
+  CHECK(full > shrunk);
+
+  doc.setAutoShrink(true);
+  CHECK(bytesAfterDeserialize(doc, allocator) == shrunk);
+}
+
+TEST_CASE("setAutoShrink() has no effect with setKeepCapacity()") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  doc.setKeepCapacity(true);
+  size_t bytes = bytesAfterDeserialize(doc, allocator);
+  CHECK(allocator.stats().reallocations == 0);
+
+  doc.setAutoShrink(true);
+  CHECK(bytesAfterDeserialize(doc, allocator) == bytes);
+  CHECK(allocator.stats().reallocations == 0);
+}
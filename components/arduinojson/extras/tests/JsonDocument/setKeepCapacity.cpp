@@ -0,0 +1,164 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+// An array of numbers, long enough to need several pools, and no string
+std::string makeNumbers(int count) {
+  std::string json = "[";
+  for (int i = 0; i < count; i++)
+    json += (i ? "," : "") + std::to_string(i);
+  return json + "]";
+}
+
+// An array of objects, with keys and string values
+std::string makeObjects(int count) {
+  std::string json = "[";
+  for (int i = 0; i < count; i++) {
+    json += i ? "," : "";
+    json += "{\"id\":" + std::to_string(i) + ",\"name\":\"item " +
+            std::to_string(i) + "\",\"tags\":[\"a\",\"b\"]}";
+  }
+  return json + "]";
+}
+
+// Returns the number of allocations made by deserializeJson()
+size_t allocationsToDeserialize(JsonDocument& doc,
+                                InstrumentedAllocator& allocator,
+                                const std::string& input) {
+  allocator.resetStats();
+  CHECK(deserializeJson(doc, input) == DeserializationError::Ok);
+  return allocator.stats().allocations + allocator.stats().reallocations;
+}
+
+std::string toJson(const JsonDocument& doc) {
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+}  // namespace
+
+TEST_CASE("setKeepCapacity(): without it, clear() frees the pools") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  std::string input = makeNumbers(300);
+
+  CHECK(allocationsToDeserialize(doc, allocator, input) > 0);
+  doc.clear();
+  CHECK(allocator.stats().blocks == 0);
+  CHECK(allocationsToDeserialize(doc, allocator, input) > 0);
+}
+
+TEST_CASE("setKeepCapacity(): clear() keeps the pools") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  doc.setKeepCapacity(true);
+  std::string input = makeNumbers(300);
+
+  CHECK(allocationsToDeserialize(doc, allocator, input) > 0);
+  AllocationStats parsed = allocator.stats();
+
+  for (int i = 0; i < 3; i++) {
+    doc.clear();
+    CHECK(doc.isNull());
+    CHECK(allocator.stats().deallocations == 0);
+    CHECK(allocator.stats().blocks == parsed.blocks);
+    CHECK(allocator.stats().bytes == parsed.bytes);
+
+    // the next parse doesn't allocate, and gives the same document
+    CHECK(allocationsToDeserialize(doc, allocator, input) == 0);
+    CHECK(allocator.stats().deallocations == 0);
+    CHECK(toJson(doc) == input);
+  }
+}
+
+TEST_CASE("setKeepCapacity(): the strings are allocated without it") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  doc.setKeepCapacity(true);
+  std::string input = makeObjects(50);
+
+  CHECK(allocationsToDeserialize(doc, allocator, input) > 0);
+  doc.clear();
+  size_t stringAllocations = allocationsToDeserialize(doc, allocator, input);
+  CHECK(stringAllocations > 0);
+
+  // the pools are kept, so only the strings are allocated again
+  doc.clear();
+  CHECK(allocationsToDeserialize(doc, allocator, input) == stringAllocations);
+  CHECK(toJson(doc) == input);
+}
+
+TEST_CASE("setKeepCapacity(): recycleStrings keeps the string memory") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  doc.setKeepCapacity(true, true);
+  std::string input = makeObjects(50);
+
+  CHECK(allocationsToDeserialize(doc, allocator, input) > 0);
+
+  for (int i = 0; i < 3; i++) {
+    doc.clear();
+    CHECK(allocationsToDeserialize(doc, allocator, input) == 0);
+    CHECK(toJson(doc) == input);
+  }
+
+  // a smaller input fits too
+  doc.clear();
+  CHECK(allocationsToDeserialize(doc, allocator, makeObjects(10)) == 0);
+  CHECK(toJson(doc) == makeObjects(10));
+}
+
+TEST_CASE("setKeepCapacity(): a larger input allocates the difference") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  doc.setKeepCapacity(true);
+
+  CHECK(allocationsToDeserialize(doc, allocator, makeNumbers(100)) > 0);
+  size_t blocks = allocator.stats().blocks;
+  doc.clear();
+
+  CHECK(allocationsToDeserialize(doc, allocator, makeNumbers(600)) > 0);
+  CHECK(allocator.stats().deallocations == 0);
+  CHECK(allocator.stats().blocks > blocks);
+  CHECK(toJson(doc) == makeNumbers(600));
+}
+
+TEST_CASE("setKeepCapacity(): shrinkToFit() frees the unused pools") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  doc.setKeepCapacity(true);
+
+  deserializeJson(doc, makeNumbers(600));
+  size_t blocks = allocator.stats().blocks;
+  doc.clear();
+  CHECK(allocator.stats().blocks == blocks);
+
+  doc.shrinkToFit();
+  CHECK(allocator.stats().blocks < blocks);
+}
+
+TEST_CASE("setKeepCapacity(false): clear() frees the pools again") {
+  InstrumentedAllocator allocator;
+  JsonDocument doc(&allocator);
+  doc.setKeepCapacity(true, true);
+
+  deserializeJson(doc, makeObjects(50));
+  doc.clear();
+  CHECK(allocator.stats().blocks > 0);
+
+  doc.setKeepCapacity(false);
+  deserializeJson(doc, makeObjects(50));
+  doc.clear();
+  CHECK(allocator.stats().blocks == 0);
+}
@@ -0,0 +1,54 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+// An allocator whose reallocate() always moves the block, like a heap that
+// can't resize in place
+class MovingAllocator : public Allocator {
+ public:
+  virtual ~MovingAllocator() {}
+
+  void* allocate(size_t size) override {
+    return malloc(size);
+  }
+
+  void deallocate(void* ptr) override {
+    free(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t newSize) override {
+    void* newPtr = malloc(newSize);
+    if (newPtr && ptr)
+      memcpy(newPtr, ptr, newSize);  // only shrinks in these tests
+    free(ptr);
+    return newPtr;
+  }
+};
+
+}  // namespace
+
+TEST_CASE("shrinkToFit() doesn't invalidate the short strings") {
+  MovingAllocator allocator;
+  JsonDocument doc(&allocator);
+  deserializeJson(doc, "{\"a\":\"hi\",\"b\":\"hello world\"}");
+  const char* a = doc["a"].as<const char*>();
+  const char* b = doc["b"].as<const char*>();
+
+  doc.shrinkToFit();
+
+  CHECK(doc["a"].as<const char*>() == a);
+  CHECK(doc["b"].as<const char*>() == b);
+  CHECK(strcmp(a, "hi") == 0);
+  CHECK(strcmp(b, "hello world") == 0);
+}
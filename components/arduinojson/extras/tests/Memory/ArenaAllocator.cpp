@@ -0,0 +1,108 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Soak tests: thousands of documents of random shapes are parsed, modified,
+// and destroyed in the same ArenaAllocator, to check that it stops requesting
+// memory from the heap once it has seen the largest document.
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Random.hpp"
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+namespace {
+
+const size_t largestDocument = 60;  // members of the root object
+
+// An object with random members: numbers, strings of 1 to 200 characters,
+// and arrays
+std::string makeJson(Random& random, size_t members) {
+  std::string json = "{";
+  for (size_t i = 0; i < members; i++) {
+    if (i)
+      json += ",";
+    json += "\"key" + std::to_string(random.next() % 1000) + "\":";
+    switch (random.next() % 3) {
+      case 0:
+        json += std::to_string(random.next() % 100000);
+        break;
+      case 1:
+        json += "\"" + std::string(1 + random.next() % 200, 'x') + "\"";
+        break;
+      default:
+        json += "[1,\"two\",3.5,[4]]";
+        break;
+    }
+  }
+  return json + "}";
+}
+
+// Parses, edits, and serializes a document, like a typical request handler
+void runCycle(Allocator* allocator, Random& random, size_t members) {
+  JsonDocument doc(allocator);
+  std::string input = makeJson(random, members);
+  CHECK(deserializeJson(doc, input) == DeserializationError::Ok);
+  CHECK(!doc.overflowed());
+
+  // replacing the strings leaves holes in the arena
+  for (JsonPair kv : doc.as<JsonObject>()) {
+    if (kv.value().is<const char*>())
+      kv.value().set(std::string(1 + random.next() % 200, 'y'));
+  }
+  doc["status"] = "ok";
+  doc["list"].add(std::string(50, 'z'));
+
+  std::string output;
+  serializeJson(doc, output);
+  JsonDocument check;
+  CHECK(deserializeJson(check, output) == DeserializationError::Ok);
+  CHECK(check == doc);
+}
+
+}  // namespace
+
+TEST_CASE("ArenaAllocator: chunks stop growing after the largest document") {
+  InstrumentedAllocator heap;
+  {
+    ArenaAllocator arena(4096, &heap);
+    Random random(6);
+
+    // the largest document first, then the warm-up
+    runCycle(&arena, random, largestDocument);
+    arena.clear();
+    for (int i = 0; i < 100; i++) {
+      runCycle(&arena, random, random.next() % (largestDocument + 1));
+      arena.clear();
+    }
+    AllocationStats warm = heap.stats();
+
+    for (int i = 0; i < 2000; i++) {
+      runCycle(&arena, random, random.next() % (largestDocument + 1));
+      arena.clear();
+    }
+    CHECK(heap.stats().allocations == warm.allocations);
+    CHECK(heap.stats().reallocations == warm.reallocations);
+    CHECK(heap.stats().deallocations == 0);
+    CHECK(heap.stats().bytes == warm.bytes);
+  }
+  CHECK(heap.stats().blocks == 0);
+}
+
+TEST_CASE("ArenaAllocator: the overflow goes to the fallback and comes back") {
+  static char buffer[8192];
+  InstrumentedAllocator heap;
+  ArenaAllocator arena(buffer, sizeof(buffer), &heap);
+  Random random(7);
+
+  for (int i = 0; i < 2000; i++) {
+    runCycle(&arena, random, random.next() % (largestDocument + 1));
+    arena.clear();
+    CHECK(heap.stats().blocks == 0);  // nothing leaked to the heap
+  }
+  CHECK(heap.stats().allocations > 0);  // the buffer was too small sometimes
+}
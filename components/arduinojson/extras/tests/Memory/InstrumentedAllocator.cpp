@@ -0,0 +1,187 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+
+static_assert(ARDUINOJSON_ENABLE_ALLOCATION_STATS,
+              "this test checks JsonDocument::allocationProfile()");
+
+namespace {
+
+// The size of the header of each block of an InstrumentedAllocator
+const size_t headerSize = detail::AddPadding<sizeof(size_t)>::value;
+
+// Fails the allocations once the budget is spent
+class FailingAllocator : public Allocator {
+ public:
+  virtual ~FailingAllocator() {}
+
+  void* allocate(size_t size) override {
+    if (!budget)
+      return nullptr;
+    budget--;
+    return upstream_.allocate(size);
+  }
+
+  void deallocate(void* ptr) override {
+    upstream_.deallocate(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t size) override {
+    if (!budget)
+      return nullptr;
+    budget--;
+    return upstream_.reallocate(ptr, size);
+  }
+
+  size_t budget = 0;
+
+ private:
+  InstrumentedAllocator upstream_;
+};
+
+// The sum of the counters of the profile
+AllocationStats total(const AllocationProfile& profile) {
+  AllocationStats sum;
+  for (const AllocationStats* stats :
+       {&profile.pools, &profile.strings, &profile.stringBuilder,
+        &profile.indexes, &profile.packedArrays}) {
+    sum.allocations += stats->allocations;
+    sum.deallocations += stats->deallocations;
+    sum.bytes += stats->bytes;
+    sum.blocks += stats->blocks;
+  }
+  return sum;
+}
+
+}  // namespace
+
+TEST_CASE("InstrumentedAllocator: counts the bytes and the blocks") {
+  InstrumentedAllocator allocator;
+
+  void* a = allocator.allocate(10);
+  void* b = allocator.allocate(20);
+  CHECK(a && b);
+  CHECK(allocator.stats().allocations == 2);
+  CHECK(allocator.stats().bytes == 30);
+  CHECK(allocator.stats().blocks == 2);
+
+  a = allocator.reallocate(a, 50);
+  CHECK(a);
+  CHECK(allocator.stats().reallocations == 1);
+  CHECK(allocator.stats().bytes == 70);
+  CHECK(allocator.stats().peakBytes == 70);
+  CHECK(allocator.stats().blocks == 2);
+
+  a = allocator.reallocate(a, 5);
+  CHECK(allocator.stats().bytes == 25);
+  CHECK(allocator.stats().peakBytes == 70);
+
+  allocator.deallocate(a);
+  allocator.deallocate(b);
+  allocator.deallocate(nullptr);  // not counted
+  CHECK(allocator.stats().deallocations == 2);
+  CHECK(allocator.stats().bytes == 0);
+  CHECK(allocator.stats().blocks == 0);
+  CHECK(allocator.stats().peakBlocks == 2);
+  CHECK(allocator.stats().failures == 0);
+}
+
+TEST_CASE("InstrumentedAllocator: reallocate(nullptr) allocates") {
+  InstrumentedAllocator allocator;
+  void* p = allocator.reallocate(nullptr, 8);
+  CHECK(p);
+  CHECK(allocator.stats().allocations == 1);
+  CHECK(allocator.stats().reallocations == 0);
+  CHECK(allocator.stats().bytes == 8);
+  allocator.deallocate(p);
+}
+
+TEST_CASE("InstrumentedAllocator: counts the failures") {
+  FailingAllocator upstream;
+  InstrumentedAllocator allocator(&upstream);
+
+  CHECK(allocator.allocate(10) == nullptr);
+  CHECK(allocator.stats().failures == 1);
+
+  upstream.budget = 1;
+  void* p = allocator.allocate(10);
+  CHECK(p);
+  CHECK(allocator.reallocate(p, 100) == nullptr);  // p is still valid
+  CHECK(allocator.stats().failures == 2);
+  CHECK(allocator.stats().allocations == 1);
+  CHECK(allocator.stats().reallocations == 0);
+  CHECK(allocator.stats().bytes == 10);
+  allocator.deallocate(p);
+  CHECK(allocator.stats().blocks == 0);
+}
+
+TEST_CASE("InstrumentedAllocator: resetStats() keeps the current values") {
+  InstrumentedAllocator allocator;
+  void* a = allocator.allocate(100);
+  void* b = allocator.allocate(10);
+  allocator.deallocate(a);
+
+  allocator.resetStats();
+  CHECK(allocator.stats().allocations == 0);
+  CHECK(allocator.stats().deallocations == 0);
+  CHECK(allocator.stats().bytes == 10);
+  CHECK(allocator.stats().peakBytes == 10);
+  CHECK(allocator.stats().blocks == 1);
+  CHECK(allocator.stats().peakBlocks == 1);
+
+  allocator.deallocate(b);
+  CHECK(allocator.stats().deallocations == 1);
+  CHECK(allocator.stats().blocks == 0);
+}
+
+TEST_CASE("InstrumentedAllocator: swap() exchanges the counters") {
+  InstrumentedAllocator a, b;
+  void* p = a.allocate(10);
+  swap(a, b);
+  CHECK(a.stats().blocks == 0);
+  CHECK(b.stats().blocks == 1);
+  b.deallocate(p);
+  CHECK(b.stats().blocks == 0);
+}
+
+TEST_CASE("JsonDocument::allocationProfile() counts by origin") {
+  InstrumentedAllocator heap;
+  {
+    JsonDocument doc(&heap);
+    CHECK(total(doc.allocationProfile()).blocks == 0);
+
+    CHECK(deserializeJson(doc, "{\"hello\":\"world\",\"list\":[1,2,3]}") ==
+          DeserializationError::Ok);
+    AllocationProfile profile = doc.allocationProfile();
+    CHECK(profile.pools.blocks > 0);
+    CHECK(profile.strings.blocks == 3);        // the keys and "world"
+    CHECK(profile.stringBuilder.blocks == 0);  // moved to the strings
+    CHECK(profile.stringBuilder.allocations > 0);
+    CHECK(profile.indexes.blocks == 0);
+    CHECK(profile.packedArrays.blocks == 0);
+
+    // the profile accounts for all the memory, besides the headers
+    AllocationStats sum = total(profile);
+    CHECK(heap.stats().blocks == sum.blocks);
+    CHECK(heap.stats().bytes == sum.bytes + sum.blocks * headerSize);
+
+    // the key is a literal, so only the value is copied
+    doc["extra"] = std::string("a copied string");
+    CHECK(doc.allocationProfile().strings.blocks == 4);
+
+    doc.clear();
+    profile = doc.allocationProfile();
+    CHECK(profile.strings.blocks == 0);
+    CHECK(profile.pools.blocks == 0);
+    CHECK(profile.strings.deallocations == 4);
+  }
+  CHECK(heap.stats().blocks == 0);
+}
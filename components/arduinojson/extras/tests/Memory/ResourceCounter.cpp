@@ -0,0 +1,55 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+#include <vector>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+using namespace ArduinoJson::detail;
+
+namespace {
+
+// Returns the string bytes that ExactSize would reserve for these strings
+size_t countStringBytes(const std::vector<std::string>& strings,
+                        Allocator* allocator) {
+  ResourceCounter counter(allocator);
+  for (const std::string& str : strings) {
+    StringCounter s(allocator);
+    s.startString();
+    s.append(str.c_str(), str.size());
+    counter.buildString(s);
+    counter.saveString(s);
+  }
+  return counter.stringBytes();
+}
+
+}  // namespace
+
+TEST_CASE("ResourceCounter: strings with the same hash are counted twice") {
+  InstrumentedAllocator allocator;
+  // these pairs collide with the 32-bit FNV-1a
+  CHECK(countStringBytes({"declinate", "macallums"}, &allocator) ==
+        countStringBytes({"declinate", "different"}, &allocator));
+  CHECK(countStringBytes({"altarage", "zinke"}, &allocator) ==
+        countStringBytes({"altarage", "other"}, &allocator));
+  CHECK(countStringBytes({"declinate", "declinate"}, &allocator) <
+        countStringBytes({"declinate", "macallums"}, &allocator));
+  CHECK(allocator.stats().blocks == 0);
+}
+
+TEST_CASE("ResourceCounter: duplicates are found among many strings") {
+  InstrumentedAllocator allocator;
+  std::vector<std::string> once, twice;
+  for (int i = 0; i < 1000; i++)
+    once.push_back("string" + std::to_string(i));
+  for (int i = 0; i < 2000; i++)
+    twice.push_back("string" + std::to_string(i % 1000));
+  CHECK(countStringBytes(twice, &allocator) ==
+        countStringBytes(once, &allocator));
+  CHECK(allocator.stats().blocks == 0);
+}
@@ -0,0 +1,192 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Checks that the doubles parsed by parseNumber() are bit-for-bit identical to
+// the ones of strtod(), which rounds correctly.
+
+#define ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING 1
+#include <ArduinoJson.h>
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Random.hpp"
+#include "Test.hpp"
+
+using namespace ArduinoJson::detail;
+
+namespace {
+
+uint64_t bitsOf(double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double doubleFromBits(uint64_t bits) {
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void checkParse(const char* input) {
+  double expected = strtod(input, nullptr);
+  double actual = parseNumber<double>(input);
+  if (bitsOf(actual) != bitsOf(expected))
+    printf("parseNumber(\"%s\") = %.17g, strtod() = %.17g\n", input, actual,
+           expected);
+  CHECK(bitsOf(actual) == bitsOf(expected));
+}
+
+// Prints the value with 1 to 17 significant digits, and checks each string
+void checkAllPrecisions(double value) {
+  char buffer[64];
+  for (int precision = 1; precision <= 17; precision++) {
+    snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+    checkParse(buffer);
+  }
+}
+
+#if LDBL_MANT_DIG > DBL_MANT_DIG
+// Checks the exact halfway point between value and the next double away from
+// zero, and the numbers just above and just below it.
+// They only differ from the rounding boundary after hundreds of digits, so
+// the significand is always truncated.
+void checkHalfway(double value) {
+  double next = nextafter(value, value < 0 ? -HUGE_VAL : HUGE_VAL);
+  if (isinf(next))
+    return;
+  // a long double has room for one more bit, so the midpoint is exact
+  long double halfway = (static_cast<long double>(value) + next) / 2;
+
+  // glibc prints all the digits of the binary value; 800 digits are enough
+  // for the smallest subnormals
+  char buffer[1024];
+  snprintf(buffer, sizeof(buffer), "%.800Le", halfway);
+  char* exponent = strchr(buffer, 'e');
+  if (!exponent)
+    return;
+  char suffix[16];
+  strcpy(suffix, exponent);
+
+  // exactly halfway: rounds to the even one
+  checkParse(buffer);
+
+  // just above: a trailing 1 after the trailing zeros
+  strcpy(exponent, "1");
+  strcat(exponent, suffix);
+  checkParse(buffer);
+
+  // just below: the exact digits, truncated
+  snprintf(buffer, sizeof(buffer), "%.800Le", halfway);
+  exponent = strchr(buffer, 'e');
+  for (char* p = exponent - 1; *p != '.'; p--) {
+    if (*p != '0') {
+      strcpy(p + 1, suffix);
+      (*p)--;
+      break;
+    }
+  }
+  checkParse(buffer);
+}
+#endif
+
+}  // namespace
+
+TEST_CASE("parseNumber<double>(): random bit patterns") {
+  Random random(1);
+  for (int i = 0; i < 100000; i++) {
+    double value = doubleFromBits(random.next());
+    if (isnan(value) || isinf(value) || value == 0)
+      continue;
+    checkAllPrecisions(value);
+  }
+}
+
+TEST_CASE("parseNumber<double>(): random subnormals") {
+  Random random(2);
+  for (int i = 0; i < 20000; i++) {
+    // zero exponent, random mantissa and sign
+    uint64_t bits = random.next() & 0x800FFFFFFFFFFFFF;
+    double value = doubleFromBits(bits);
+    if (value == 0)
+      continue;
+    checkAllPrecisions(value);
+  }
+}
+
+TEST_CASE("parseNumber<double>(): every power of two and ten") {
+  char buffer[64];
+  for (int exponent = -1074; exponent <= 1023; exponent++)
+    checkAllPrecisions(ldexp(1.0, exponent));
+  for (int exponent = -350; exponent <= 350; exponent++) {
+    snprintf(buffer, sizeof(buffer), "1e%d", exponent);
+    checkParse(buffer);
+    snprintf(buffer, sizeof(buffer), "9.9999999999999999999e%d", exponent);
+    checkParse(buffer);
+  }
+}
+
+TEST_CASE("parseNumber<double>(): huge exponents") {
+  checkParse("1e2345678901");
+  checkParse("-1e2345678901");
+  checkParse("1e-2345678901");
+  checkParse("1e99999999999999999999");
+  checkParse("1e-99999999999999999999");
+  checkParse("123456789012345678901234567890e-2147483648");
+  checkParse("0.000000000000000000000000000001e2147483647");
+  checkParse("1e0000000000000000000000000001");  // leading zeros
+  checkParse("0e400");
+  checkParse("0e-400");
+  checkParse("0.0e2345678901");
+}
+
+TEST_CASE("parseNumber<double>(): boundaries") {
+  checkAllPrecisions(DBL_MAX);
+  checkAllPrecisions(DBL_MIN);
+  checkAllPrecisions(DBL_EPSILON);
+  checkAllPrecisions(nextafter(DBL_MIN, 0));   // largest subnormal
+  checkAllPrecisions(doubleFromBits(1));       // smallest subnormal
+  checkAllPrecisions(9007199254740993.0 - 1);  // 2^53 + 1 isn't a double
+  checkParse("1.7976931348623158e308");        // rounds down to DBL_MAX
+  checkParse("1.7976931348623159e308");        // rounds up to infinity
+  checkParse("2.4703282292062327e-324");       // rounds down to zero
+  checkParse("2.4703282292062328e-324");       // rounds up to the smallest
+  checkParse("9007199254740993");              // integer, halfway
+  checkParse("9007199254740993.0");            // same, parsed as a float
+  checkParse("9007199254740993.00000000000000000000000001");
+  checkParse("18446744073709551615");  // UINT64_MAX
+  checkParse("18446744073709551616");  // UINT64_MAX + 1
+  checkParse("-9223372036854775808");  // INT64_MIN
+  checkParse("-9223372036854775809");
+  checkParse("1e400");
+  checkParse("-1e400");
+  checkParse("1e-400");
+  checkParse("0.000000000000000000000000000000000000000000001e-280");
+  checkParse("100000000000000000000000000000000000000000000e280");
+  checkParse("7.2057594037927933e16");
+  checkParse("3.0540316673332524e-308");  // fast path limits
+  checkParse("2.2250738585072011e-308");  // below DBL_MIN
+}
+
+#if LDBL_MANT_DIG > DBL_MANT_DIG
+TEST_CASE("parseNumber<double>(): long digit strings near halfway points") {
+  Random random(3);
+  for (int i = 0; i < 5000; i++) {
+    double value = doubleFromBits(random.next());
+    if (isnan(value) || isinf(value) || value == 0)
+      continue;
+    checkHalfway(value);
+  }
+  for (int i = 0; i < 1000; i++)
+    checkHalfway(doubleFromBits(random.next() & 0x800FFFFFFFFFFFFF));
+  for (int exponent = -1074; exponent <= 1023; exponent += 7)
+    checkHalfway(ldexp(1.0, exponent));
+  checkHalfway(DBL_MIN);
+  checkHalfway(doubleFromBits(1));
+}
+#endif
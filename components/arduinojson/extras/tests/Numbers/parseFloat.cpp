@@ -0,0 +1,140 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Checks that the floats parsed by parseNumber() are bit-for-bit identical to
+// the ones of strtof(), which rounds correctly.
+
+#define ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING 1
+#define ARDUINOJSON_USE_DOUBLE 0
+#include <ArduinoJson.h>
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Random.hpp"
+#include "Test.hpp"
+
+using namespace ArduinoJson::detail;
+
+namespace {
+
+uint32_t bitsOf(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+float floatFromBits(uint32_t bits) {
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void checkParse(const char* input) {
+  float expected = strtof(input, nullptr);
+  float actual = parseNumber<float>(input);
+  if (bitsOf(actual) != bitsOf(expected))
+    printf("parseNumber(\"%s\") = %.9g, strtof() = %.9g\n", input,
+           double(actual), double(expected));
+  CHECK(bitsOf(actual) == bitsOf(expected));
+}
+
+void checkAllPrecisions(float value) {
+  char buffer[64];
+  for (int precision = 1; precision <= 9; precision++) {
+    snprintf(buffer, sizeof(buffer), "%.*g", precision, double(value));
+    checkParse(buffer);
+  }
+}
+
+// Same as in parseDouble.cpp, with a double to hold the midpoint
+void checkHalfway(float value) {
+  float next = nextafterf(value, value < 0 ? -HUGE_VALF : HUGE_VALF);
+  if (isinf(next))
+    return;
+  double halfway = (double(value) + double(next)) / 2;
+
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer), "%.200e", halfway);
+  char* exponent = strchr(buffer, 'e');
+  if (!exponent)
+    return;
+  char suffix[16];
+  strcpy(suffix, exponent);
+
+  checkParse(buffer);
+
+  strcpy(exponent, "1");
+  strcat(exponent, suffix);
+  checkParse(buffer);
+
+  snprintf(buffer, sizeof(buffer), "%.200e", halfway);
+  exponent = strchr(buffer, 'e');
+  for (char* p = exponent - 1; *p != '.'; p--) {
+    if (*p != '0') {
+      strcpy(p + 1, suffix);
+      (*p)--;
+      break;
+    }
+  }
+  checkParse(buffer);
+}
+
+}  // namespace
+
+TEST_CASE("parseNumber<float>(): random bit patterns") {
+  Random random(4);
+  for (int i = 0; i < 100000; i++) {
+    float value = floatFromBits(uint32_t(random.next() >> 32));
+    if (isnan(value) || isinf(value) || value == 0)
+      continue;
+    checkAllPrecisions(value);
+  }
+}
+
+TEST_CASE("parseNumber<float>(): long digit strings near halfway points") {
+  Random random(5);
+  for (int i = 0; i < 20000; i++) {
+    float value = floatFromBits(uint32_t(random.next() >> 32));
+    if (isnan(value) || isinf(value) || value == 0)
+      continue;
+    checkHalfway(value);
+  }
+  for (int i = 0; i < 2000; i++)
+    checkHalfway(floatFromBits(uint32_t(random.next() >> 32) & 0x807FFFFF));
+  for (int exponent = -149; exponent <= 127; exponent++)
+    checkHalfway(ldexpf(1.0f, exponent));
+}
+
+TEST_CASE("parseNumber<float>(): huge exponents") {
+  checkParse("1e2345678901");
+  checkParse("-1e2345678901");
+  checkParse("1e-2345678901");
+  checkParse("1e99999999999999999999");
+  checkParse("1e-99999999999999999999");
+  checkParse("123456789012345678901234567890e-2147483648");
+  checkParse("0.000000000000000000000000000001e2147483647");
+  checkParse("1e0000000000000000000000000001");  // leading zeros
+  checkParse("0e400");
+  checkParse("0e-400");
+  checkParse("0.0e2345678901");
+}
+
+TEST_CASE("parseNumber<float>(): boundaries") {
+  checkAllPrecisions(FLT_MAX);
+  checkAllPrecisions(FLT_MIN);
+  checkAllPrecisions(floatFromBits(1));
+  checkParse("3.4028235e38");
+  checkParse("3.4028236e38");
+  checkParse("3.40282357e38");  // halfway to the next power of two
+  checkParse("7.0064923e-46");  // half of the smallest subnormal
+  checkParse("7.0064924e-46");
+  checkParse("16777217");  // integer, halfway
+  checkParse("16777217.0");
+  checkParse("1e39");
+  checkParse("1e-46");
+}
@@ -0,0 +1,64 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+// Checks the results of parseNumber() that don't depend on the precision, with
+// the default parser, which multiplies by the binary powers of ten instead of
+// rounding correctly.
+
+#include <ArduinoJson.h>
+
+#include <math.h>
+#include <string>
+
+#include "Test.hpp"
+
+using namespace ArduinoJson;
+using namespace ArduinoJson::detail;
+
+static_assert(!ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING,
+              "this test checks the default parser");
+
+namespace {
+
+bool isPositiveZero(double value) {
+  return value == 0 && !signbit(value);
+}
+
+bool isNegativeZero(double value) {
+  return value == 0 && signbit(value);
+}
+
+}  // namespace
+
+TEST_CASE("parseNumber(): huge exponents") {
+  CHECK(isinf(parseNumber<double>("1e2345678901")));
+  CHECK(parseNumber<double>("-1e2345678901") < 0);
+  CHECK(isinf(parseNumber<double>("-1e2345678901")));
+  CHECK(isPositiveZero(parseNumber<double>("1e-2345678901")));
+  CHECK(isNegativeZero(parseNumber<double>("-1e-2345678901")));
+  CHECK(isinf(parseNumber<double>("1e99999999999999999999")));
+  CHECK(isPositiveZero(parseNumber<double>("1e-99999999999999999999")));
+  CHECK(isPositiveZero(
+      parseNumber<double>("123456789012345678901234567890e-2147483648")));
+  CHECK(isinf(
+      parseNumber<double>("0.000000000000000000000000000001e2147483647")));
+  CHECK(parseNumber<double>("1e0000000000000000000000000001") == 10);
+}
+
+TEST_CASE("parseNumber(): zero with any exponent") {
+  CHECK(isPositiveZero(parseNumber<double>("0e400")));
+  CHECK(isPositiveZero(parseNumber<double>("0e-400")));
+  CHECK(isPositiveZero(parseNumber<double>("0.0e2345678901")));
+  CHECK(isPositiveZero(parseNumber<double>(".e400")));
+  CHECK(isNegativeZero(parseNumber<double>("-0e400")));
+}
+
+TEST_CASE("deserializeJson(): huge exponents") {
+  JsonDocument doc;
+  CHECK(deserializeJson(doc, "[1e2345678901,1e-2345678901,0e400]") ==
+        DeserializationError::Ok);
+  std::string json;
+  serializeJson(doc, json);
+  CHECK(json == "[null,0,0]");  // infinity is serialized as null
+}
@@ -31,6 +31,10 @@
 #include "ArduinoJson/Variant/JsonVariantConst.hpp"
 
 #include "ArduinoJson/Document/JsonDocument.hpp"
+#include "ArduinoJson/Document/PolicyJsonDocument.hpp"
+#include "ArduinoJson/Memory/ArenaAllocator.hpp"
+#include "ArduinoJson/Memory/InstrumentedAllocator.hpp"
+#include "ArduinoJson/Memory/SymbolTable.hpp"
 
 #include "ArduinoJson/Array/ArrayImpl.hpp"
 #include "ArduinoJson/Array/ElementProxy.hpp"
@@ -45,7 +49,10 @@
 #include "ArduinoJson/Variant/VariantRefBaseImpl.hpp"
 
 #include "ArduinoJson/Json/JsonDeserializer.hpp"
+#include "ArduinoJson/Json/JsonEventParser.hpp"
+#include "ArduinoJson/Json/JsonPathExtractor.hpp"
 #include "ArduinoJson/Json/JsonSerializer.hpp"
+#include "ArduinoJson/Json/JsonStreamDeserializer.hpp"
 #include "ArduinoJson/Json/PrettyJsonSerializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackDeserializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackSerializer.hpp"
@@ -11,7 +11,10 @@ ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 class ArrayData : public CollectionData {
  public:
   VariantData* addElement(ResourceManager* resources) {
-    return addSlot(resources).data();
+    auto it = addSlot(resources);
+    if (!it.done())
+      indexElement(it, resources);
+    return it.data();
   }
 
   static VariantData* addElement(ArrayData* array, ResourceManager* resources) {
@@ -52,6 +55,13 @@ class ArrayData : public CollectionData {
 
  private:
   iterator at(size_t index, const ResourceManager* resources) const;
+
+  // Adds a new element to the index of the array, if it has one
+  void indexElement(iterator it, ResourceManager* resources);
+
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  ArrayIndex* buildIndex(const ResourceManager* resources) const;
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
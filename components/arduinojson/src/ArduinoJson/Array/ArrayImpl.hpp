@@ -0,0 +1,92 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Array/ArrayData.hpp>
+#include <ArduinoJson/Variant/VariantCompare.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+inline ArrayData::iterator ArrayData::at(
+    size_t index, const ResourceManager* resources) const {
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  auto elements = resources->getArrayIndex(head());
+  if (!elements && index >= ArrayIndex::minElements)
+    elements = buildIndex(resources);
+  if (elements) {
+    if (index >= elements->count)
+      return iterator();
+    auto id = elements->elements[index];
+    auto prevId = index ? elements->elements[index - 1] : NULL_SLOT;
+    return iterator(resources->getSlot(id), id, prevId);
+  }
+#endif
+  auto it = createIterator(resources);
+  while (!it.done() && index) {
+    it.next(resources);
+    --index;
+  }
+  return it;
+}
+
+inline VariantData* ArrayData::getOrAddElement(size_t index,
+                                               ResourceManager* resources) {
+  auto it = at(index, resources);
+  if (!it.done())
+    return it.data();
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  auto elements = resources->getArrayIndex(head());
+  size_t n = elements ? elements->count : size(resources);
+#else
+  size_t n = size(resources);
+#endif
+  VariantData* element = nullptr;
+  for (; n <= index; n++) {
+    element = addElement(resources);
+    if (!element)
+      return nullptr;
+  }
+  return element;
+}
+
+inline VariantData* ArrayData::getElement(
+    size_t index, const ResourceManager* resources) const {
+  return at(index, resources).data();
+}
+
+inline void ArrayData::removeElement(size_t index, ResourceManager* resources) {
+  remove(at(index, resources), resources);
+}
+
+inline void ArrayData::indexElement(iterator it, ResourceManager* resources) {
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  auto elements = resources->getArrayIndex(head());
+  if (elements && elements->full())
+    elements = resources->growArrayIndex(elements);
+  if (elements)
+    elements->add(it.currentId_);
+#else
+  (void)it;
+  (void)resources;
+#endif
+}
+
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+// Returns null if the array is small or if the allocation failed
+inline ArrayIndex* ArrayData::buildIndex(
+    const ResourceManager* resources) const {
+  size_t count = size(resources);
+  if (count < ArrayIndex::minElements)
+    return nullptr;  // not worth it
+  auto elements = resources->createArrayIndex(head(), count);
+  if (!elements)
+    return nullptr;
+  for (auto it = createIterator(resources); !it.done(); it.next(resources))
+    elements->add(it.currentId_);
+  return elements;
+}
+#endif
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
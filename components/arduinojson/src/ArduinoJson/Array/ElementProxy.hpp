@@ -14,6 +14,7 @@ template <typename TUpstream>
 class ElementProxy : public VariantRefBase<ElementProxy<TUpstream>>,
                      public VariantOperators<ElementProxy<TUpstream>> {
   friend class VariantAttorney;
+  friend class VariantRefBase<ElementProxy<TUpstream>>;
 
  public:
   ElementProxy(TUpstream upstream, size_t index)
@@ -44,8 +45,26 @@ class ElementProxy : public VariantRefBase<ElementProxy<TUpstream>>,
     return VariantAttorney::getResourceManager(upstream_);
   }
 
+  // Reads a packed array in place: the element is copied in the proxy, so
+  // the returned pointer is only valid for the lifetime of the proxy, and
+  // the value must not be modified through it (see getWritableData()).
   FORCE_INLINE VariantData* getData() const {
     return VariantData::getElement(
+        VariantAttorney::getData(upstream_), index_,
+        VariantAttorney::getResourceManager(upstream_), packedElement());
+  }
+
+  // Hides VariantRefBase::getWritableData() to unpack a packed array
+  VariantData* getWritableData() const {
+    return VariantData::getUnpackedElement(
+        VariantAttorney::getData(upstream_), index_,
+        VariantAttorney::getResourceManager(upstream_));
+  }
+
+  // Hides VariantRefBase::getVariantConst(), so that the copy of the element
+  // of a packed array lives in the JsonVariantConst, not in the proxy
+  FORCE_INLINE ArduinoJson::JsonVariantConst getVariantConst() const {
+    return ArduinoJson::JsonVariantConst(
         VariantAttorney::getData(upstream_), index_,
         VariantAttorney::getResourceManager(upstream_));
   }
@@ -58,8 +77,19 @@ class ElementProxy : public VariantRefBase<ElementProxy<TUpstream>>,
         index_, VariantAttorney::getResourceManager(upstream_));
   }
 
+  VariantData* packedElement() const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    return &element_;
+#else
+    return nullptr;
+#endif
+  }
+
   TUpstream upstream_;
   size_t index_;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  mutable VariantData element_;  // a copy of an element of a packed array
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
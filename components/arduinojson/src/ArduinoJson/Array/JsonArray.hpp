@@ -114,6 +114,17 @@ class JsonArray : public detail::VariantOperators<JsonArray> {
     detail::ArrayData::removeElement(data_, index, resources_);
   }
 
+  // Removes the elements for which predicate(JsonVariant) returns true.
+  // Unlike a loop of remove(), it unlinks each element in constant time.
+  // Returns the number of elements removed.
+  template <typename TPredicate>
+  size_t removeIf(TPredicate predicate) const {
+    if (!data_)
+      return 0;
+    return data_->removeIf(ElementPredicate<TPredicate>{predicate, resources_},
+                           resources_);
+  }
+
   // Removes all the elements of the array.
   // https://arduinojson.org/v7/api/jsonarray/clear/
   void clear() const {
@@ -177,6 +188,16 @@ class JsonArray : public detail::VariantOperators<JsonArray> {
   }
 
  private:
+  template <typename TPredicate>
+  struct ElementPredicate {
+    TPredicate predicate;
+    detail::ResourceManager* resources;
+
+    bool operator()(detail::ArrayData::iterator& it) {
+      return predicate(JsonVariant(it.data(), resources));
+    }
+  };
+
   detail::ResourceManager* getResourceManager() const {
     return resources_;
   }
@@ -24,6 +24,10 @@ class JsonArrayConst : public detail::VariantOperators<JsonArrayConst> {
   // Returns an iterator to the first element of the array.
   // https://arduinojson.org/v7/api/jsonarrayconst/begin/
   iterator begin() const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (packed_)
+      return iterator(packed_, resources_);
+#endif
     if (!data_)
       return iterator();
     return iterator(data_->createIterator(resources_), resources_);
@@ -43,11 +47,18 @@ class JsonArrayConst : public detail::VariantOperators<JsonArrayConst> {
                  const detail::ResourceManager* resources)
       : data_(data), resources_(resources) {}
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // INTERNAL USE ONLY
+  // Reads a packed array in place, without unpacking it
+  JsonArrayConst(const detail::VariantData* packed,
+                 const detail::ResourceManager* resources)
+      : data_(0), packed_(packed), resources_(resources) {}
+#endif
+
   // Returns the element at the specified index.
   // https://arduinojson.org/v7/api/jsonarrayconst/subscript/
   JsonVariantConst operator[](size_t index) const {
-    return JsonVariantConst(
-        detail::ArrayData::getElement(data_, index, resources_), resources_);
+    return JsonVariantConst(getData(), index, resources_);
   }
 
   operator JsonVariantConst() const {
@@ -57,13 +68,13 @@ class JsonArrayConst : public detail::VariantOperators<JsonArrayConst> {
   // Returns true if the reference is unbound.
   // https://arduinojson.org/v7/api/jsonarrayconst/isnull/
   bool isNull() const {
-    return data_ == 0;
+    return getData() == 0;
   }
 
   // Returns true if the reference is bound.
   // https://arduinojson.org/v7/api/jsonarrayconst/isnull/
   operator bool() const {
-    return data_ != 0;
+    return getData() != 0;
   }
 
   // Returns the depth (nesting level) of the array.
@@ -75,7 +86,7 @@ class JsonArrayConst : public detail::VariantOperators<JsonArrayConst> {
   // Returns the number of elements in the array.
   // https://arduinojson.org/v7/api/jsonarrayconst/size/
   size_t size() const {
-    return data_ ? data_->size(resources_) : 0;
+    return detail::VariantData::size(getData(), resources_);
   }
 
   // DEPRECATED: always returns zero
@@ -86,10 +97,17 @@ class JsonArrayConst : public detail::VariantOperators<JsonArrayConst> {
 
  private:
   const detail::VariantData* getData() const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (packed_)
+      return packed_;
+#endif
     return collectionToVariant(data_);
   }
 
   const detail::ArrayData* data_;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  const detail::VariantData* packed_ = nullptr;
+#endif
   const detail::ResourceManager* resources_;
 };
 
@@ -68,7 +68,22 @@ class JsonArrayConstIterator {
                                   const detail::ResourceManager* resources)
       : iterator_(iterator), resources_(resources) {}
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // INTERNAL USE ONLY
+  // Iterates over the elements of a packed array, which aren't in slots
+  explicit JsonArrayConstIterator(const detail::VariantData* packed,
+                                  const detail::ResourceManager* resources)
+      : resources_(resources) {
+    if (packed->size(resources))
+      packed_ = packed;
+  }
+#endif
+
   JsonVariantConst operator*() const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (packed_)
+      return JsonVariantConst(packed_, index_, resources_);
+#endif
     return JsonVariantConst(iterator_.data(), resources_);
   }
   Ptr<JsonVariantConst> operator->() {
@@ -76,14 +91,27 @@ class JsonArrayConstIterator {
   }
 
   bool operator==(const JsonArrayConstIterator& other) const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (packed_ != other.packed_ || index_ != other.index_)
+      return false;
+#endif
     return iterator_ == other.iterator_;
   }
 
   bool operator!=(const JsonArrayConstIterator& other) const {
-    return iterator_ != other.iterator_;
+    return !operator==(other);
   }
 
   JsonArrayConstIterator& operator++() {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (packed_) {
+      if (++index_ >= packed_->size(resources_)) {
+        packed_ = nullptr;  // equals end()
+        index_ = 0;
+      }
+      return *this;
+    }
+#endif
     iterator_.next(resources_);
     return *this;
   }
@@ -91,6 +119,10 @@ class JsonArrayConstIterator {
  private:
   detail::ArrayData::iterator iterator_;
   const detail::ResourceManager* resources_;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  const detail::VariantData* packed_ = nullptr;
+  size_t index_ = 0;
+#endif
 };
 
 ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -15,10 +15,13 @@ class VariantData;
 class VariantSlot;
 
 class CollectionIterator {
+  friend class ArrayData;
   friend class CollectionData;
+  friend class ObjectData;
 
  public:
-  CollectionIterator() : slot_(nullptr), currentId_(NULL_SLOT) {}
+  CollectionIterator()
+      : slot_(nullptr), currentId_(NULL_SLOT), prevId_(NULL_SLOT) {}
 
   void next(const ResourceManager* resources);
 
@@ -64,15 +67,20 @@ class CollectionIterator {
   }
 
  private:
-  CollectionIterator(VariantSlot* slot, SlotId slotId);
+  CollectionIterator(VariantSlot* slot, SlotId slotId,
+                     SlotId prevId = NULL_SLOT);
 
   VariantSlot* slot_;
   SlotId currentId_, nextId_;
+  SlotId prevId_;  // a hint for CollectionData::remove(), see getPreviousSlot()
 };
 
 class CollectionData {
   SlotId head_ = NULL_SLOT;
   SlotId tail_ = NULL_SLOT;
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  SlotId size_ = 0;  // a collection can't have more slots than ids
+#endif
 
  public:
   // Placement new
@@ -101,6 +109,11 @@ class CollectionData {
 
   void remove(iterator it, ResourceManager* resources);
 
+  // Removes the slots for which predicate(it) returns true, in a single pass.
+  // Returns the number of slots removed.
+  template <typename TPredicate>
+  size_t removeIf(TPredicate predicate, ResourceManager* resources);
+
   static void remove(CollectionData* collection, iterator it,
                      ResourceManager* resources) {
     if (collection)
@@ -115,7 +128,8 @@ class CollectionData {
   iterator addSlot(ResourceManager*);
 
  private:
-  SlotWithId getPreviousSlot(VariantSlot*, const ResourceManager*) const;
+  SlotWithId getPreviousSlot(const iterator&, const ResourceManager*) const;
+  void unlink(SlotWithId prev, iterator it, ResourceManager*);
   void releaseSlot(SlotWithId, ResourceManager*);
 };
 
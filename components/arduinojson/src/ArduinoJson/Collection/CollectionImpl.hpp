@@ -12,8 +12,9 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
-inline CollectionIterator::CollectionIterator(VariantSlot* slot, SlotId slotId)
-    : slot_(slot), currentId_(slotId) {
+inline CollectionIterator::CollectionIterator(VariantSlot* slot, SlotId slotId,
+                                              SlotId prevId)
+    : slot_(slot), currentId_(slotId), prevId_(prevId) {
   nextId_ = slot_ ? slot_->next() : NULL_SLOT;
 }
 
@@ -41,6 +42,7 @@ inline bool CollectionIterator::ownsKey() const {
 
 inline void CollectionIterator::next(const ResourceManager* resources) {
   ARDUINOJSON_ASSERT(currentId_ != NULL_SLOT);
+  prevId_ = currentId_;
   slot_ = resources->getSlot(nextId_);
   currentId_ = nextId_;
   if (slot_)
@@ -60,6 +62,9 @@ inline CollectionData::iterator CollectionData::addSlot(
     head_ = slot.id();
     tail_ = slot.id();
   }
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  size_++;
+#endif
   return iterator(slot, slot.id());
 }
 
@@ -74,16 +79,32 @@ inline void CollectionData::clear(ResourceManager* resources) {
 
   head_ = NULL_SLOT;
   tail_ = NULL_SLOT;
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  size_ = 0;
+#endif
 }
 
+// Returns the slot before the iterator, or null if it's the first one.
+// It's immediate if the iterator comes from a traversal, as it remembers the
+// previous slot; otherwise, or if that slot was removed since, it walks the
+// collection from the beginning.
 inline SlotWithId CollectionData::getPreviousSlot(
-    VariantSlot* target, const ResourceManager* resources) const {
+    const iterator& it, const ResourceManager* resources) const {
+  if (it.prevId_ == NULL_SLOT) {
+    if (head_ == it.currentId_)
+      return SlotWithId();
+  } else {
+    auto prevSlot = resources->getSlot(it.prevId_);
+    if (prevSlot->next() == it.currentId_)
+      return SlotWithId(prevSlot, it.prevId_);
+  }
+
   auto prev = SlotWithId();
   auto currentId = head_;
   while (currentId != NULL_SLOT) {
-    auto currentSlot = resources->getSlot(currentId);
-    if (currentSlot == target)
+    if (currentId == it.currentId_)
       return prev;
+    auto currentSlot = resources->getSlot(currentId);
     prev = SlotWithId(currentSlot, currentId);
     currentId = currentSlot->next();
   }
@@ -93,15 +114,58 @@ inline SlotWithId CollectionData::getPreviousSlot(
 inline void CollectionData::remove(iterator it, ResourceManager* resources) {
   if (it.done())
     return;
+  unlink(getPreviousSlot(it, resources), it, resources);
+}
+
+template <typename TPredicate>
+inline size_t CollectionData::removeIf(TPredicate predicate,
+                                       ResourceManager* resources) {
+  size_t removed = 0;
+  auto prev = SlotWithId();
+  for (auto it = createIterator(resources); !it.done(); it.next(resources)) {
+    if (predicate(it)) {
+      unlink(prev, it, resources);  // it.next() doesn't read the slot
+      removed++;
+    } else {
+      prev = SlotWithId(it.slot_, it.currentId_);
+    }
+  }
+  return removed;
+}
+
+// Removes the slot of the iterator, which follows prev
+inline void CollectionData::unlink(SlotWithId prev, iterator it,
+                                   ResourceManager* resources) {
   auto curr = it.slot_;
-  auto prev = getPreviousSlot(curr, resources);
   auto next = curr->next();
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  auto index = resources->getObjectIndex(head_);
+  if (index) {
+    index->remove(ObjectIndex::hash(adaptString(curr->key())), it.currentId_);
+    if (!index->count)
+      resources->destroyObjectIndex(index);
+    else if (!prev)  // the index follows the first member
+      index->head = next;
+  }
+#endif
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  auto elements = resources->getArrayIndex(head_);
+  if (elements) {
+    if (next == NULL_SLOT && elements->count > 1)
+      elements->count--;  // the last element
+    else
+      resources->destroyArrayIndex(elements);  // the positions changed
+  }
+#endif
   if (prev)
     prev->setNext(next);
   else
     head_ = next;
   if (next == NULL_SLOT)
     tail_ = prev.id();
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  size_--;
+#endif
   releaseSlot({it.slot_, it.currentId_}, resources);
 }
 
@@ -116,10 +180,15 @@ inline size_t CollectionData::nesting(const ResourceManager* resources) const {
 }
 
 inline size_t CollectionData::size(const ResourceManager* resources) const {
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  (void)resources;
+  return size_;
+#else
   size_t count = 0;
   for (auto it = createIterator(resources); !it.done(); it.next(resources))
     count++;
   return count;
+#endif
 }
 
 inline void CollectionData::releaseSlot(SlotWithId slot,
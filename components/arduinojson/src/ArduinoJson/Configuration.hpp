@@ -117,6 +117,15 @@
 #  define ARDUINOJSON_INITIAL_POOL_COUNT 4
 #endif
 
+// Allocate the variant pools in blocks that double the capacity each time,
+// instead of one pool at a time.
+// Disabled by default because the unused part of the last block stays
+// allocated until shrinkToFit(), which ARDUINOJSON_AUTO_SHRINK doesn't call on
+// 8-bit platforms.
+#ifndef ARDUINOJSON_GEOMETRIC_POOL_GROWTH
+#  define ARDUINOJSON_GEOMETRIC_POOL_GROWTH 0
+#endif
+
 // Automatically call shrinkToFit() from deserializeXxx()
 // Disabled by default on 8-bit platforms because it's not worth the increase in
 // code size
@@ -231,6 +240,13 @@
 #  define ARDUINOJSON_NEGATIVE_EXPONENTIATION_THRESHOLD 1e-5
 #endif
 
+// Round the parsed floating-point values correctly (Eisel-Lemire algorithm)
+// Requires a 10 KB table, otherwise only short numbers are exact
+// Disabled by default because of the size of the table
+#ifndef ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+#  define ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING 0
+#endif
+
 #ifndef ARDUINOJSON_LITTLE_ENDIAN
 #  if defined(_MSC_VER) ||                           \
       (defined(__BYTE_ORDER__) &&                    \
@@ -242,6 +258,108 @@
 #  endif
 #endif
 
+// Use SSE2 or NEON instructions to scan strings when available
+#ifndef ARDUINOJSON_ENABLE_SIMD
+#  if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(__ARM_NEON) && defined(__aarch64__))
+#    define ARDUINOJSON_ENABLE_SIMD 1
+#  else
+#    define ARDUINOJSON_ENABLE_SIMD 0
+#  endif
+#endif
+
+// Parse contiguous inputs in two stages: index the structural characters
+// first, then build the document from the index. Faster on large inputs, but
+// needs up to four bytes of temporary memory per input byte.
+#ifndef ARDUINOJSON_ENABLE_STRUCTURAL_INDEX
+#  define ARDUINOJSON_ENABLE_STRUCTURAL_INDEX 0
+#endif
+
+// Maximum length of the keys and strings passed to the handler of
+// parseJsonEvents(); longer ones come in parts (see JsonEventHandler).
+// It's also the maximum length of the strings that extractJson() copies.
+#ifndef ARDUINOJSON_EVENT_STRING_SIZE
+#  define ARDUINOJSON_EVENT_STRING_SIZE 64
+#endif
+
+// Index the strings of a JsonDocument with a hash table, so that saving or
+// releasing a string doesn't compare it with all the others.
+// Costs two pointers and a hash per string, plus about two pointers per
+// string for the table once the document holds 16 strings or more.
+// Disabled by default because the typical documents hold few strings
+#ifndef ARDUINOJSON_ENABLE_STRING_INDEX
+#  define ARDUINOJSON_ENABLE_STRING_INDEX 0
+#endif
+
+// CAUTION: the collection indexes below are built lazily, by the first
+// lookup that needs them, even through a const reference. When one of them is
+// enabled, the reads of a document must not run concurrently.
+
+// Index the members of the large objects with a hash table, so that looking
+// up a key, or adding a member, doesn't compare it with all the other keys.
+// A table is built the first time a lookup walks 16 members or more; it costs
+// a hash and a slot id per entry, with a load factor under 75%, and it's freed
+// with the object. The small objects are unchanged.
+// Disabled by default because of the caution above, and because the objects
+// of the typical documents are small.
+#ifndef ARDUINOJSON_ENABLE_OBJECT_INDEX
+#  define ARDUINOJSON_ENABLE_OBJECT_INDEX 0
+#endif
+
+// Index the elements of the large arrays with a table of their slot ids, so
+// that accessing an element by its position doesn't walk the array.
+// A table is built the first time an element at position 16 or more is
+// accessed; it costs a slot id per element, plus the room to grow, and it's
+// freed with the array. The small arrays are unchanged.
+// Disabled by default because of the caution above, and because iterating
+// doesn't need it.
+#ifndef ARDUINOJSON_ENABLE_ARRAY_INDEX
+#  define ARDUINOJSON_ENABLE_ARRAY_INDEX 0
+#endif
+
+// Store the number of elements of each array and object, so that size()
+// doesn't walk them. The slots don't grow when the counter fits in the room
+// that the numbers leave in each variant, i.e., when three slot ids fit in a
+// float, a pointer, or a long long.
+// Disabled by default because every insertion and removal updates the
+// counter, while few programs call size() on large collections.
+#ifndef ARDUINOJSON_CACHE_COLLECTION_SIZE
+#  define ARDUINOJSON_CACHE_COLLECTION_SIZE 0
+#endif
+
+// Store the arrays of numbers that deserializeJson() produces contiguously,
+// with the smallest type that represents all the elements exactly (int16,
+// int32, float, or double), instead of one slot per element.
+// An array switches to this representation when its first 16 elements are
+// numbers of the same kind (integers or floating-point values). The reads,
+// the iteration of a JsonArrayConst, the serialization, and the copies keep
+// it packed, but it goes back to the slots when an element doesn't fit, or
+// when the array is modified or viewed as a JsonArray.
+// The JsonVariantConst and the element proxies grow by one variant, to hold a
+// copy of the element they read.
+#ifndef ARDUINOJSON_ENABLE_PACKED_ARRAYS
+#  define ARDUINOJSON_ENABLE_PACKED_ARRAYS 0
+#endif
+
+// Store the short string values in the variant itself, instead of allocating
+// a string. The limit is the size of a float or a pointer, minus one
+// (7 characters with ARDUINOJSON_USE_DOUBLE or ARDUINOJSON_USE_LONG_LONG).
+// The pointer returned by as<const char*>() is then inside the variant: it's
+// invalidated when the value changes, and when the document is moved, shrunk
+// (shrinkToFit() or ARDUINOJSON_AUTO_SHRINK), or compacted.
+// Disabled by default because the other strings survive shrinkToFit(), which
+// deserializeJson() calls when ARDUINOJSON_AUTO_SHRINK is enabled.
+#ifndef ARDUINOJSON_ENABLE_TINY_STRINGS
+#  define ARDUINOJSON_ENABLE_TINY_STRINGS 0
+#endif
+
+// Count the allocations of each JsonDocument by origin: the memory pools, the
+// strings, and the strings being deserialized.
+// See JsonDocument::allocationProfile(). Costs one size_t per allocated block.
+#ifndef ARDUINOJSON_ENABLE_ALLOCATION_STATS
+#  define ARDUINOJSON_ENABLE_ALLOCATION_STATS 0
+#endif
+
 #ifndef ARDUINOJSON_ENABLE_ALIGNMENT
 #  if defined(__AVR)
 #    define ARDUINOJSON_ENABLE_ALIGNMENT 0
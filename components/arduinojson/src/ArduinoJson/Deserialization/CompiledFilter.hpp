@@ -0,0 +1,294 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Filter.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Object/JsonObjectConst.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+#include <ArduinoJson/Variant/VariantAttorney.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+struct CompiledFilterKey;
+
+// A node of a CompiledFilter: the decisions of Filter for one value of the
+// filter document, and the nodes of its members and elements.
+struct CompiledFilterNode {
+  enum {
+    Allow = 1,
+    AllowArray = 2,
+    AllowObject = 4,
+    AllowValue = 8,
+  };
+
+  uint8_t flags;
+  const CompiledFilterNode* element;
+  const CompiledFilterNode* wildcard;  // for the keys not in the table
+  const CompiledFilterKey* keys;  // sorted with stringCompare()
+  size_t keyCount;
+
+  // The node of "false", null, and of the keys that match nothing
+  static const CompiledFilterNode* denyAll() {
+    static const CompiledFilterNode node = {0, &node, &node, nullptr, 0};
+    return &node;
+  }
+
+  // The node of "true", which allows everything recursively
+  static const CompiledFilterNode* allowAll() {
+    static const CompiledFilterNode node = {
+        Allow | AllowArray | AllowObject | AllowValue, &node, &node, nullptr,
+        0};
+    return &node;
+  }
+
+  template <typename TAdaptedString>
+  const CompiledFilterNode* find(TAdaptedString key) const;
+};
+
+struct CompiledFilterKey {
+  const char* str;
+  size_t size;
+  const CompiledFilterNode* node;
+};
+
+template <typename TAdaptedString>
+inline const CompiledFilterNode* CompiledFilterNode::find(
+    TAdaptedString key) const {
+  // binary search
+  size_t first = 0, last = keyCount;
+  while (first < last) {
+    size_t middle = first + (last - first) / 2;
+    int cmp =
+        stringCompare(SizedRamString(keys[middle].str, keys[middle].size), key);
+    if (cmp == 0)
+      return keys[middle].node;
+    if (cmp < 0)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  return wildcard;
+}
+
+// The TFilter of the deserializers when the filter is a CompiledFilter.
+// Looking up a key is a binary search instead of a linear search.
+class CompiledFilterRef {
+ public:
+  CompiledFilterRef(const CompiledFilterNode* node) : node_(node) {}
+
+  bool allow() const {
+    return (node_->flags & CompiledFilterNode::Allow) != 0;
+  }
+
+  bool allowArray() const {
+    return (node_->flags & CompiledFilterNode::AllowArray) != 0;
+  }
+
+  bool allowObject() const {
+    return (node_->flags & CompiledFilterNode::AllowObject) != 0;
+  }
+
+  bool allowValue() const {
+    return (node_->flags & CompiledFilterNode::AllowValue) != 0;
+  }
+
+  template <typename TKey>
+  typename enable_if<is_integral<TKey>::value, CompiledFilterRef>::type
+  operator[](TKey) const {
+    return node_->element;
+  }
+
+  template <typename TKey>
+  typename enable_if<IsString<TKey>::value, CompiledFilterRef>::type
+  operator[](const TKey& key) const {
+    return node_->find(adaptString(key));
+  }
+
+ private:
+  const CompiledFilterNode* node_;
+};
+
+// Converts a filter document into CompiledFilterNodes.
+// It runs twice: once to count the nodes, the keys, and the characters, and
+// once to fill the buffer allocated with these sizes.
+class FilterCompiler {
+ public:
+  size_t nodeCount = 0;
+  size_t keyCount = 0;
+  size_t charCount = 0;
+
+  // Allocates the nodes from the specified buffer, instead of counting them
+  void setBuffer(void* buffer) {
+    nodes_ = reinterpret_cast<CompiledFilterNode*>(buffer);
+    keys_ = reinterpret_cast<CompiledFilterKey*>(nodes_ + nodeCount);
+    chars_ = reinterpret_cast<char*>(keys_ + keyCount);
+    nodeCount = keyCount = charCount = 0;
+  }
+
+  static size_t bufferSize(size_t nodes, size_t keys, size_t chars) {
+    return nodes * sizeof(CompiledFilterNode) +
+           keys * sizeof(CompiledFilterKey) + chars;
+  }
+
+  const CompiledFilterNode* compile(JsonVariantConst filter) {
+    // Same decisions as Filter
+    DeserializationOption::Filter decisions(filter);
+    if (filter == true)
+      return CompiledFilterNode::allowAll();
+    uint8_t flags = uint8_t(
+        (decisions.allow() ? CompiledFilterNode::Allow : 0) |
+        (decisions.allowArray() ? CompiledFilterNode::AllowArray : 0) |
+        (decisions.allowObject() ? CompiledFilterNode::AllowObject : 0) |
+        (decisions.allowValue() ? CompiledFilterNode::AllowValue : 0));
+    JsonArrayConst array = filter;
+    JsonObjectConst object = filter;
+    if (!flags && !array && !object)
+      return CompiledFilterNode::denyAll();
+
+    CompiledFilterNode* node = nodes_ ? &nodes_[nodeCount] : nullptr;
+    nodeCount++;
+
+    // Filter looks up the key, then "*"
+    const CompiledFilterNode* wildcard = compile(filter["*"]);
+    JsonVariantConst firstElement = filter[size_t(0)];
+    const CompiledFilterNode* element =
+        firstElement.isNull() ? wildcard : compile(firstElement);
+
+    // Reserve the keys of this node before compiling the members, since they
+    // reserve their own
+    size_t size = 0, index = 0;
+    for (JsonPairConst member : object) {
+      if (isInTable(object, member, index++))
+        size++;
+    }
+    CompiledFilterKey* keys = nodes_ ? &keys_[keyCount] : nullptr;
+    keyCount += size;
+
+    CompiledFilterKey* key = keys;
+    index = 0;
+    for (JsonPairConst member : object) {
+      if (!isInTable(object, member, index++))
+        continue;
+      size_t offset = charCount;
+      charCount += member.key().size();
+      const CompiledFilterNode* child = compile(member.value());
+      if (key) {
+        memcpy(chars_ + offset, member.key().c_str(), member.key().size());
+        key->str = chars_ + offset;
+        key->size = member.key().size();
+        key->node = child;
+        key++;
+      }
+    }
+
+    if (!node)
+      return CompiledFilterNode::denyAll();  // we're just counting
+
+    sortKeys(keys, size);
+    node->flags = flags;
+    node->element = element;
+    node->wildcard = wildcard;
+    node->keys = keys;
+    node->keyCount = size;
+    return node;
+  }
+
+ private:
+  // Returns false if Filter never reaches this member: "*" is the wildcard,
+  // only the first occurrence of a key counts, and null falls back to "*".
+  static bool isInTable(JsonObjectConst object, JsonPairConst member,
+                        size_t index) {
+    if (member.key() == "*" || member.value().isNull())
+      return false;
+    for (JsonPairConst previous : object) {
+      if (index-- == 0)
+        break;
+      if (previous.key() == member.key())
+        return false;
+    }
+    return true;
+  }
+
+  static void sortKeys(CompiledFilterKey* keys, size_t size) {
+    // insertion sort: stable, small, and only done once
+    for (size_t i = 1; i < size; i++) {
+      CompiledFilterKey key = keys[i];
+      size_t j = i;
+      while (j > 0 && stringCompare(SizedRamString(key.str, key.size),
+                                    SizedRamString(keys[j - 1].str,
+                                                   keys[j - 1].size)) < 0) {
+        keys[j] = keys[j - 1];
+        j--;
+      }
+      keys[j] = key;
+    }
+  }
+
+  CompiledFilterNode* nodes_ = nullptr;
+  CompiledFilterKey* keys_ = nullptr;
+  char* chars_ = nullptr;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// A Filter converted to a lookup table, so it can be applied many times
+// without searching the filter document for each key.
+// The filter document can be destroyed once the CompiledFilter is created.
+class CompiledFilter {
+  friend class detail::VariantAttorney;
+
+ public:
+  explicit CompiledFilter(
+      JsonVariantConst filter,
+      Allocator* allocator = detail::DefaultAllocator::instance())
+      : allocator_(allocator) {
+    detail::FilterCompiler compiler;
+    root_ = compiler.compile(filter);
+    if (!compiler.nodeCount)
+      return;  // "true", "false", or null
+
+    buffer_ = allocator_->allocate(detail::FilterCompiler::bufferSize(
+        compiler.nodeCount, compiler.keyCount, compiler.charCount));
+    if (!buffer_) {
+      root_ = detail::CompiledFilterNode::denyAll();
+      overflowed_ = true;
+      return;
+    }
+    compiler.setBuffer(buffer_);
+    root_ = compiler.compile(filter);
+  }
+
+  ~CompiledFilter() {
+    if (buffer_)
+      allocator_->deallocate(buffer_);
+  }
+
+  CompiledFilter(const CompiledFilter&) = delete;
+  CompiledFilter& operator=(const CompiledFilter&) = delete;
+
+  // Returns true if the allocation failed; the filter then rejects everything.
+  bool overflowed() const {
+    return overflowed_;
+  }
+
+ private:
+  detail::CompiledFilterRef getData() const {
+    return root_;
+  }
+
+  Allocator* allocator_;
+  void* buffer_ = nullptr;
+  const detail::CompiledFilterNode* root_;
+  bool overflowed_ = false;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
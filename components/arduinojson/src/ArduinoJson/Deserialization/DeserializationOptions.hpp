@@ -0,0 +1,84 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/CompiledFilter.hpp>
+#include <ArduinoJson/Deserialization/ExactSize.hpp>
+#include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename TFilter>
+struct DeserializationOptions {
+  TFilter filter;
+  DeserializationOption::NestingLimit nestingLimit;
+  bool exactSize;
+};
+
+// The filter can be any type, except the other options
+template <typename T>
+using enable_if_filter = typename enable_if<
+    !is_same<T, DeserializationOption::ExactSize>::value>::type;
+
+template <typename TFilter, typename = enable_if_filter<TFilter>>
+inline DeserializationOptions<TFilter> makeDeserializationOptions(
+    TFilter filter, DeserializationOption::NestingLimit nestingLimit = {}) {
+  return {filter, nestingLimit, false};
+}
+
+template <typename TFilter, typename = enable_if_filter<TFilter>>
+inline DeserializationOptions<TFilter> makeDeserializationOptions(
+    DeserializationOption::NestingLimit nestingLimit, TFilter filter) {
+  return {filter, nestingLimit, false};
+}
+
+inline DeserializationOptions<CompiledFilterRef> makeDeserializationOptions(
+    const DeserializationOption::CompiledFilter& filter,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  return {VariantAttorney::getData(filter), nestingLimit, false};
+}
+
+inline DeserializationOptions<CompiledFilterRef> makeDeserializationOptions(
+    DeserializationOption::NestingLimit nestingLimit,
+    const DeserializationOption::CompiledFilter& filter) {
+  return {VariantAttorney::getData(filter), nestingLimit, false};
+}
+
+inline DeserializationOptions<AllowAllFilter> makeDeserializationOptions(
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  return {{}, nestingLimit, false};
+}
+
+template <typename TOptions>
+inline TOptions withExactSize(TOptions options) {
+  options.exactSize = true;
+  return options;
+}
+
+// ExactSize can be anywhere among the other options
+template <typename... Args>
+inline auto makeDeserializationOptions(DeserializationOption::ExactSize,
+                                       const Args&... args)
+    -> decltype(withExactSize(makeDeserializationOptions(args...))) {
+  return withExactSize(makeDeserializationOptions(args...));
+}
+
+template <typename T, typename... Args>
+inline auto makeDeserializationOptions(const T& arg,
+                                       DeserializationOption::ExactSize,
+                                       const Args&... args)
+    -> decltype(withExactSize(makeDeserializationOptions(arg, args...))) {
+  return withExactSize(makeDeserializationOptions(arg, args...));
+}
+
+template <typename T1, typename T2>
+inline auto makeDeserializationOptions(const T1& arg1, const T2& arg2,
+                                       DeserializationOption::ExactSize)
+    -> decltype(withExactSize(makeDeserializationOptions(arg1, arg2))) {
+  return withExactSize(makeDeserializationOptions(arg1, arg2));
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
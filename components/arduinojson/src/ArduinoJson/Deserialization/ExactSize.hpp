@@ -0,0 +1,22 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// Makes deserializeJson() and deserializeMsgPack() read the input twice: the
+// first pass counts the slots and the string bytes, then the JsonDocument
+// reserves exactly that (see JsonDocument::reserve()) and the second pass
+// fills it without growing the pools.
+// After the parse, the document gets its previous reservation back, so the
+// next clear() frees this memory, unless setKeepCapacity() was called.
+// The streams can't be read twice, so they ignore this option.
+struct ExactSize {};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 
 #include <stdlib.h>  // for size_t
@@ -39,6 +40,7 @@ struct BoundedReader {
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
 
+#include <ArduinoJson/Deserialization/Readers/InPlaceReader.hpp>
 #include <ArduinoJson/Deserialization/Readers/IteratorReader.hpp>
 #include <ArduinoJson/Deserialization/Readers/RamReader.hpp>
 #include <ArduinoJson/Deserialization/Readers/VariantReader.hpp>
@@ -72,4 +74,28 @@ BoundedReader<TChar*> makeReader(TChar* input, size_t inputSize) {
   return BoundedReader<TChar*>{input, inputSize};
 }
 
+// A meta-function that returns true if the reader exposes its content with
+// peek() and advance()
+template <typename TReader, typename = void>
+struct is_contiguous_reader : false_type {};
+
+template <typename TReader>
+struct is_contiguous_reader<
+    TReader,
+    typename make_void<decltype(declval<TReader&>().advance(0))>::type>
+    : true_type {};
+
+template <typename TIterator>
+true_type isIteratorReader(const IteratorReader<TIterator>*);
+false_type isIteratorReader(const void*);
+
+// A meta-function that returns true if a copy of the reader reads the input
+// again from the same position, which the streams can't do
+template <typename TReader>
+struct is_rewindable_reader
+    : integral_constant<
+          bool, is_contiguous_reader<TReader>::value ||
+                    decltype(isIteratorReader(declval<TReader*>()))::value> {
+};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,25 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Readers/IteratorReader.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Reads a mutable buffer that the deserializer is allowed to overwrite
+class InPlaceReader : public IteratorReader<const char*> {
+ public:
+  explicit InPlaceReader(char* ptr, size_t len)
+      : IteratorReader<const char*>(ptr, ptr + len), buffer_(ptr) {}
+
+  char* buffer() const {
+    return buffer_;
+  }
+
+ private:
+  char* buffer_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
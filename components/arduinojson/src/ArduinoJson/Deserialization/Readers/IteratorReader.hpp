@@ -0,0 +1,111 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename TIterator>
+class IteratorReader {
+  TIterator ptr_, end_;
+
+ public:
+  explicit IteratorReader(TIterator begin, TIterator end)
+      : ptr_(begin), end_(end) {}
+
+  int read() {
+    if (ptr_ < end_)
+      return static_cast<unsigned char>(*ptr_++);
+    else
+      return -1;
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t i = 0;
+    while (i < length && ptr_ < end_)
+      buffer[i++] = *ptr_++;
+    return i;
+  }
+};
+
+// Contiguous readers also implement peek() and advance() so the deserializers
+// can scan the input without calling read() for each character.
+template <>
+class IteratorReader<const char*> {
+  const char *ptr_, *end_;
+
+ public:
+  explicit IteratorReader(const char* begin, const char* end)
+      : ptr_(begin), end_(end) {}
+
+  int read() {
+    if (ptr_ < end_)
+      return static_cast<unsigned char>(*ptr_++);
+    else
+      return -1;
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t available = static_cast<size_t>(end_ - ptr_);
+    if (available < length)
+      length = available;
+    memcpy(buffer, ptr_, length);
+    ptr_ += length;
+    return length;
+  }
+
+  // Returns the unread characters, they stop at `end`
+  const char* peek(const char*& end) const {
+    end = end_;
+    return ptr_;
+  }
+
+  void advance(size_t n) {
+    ARDUINOJSON_ASSERT(n <= static_cast<size_t>(end_ - ptr_));
+    ptr_ += n;
+  }
+};
+
+template <typename T>
+struct void_ {
+  typedef void type;
+};
+
+// A meta-function that returns true if the container stores its characters
+// contiguously, like std::string
+template <typename TSource, typename = void>
+struct has_char_data : false_type {};
+
+template <typename TSource>
+struct has_char_data<TSource,
+                     typename enable_if<is_same<
+                         decltype(declval<const TSource&>().data()),
+                         const char*>::value>::type> : true_type {};
+
+template <typename TSource, bool = has_char_data<TSource>::value>
+struct ContainerReader : IteratorReader<typename TSource::const_iterator> {
+  explicit ContainerReader(const TSource& source)
+      : IteratorReader<typename TSource::const_iterator>(source.begin(),
+                                                         source.end()) {}
+};
+
+template <typename TSource>
+struct ContainerReader<TSource, true> : IteratorReader<const char*> {
+  explicit ContainerReader(const TSource& source)
+      : IteratorReader<const char*>(source.data(),
+                                    source.data() + source.size()) {}
+};
+
+template <typename TSource>
+struct Reader<TSource, typename void_<typename TSource::const_iterator>::type>
+    : ContainerReader<TSource> {
+  explicit Reader(const TSource& source) : ContainerReader<TSource>(source) {}
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
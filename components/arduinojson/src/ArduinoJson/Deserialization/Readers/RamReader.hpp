@@ -6,6 +6,8 @@
 
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 
+#include <string.h>  // memcpy
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 template <typename T>
@@ -32,10 +34,20 @@ struct Reader<TSource*,
   }
 
   size_t readBytes(char* buffer, size_t length) {
-    for (size_t i = 0; i < length; i++)
-      buffer[i] = *ptr_++;
+    memcpy(buffer, ptr_, length);
+    ptr_ += length;
     return length;
   }
+
+  // Returns the unread characters, `end` is null because the size is unknown
+  const char* peek(const char*& end) const {
+    end = nullptr;
+    return ptr_;
+  }
+
+  void advance(size_t n) {
+    ptr_ += n;
+  }
 };
 
 template <typename TSource>
@@ -0,0 +1,149 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/DeserializationOptions.hpp>
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Memory/ResourceCounter.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A meta-function that returns the first type of the parameter pack
+// or void if empty
+template <typename...>
+struct first_or_void {
+  using type = void;
+};
+template <typename T, typename... Rest>
+struct first_or_void<T, Rest...> {
+  using type = T;
+};
+
+// A meta-function that returns true if T is a valid destination type for
+// deserialize()
+template <class T, class = void>
+struct is_deserialize_destination : false_type {};
+
+template <class T>
+struct is_deserialize_destination<
+    T, typename enable_if<is_same<decltype(VariantAttorney::getResourceManager(
+                                      detail::declval<T&>())),
+                                  ResourceManager*>::value>::type> : true_type {
+};
+
+template <typename TDestination>
+inline void shrinkJsonDocument(TDestination&) {
+  // no-op by default
+}
+
+#if ARDUINOJSON_AUTO_SHRINK
+inline void shrinkJsonDocument(JsonDocument& doc) {
+  if (VariantAttorney::getResourceManager(doc)->autoShrink())
+    doc.shrinkToFit();
+}
+#endif
+
+// The reservation that DeserializationOption::ExactSize replaces during the
+// parse; restoreReservation() puts it back, so the next clear() frees the
+// memory reserved for this input.
+struct SavedReservation {
+  ResourceManager* resources = nullptr;  // null if there is nothing to restore
+  size_t slots = 0;
+  size_t stringBytes = 0;
+};
+
+inline void restoreReservation(const SavedReservation& saved) {
+  if (saved.resources)
+    saved.resources->setReservation(saved.slots, saved.stringBytes);
+}
+
+// Reads the input a first time to reserve the memory of the document
+// (see DeserializationOption::ExactSize)
+template <template <typename> class TDeserializer, typename TReader,
+          typename TOptions>
+inline SavedReservation reserveExactSize(ResourceManager* resources,
+                                         TReader reader,
+                                         const TOptions& options, true_type) {
+  SavedReservation saved;
+  ResourceCounter counter(resources->allocator());
+  typename TDeserializer<TReader>::Sizer sizer(&counter, reader);
+  if (sizer.parse(options.filter, options.nestingLimit))
+    return saved;  // the second pass reports the error
+  if (!resources->keepCapacity()) {
+    saved.resources = resources;
+    saved.slots = resources->reservedSlots();
+    saved.stringBytes = resources->reservedStringBytes();
+  }
+  resources->reserve(counter.slots(), counter.stringBytes());
+  return saved;
+}
+
+template <template <typename> class TDeserializer, typename TReader,
+          typename TOptions>
+inline SavedReservation reserveExactSize(ResourceManager*, TReader,
+                                         const TOptions&, false_type) {
+  // a stream can't be read twice
+  return SavedReservation();
+}
+
+template <template <typename> class TDeserializer, typename TDestination,
+          typename TReader, typename TOptions>
+inline SavedReservation reserveJsonDocument(TDestination&, TReader,
+                                            const TOptions&) {
+  // no-op by default: a variant shares the memory of its document
+  return SavedReservation();
+}
+
+template <template <typename> class TDeserializer, typename TReader,
+          typename TOptions>
+inline SavedReservation reserveJsonDocument(JsonDocument& doc, TReader reader,
+                                            const TOptions& options) {
+  if (!options.exactSize)
+    return SavedReservation();
+  return reserveExactSize<TDeserializer>(
+      VariantAttorney::getResourceManager(doc), reader, options,
+      is_rewindable_reader<TReader>());
+}
+
+template <template <typename> class TDeserializer, typename TDestination,
+          typename TReader, typename TOptions>
+DeserializationError doDeserialize(TDestination&& dst, TReader reader,
+                                   TOptions options) {
+  auto data = VariantAttorney::getOrCreateData(dst);
+  if (!data)
+    return DeserializationError::NoMemory;
+  auto resources = VariantAttorney::getResourceManager(dst);
+  dst.clear();
+  auto reservation = reserveJsonDocument<TDeserializer>(dst, reader, options);
+  auto err = TDeserializer<TReader>(resources, reader)
+                 .parse(*data, options.filter, options.nestingLimit);
+  restoreReservation(reservation);
+  shrinkJsonDocument(dst);
+  return err;
+}
+
+template <template <typename> class TDeserializer, typename TDestination,
+          typename TStream, typename... Args,
+          typename = typename enable_if<  // issue #1897
+              !is_integral<typename first_or_void<Args...>::type>::value>::type>
+DeserializationError deserialize(TDestination&& dst, TStream&& input,
+                                 const Args&... args) {
+  return doDeserialize<TDeserializer>(
+      dst, makeReader(detail::forward<TStream>(input)),
+      makeDeserializationOptions(args...));
+}
+
+template <template <typename> class TDeserializer, typename TDestination,
+          typename TChar, typename Size, typename... Args,
+          typename = typename enable_if<is_integral<Size>::value>::type>
+DeserializationError deserialize(TDestination&& dst, TChar* input,
+                                 Size inputSize, const Args&... args) {
+  return doDeserialize<TDeserializer>(dst, makeReader(input, size_t(inputSize)),
+                                      makeDeserializationOptions(args...));
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
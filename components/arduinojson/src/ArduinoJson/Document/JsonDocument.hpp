@@ -11,6 +11,7 @@
 #include <ArduinoJson/Object/MemberProxy.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 #include <ArduinoJson/Variant/JsonVariantConst.hpp>
+#include <ArduinoJson/Variant/VariantDataCopier.hpp>
 #include <ArduinoJson/Variant/VariantTo.hpp>
 
 ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
@@ -26,6 +27,7 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
 
   // Copy-constructor
   JsonDocument(const JsonDocument& src) : JsonDocument(src.allocator()) {
+    resources_.setSymbolTable(src.resources_.symbolTable());
     set(src);
   }
 
@@ -71,6 +73,67 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
     resources_.shrinkToFit();
   }
 
+  // Allocates the memory for the specified number of values (one slot per
+  // element or member) and bytes of strings, in one block each.
+  // The document keeps this memory when it's cleared, so deserializing a
+  // similar input again doesn't allocate.
+  // Returns false if the allocation failed.
+  bool reserve(size_t slots, size_t stringBytes = 0) {
+    return resources_.reserve(slots, stringBytes);
+  }
+
+  // Makes clear(), and therefore the deserialization functions, keep the
+  // memory pools instead of freeing them, so that deserializing a similar
+  // input again doesn't allocate any slot. This disables the automatic
+  // shrinkToFit(); call shrinkToFit() to release the unused pools.
+  // If recycleStrings is true, clear() also keeps a buffer large enough for
+  // the strings it frees, and the next strings are allocated in it.
+  void setKeepCapacity(bool enabled, bool recycleStrings = false) {
+    resources_.setKeepCapacity(enabled, recycleStrings);
+  }
+
+  // Clears the document and makes it link its object keys to the strings of a
+  // SymbolTable shared with other documents, instead of copying them; pass
+  // null to copy them again. The document must be detached, or destroyed,
+  // before the table.
+  // The copy-constructor attaches the copy to the same table; the other
+  // documents store their own copy of the keys they copy from this one.
+  void setSymbolTable(SymbolTable* table) {
+    clear();
+    resources_.setSymbolTable(table);
+  }
+
+  SymbolTable* symbolTable() const {
+    return resources_.symbolTable();
+  }
+
+  // Rebuilds the document in new memory pools, with the values in the order
+  // of a depth-first traversal, then frees the old pools and strings.
+  // Use it on a document that was edited a lot, to make the iterations
+  // faster and to release the memory of the removed values.
+  // Needs the memory for a second copy of the document during the operation.
+  // Returns false if it failed, leaving the document unchanged.
+  bool compact() {
+    JsonDocument tmp(allocator());
+    if (!tmp.resources_.copySettings(resources_))
+      return false;
+    detail::VariantDataCopier copier(&tmp.data_, &resources_,
+                                     &tmp.resources_);
+    if (!data_.accept(copier) || tmp.resources_.overflowed())
+      return false;
+    tmp.resources_.shrinkToFit();
+    swap(*this, tmp);
+    return true;
+  }
+
+#if ARDUINOJSON_AUTO_SHRINK
+  // Enables or disables the call to shrinkToFit() at the end of
+  // deserializeJson() and deserializeMsgPack(); it's enabled by default.
+  void setAutoShrink(bool enabled) {
+    resources_.setAutoShrink(enabled);
+  }
+#endif
+
   // Casts the root to the specified type.
   // https://arduinojson.org/v7/api/jsondocument/as/
   template <typename T>
@@ -118,6 +181,14 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
     return resources_.overflowed();
   }
 
+#if ARDUINOJSON_ENABLE_ALLOCATION_STATS
+  // Returns the allocation counters of the memory pools and of the strings.
+  // Requires ARDUINOJSON_ENABLE_ALLOCATION_STATS.
+  AllocationProfile allocationProfile() const {
+    return resources_.allocationProfile();
+  }
+#endif
+
   // Returns the depth (nesting level) of the array.
   // https://arduinojson.org/v7/api/jsondocument/nesting/
   size_t nesting() const {
@@ -214,7 +285,7 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
   // Gets a root array's member.
   // https://arduinojson.org/v7/api/jsondocument/subscript/
   JsonVariantConst operator[](size_t index) const {
-    return JsonVariantConst(data_.getElement(index, &resources_), &resources_);
+    return JsonVariantConst(&data_, index, &resources_);
   }
 
   // Appends a new (empty) element to the root array.
@@ -0,0 +1,110 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/JsonDocument.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// The settings of a PolicyJsonDocument.
+// Derive from this struct and redefine the members you want to change.
+// The layout of the slots and of the strings isn't part of the policy: all the
+// documents share the one of the configuration, because JsonVariant,
+// JsonArray, and JsonObject work with any of them.
+struct DefaultDocumentPolicy {
+  // The memory that the constructor reserves (see JsonDocument::reserve())
+  static const size_t reservedSlots = 0;
+  static const size_t reservedStringBytes = 0;
+
+  // See JsonDocument::setKeepCapacity()
+  static const bool keepCapacity = false;
+  static const bool recycleStrings = false;
+
+  // See JsonDocument::setAutoShrink(); ignored if ARDUINOJSON_AUTO_SHRINK is 0
+  static const bool autoShrink = true;
+};
+
+// A JsonDocument whose memory settings are fixed at compile time by TPolicy.
+// The constructors apply them, so every instance starts with the same
+// reservation and behavior.
+template <typename TPolicy = DefaultDocumentPolicy>
+class PolicyJsonDocument : public JsonDocument {
+  static_assert(TPolicy::reservedSlots < detail::NULL_SLOT,
+                "the reservation exceeds the range of the slot ids, "
+                "increase ARDUINOJSON_SLOT_ID_SIZE");
+
+ public:
+  using policy_type = TPolicy;
+
+  explicit PolicyJsonDocument(
+      Allocator* alloc = detail::DefaultAllocator::instance())
+      : JsonDocument(alloc) {
+    applyPolicy();
+  }
+
+  PolicyJsonDocument(const PolicyJsonDocument& src)
+      : PolicyJsonDocument(static_cast<const JsonDocument&>(src)) {}
+
+  // Takes the content, the settings, and the symbol table of src, and leaves
+  // it empty with the settings of the policy
+  PolicyJsonDocument(PolicyJsonDocument&& src)
+      : PolicyJsonDocument(src.allocator()) {
+    swap(*this, src);
+  }
+
+  // Copies a document of any policy, with the settings of this one
+  explicit PolicyJsonDocument(const JsonDocument& src)
+      : PolicyJsonDocument(src.allocator()) {
+    setSymbolTable(src.symbolTable());
+    set(src);
+  }
+
+  // Construct from variant, array, or object
+  template <typename T>
+  PolicyJsonDocument(
+      const T& src, Allocator* alloc = detail::DefaultAllocator::instance(),
+      typename detail::enable_if<
+          detail::is_same<T, JsonVariant>::value ||
+          detail::is_same<T, JsonVariantConst>::value ||
+          detail::is_same<T, JsonArray>::value ||
+          detail::is_same<T, JsonArrayConst>::value ||
+          detail::is_same<T, JsonObject>::value ||
+          detail::is_same<T, JsonObjectConst>::value>::type* = 0)
+      : PolicyJsonDocument(alloc) {
+    set(src);
+  }
+
+  PolicyJsonDocument& operator=(const PolicyJsonDocument& src) {
+    set(src);
+    return *this;
+  }
+
+  PolicyJsonDocument& operator=(PolicyJsonDocument&& src) {
+    swap(*this, src);  // same policy, so the settings can move along
+    return *this;
+  }
+
+  // Copies the value, but keeps the settings of this policy
+  template <typename T>
+  PolicyJsonDocument& operator=(const T& src) {
+    set(src);
+    return *this;
+  }
+
+ private:
+  // If the reservation fails, the document allocates on demand as usual
+  void applyPolicy() {
+    if (TPolicy::reservedSlots || TPolicy::reservedStringBytes)
+      reserve(TPolicy::reservedSlots, TPolicy::reservedStringBytes);
+    if (TPolicy::keepCapacity)
+      setKeepCapacity(true, TPolicy::recycleStrings);
+#if ARDUINOJSON_AUTO_SHRINK
+    if (!TPolicy::autoShrink)
+      setAutoShrink(false);
+#endif
+  }
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,43 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Configuration.hpp>
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stdint.h>  // uint8_t
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+inline bool isBetween(char c, char min, char max) {
+  return min <= c && c <= max;
+}
+
+inline bool canBeInNumber(char c) {
+  return isBetween(c, '0', '9') || c == '+' || c == '-' || c == '.' ||
+#if ARDUINOJSON_ENABLE_NAN || ARDUINOJSON_ENABLE_INFINITY
+         isBetween(c, 'A', 'Z') || isBetween(c, 'a', 'z');
+#else
+         c == 'e' || c == 'E';
+#endif
+}
+
+inline bool canBeInNonQuotedString(char c) {
+  return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
+         isBetween(c, 'A', 'Z');
+}
+
+inline bool isQuote(char c) {
+  return c == '\'' || c == '\"';
+}
+
+inline uint8_t decodeHex(char c) {
+  if (c < 'A')
+    return uint8_t(c - '0');
+  c = char(c & ~0x20);  // uppercase
+  return uint8_t(c - 'A' + 10);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,742 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Json/CharacterClasses.hpp>
+#include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/JsonLexer.hpp>
+#include <ArduinoJson/Json/JsonSizer.hpp>
+#include <ArduinoJson/Json/StringScanner.hpp>
+#include <ArduinoJson/Json/StructuralIndex.hpp>
+#include <ArduinoJson/Json/Utf16.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Memory/StringBuilder.hpp>
+#include <ArduinoJson/Memory/StringMover.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Strings are copied in the memory pool...
+template <typename TReader>
+inline StringBuilder makeStringStorage(ResourceManager* resources, TReader&) {
+  return StringBuilder(resources);
+}
+
+// ...except when the input buffer can be modified in place
+inline StringMover makeStringStorage(ResourceManager*, InPlaceReader& reader) {
+  return StringMover(reader.buffer());
+}
+
+template <typename TReader>
+using JsonStringStorage = decltype(makeStringStorage(
+    detail::declval<ResourceManager*>(), detail::declval<TReader&>()));
+
+template <typename TReader>
+class JsonDeserializer : JsonLexer<TReader, JsonStringStorage<TReader>> {
+  using StringStorage = JsonStringStorage<TReader>;
+  using base = JsonLexer<TReader, StringStorage>;
+
+ public:
+  // The first pass of DeserializationOption::ExactSize
+  using Sizer = JsonSizer<TReader>;
+
+  JsonDeserializer(ResourceManager* resources, TReader reader)
+      : base(makeStringStorage(resources, reader), reader),
+        resources_(resources) {}
+
+  template <typename TFilter>
+  DeserializationError parse(VariantData& variant, TFilter filter,
+                             DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+#if ARDUINOJSON_ENABLE_STRUCTURAL_INDEX && !ARDUINOJSON_ENABLE_COMMENTS
+    if (parseIndexed(variant, filter, nestingLimit))
+      return DeserializationError::Ok;
+#endif
+
+    err = parseVariant(variant, filter, nestingLimit);
+
+    if (!err && latch_.last() != 0 && variant.isFloat()) {
+      // We don't detect trailing characters earlier, so we need to check now
+      return DeserializationError::InvalidInput;
+    }
+
+    return err;
+  }
+
+ private:
+  using base::current;
+  using base::eat;
+  using base::latch_;
+  using base::move;
+  using base::parseKey;
+  using base::parseNumericValue;
+  using base::parseQuotedString;
+  using base::skipCollection;
+  using base::skipKeyword;
+  using base::skipNumericValue;
+  using base::skipQuotedString;
+  using base::skipSpacesAndComments;
+  using base::skipVariant;
+  using base::stringStorage_;
+
+  template <typename TFilter>
+  DeserializationError::Code parseVariant(
+      VariantData& variant, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (current()) {
+      case '[':
+        if (filter.allowArray())
+          return parseArray(variant.toArray(), filter, nestingLimit);
+        else
+          return skipCollection(nestingLimit);
+
+      case '{':
+        if (filter.allowObject())
+          return parseObject(variant.toObject(), filter, nestingLimit);
+        else
+          return skipCollection(nestingLimit);
+
+      case '\"':
+      case '\'':
+        if (filter.allowValue())
+          return parseStringValue(variant);
+        else
+          return skipQuotedString();
+
+      case 't':
+        if (filter.allowValue())
+          variant.setBoolean(true);
+        return skipKeyword("true");
+
+      case 'f':
+        if (filter.allowValue())
+          variant.setBoolean(false);
+        return skipKeyword("false");
+
+      case 'n':
+        // the variant should already by null, except if the same object key was
+        // used twice, as in {"a":1,"a":null}
+        return skipKeyword("null");
+
+      default:
+        if (filter.allowValue())
+          return parseNumericValue(variant);
+        else
+          return skipNumericValue();
+    }
+  }
+
+  template <typename TFilter>
+  DeserializationError::Code parseArray(
+      ArrayData& array, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty array?
+    if (eat(']'))
+      return DeserializationError::Ok;
+
+    TFilter elementFilter = filter[0UL];
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    size_t count = 0;
+#endif
+
+    // Read each value
+    for (;;) {
+      if (elementFilter.allow()) {
+        // Allocate slot in array
+        VariantData* value = array.addElement(resources_);
+        if (!value)
+          return DeserializationError::NoMemory;
+
+        // 1 - Parse value
+        err = parseVariant(*value, elementFilter, nestingLimit.decrement());
+        if (err)
+          return err;
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+        // Enough elements to tell if it's an array of numbers?
+        if (++count == PackedArray::minElements && elementFilter.allowValue()) {
+          auto variant = collectionToVariant(&array);
+          if (variant->packArray(resources_)) {
+            err = parsePackedElements(*variant, elementFilter, nestingLimit);
+            if (err || !variant->isArray())
+              return err;
+            // the array was unpacked, so we continue with the slots
+          }
+        }
+#endif
+      } else {
+        err = skipVariant(nestingLimit.decrement());
+        if (err)
+          return err;
+      }
+
+      // 2 - Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // 3 - More values?
+      if (eat(']'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // Continues parseArray() once the elements are packed, until the end of the
+  // array, or until an element that the packed array can't store.
+  template <typename TFilter>
+  DeserializationError::Code parsePackedElements(
+      VariantData& variant, TFilter elementFilter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    for (;;) {
+      // 1 - Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // 2 - More values?
+      if (eat(']')) {
+        variant.shrinkPackedArray(resources_);
+        return DeserializationError::Ok;
+      }
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // 3 - Parse value
+      char c = current();
+      if (c != '-' && !isBetween(c, '0', '9')) {
+        if (!variant.unpackArray(resources_))
+          return DeserializationError::NoMemory;
+        VariantData* value = variant.asArray()->addElement(resources_);
+        if (!value)
+          return DeserializationError::NoMemory;
+        return parseVariant(*value, elementFilter, nestingLimit.decrement());
+      }
+
+      VariantData value;
+      err = parseNumericValue(value);
+      if (err)
+        return err;
+      if (!variant.addPackedElement(value, resources_))
+        return DeserializationError::NoMemory;
+      if (variant.isArray())
+        return DeserializationError::Ok;
+    }
+  }
+#endif
+
+  template <typename TFilter>
+  DeserializationError::Code parseObject(
+      ObjectData& object, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (eat('}'))
+      return DeserializationError::Ok;
+
+    // Read each key value pair
+    for (;;) {
+      // Parse key
+      err = parseKey();
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // Colon
+      if (!eat(':'))
+        return DeserializationError::InvalidInput;
+
+      JsonString key = stringStorage_.str();
+
+      TFilter memberFilter = filter[key.c_str()];
+
+      if (memberFilter.allow()) {
+        auto member = object.getMember(adaptString(key.c_str()), resources_);
+        if (!member) {
+          // Save key in memory pool.
+          // Allocate slot in object
+          member = addMember(object, stringStorage_);
+          if (!member)
+            return DeserializationError::NoMemory;
+        } else {
+          member->setNull(resources_);
+        }
+
+        // Parse value
+        err = parseVariant(*member, memberFilter, nestingLimit.decrement());
+        if (err)
+          return err;
+      } else {
+        err = skipVariant(nestingLimit.decrement());
+        if (err)
+          return err;
+      }
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More keys/values?
+      if (eat('}'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
+  DeserializationError::Code parseStringValue(VariantData& variant) {
+    DeserializationError::Code err;
+
+    stringStorage_.startString();
+
+    err = parseQuotedString();
+    if (err)
+      return err;
+
+    stringStorage_.save(&variant);
+
+    return DeserializationError::Ok;
+  }
+
+#if ARDUINOJSON_ENABLE_STRUCTURAL_INDEX && !ARDUINOJSON_ENABLE_COMMENTS
+  // Two-stage parser: builds a StructuralIndex of the input, then parses from
+  // the index instead of tokenizing character by character.
+  // It only accepts standard JSON and fails on anything else: errors,
+  // extensions like single quotes or unquoted keys, and root values that are
+  // not collections. Comments are not supported either.
+  // In that case, we reset the variant and use the regular parser, which gives
+  // the same result and reports the right error.
+  template <typename TFilter>
+  bool parseIndexed(VariantData& variant, TFilter filter,
+                    DeserializationOption::NestingLimit nestingLimit) {
+    // the regular parser needs the input intact
+    if (!is_same<StringStorage, StringBuilder>::value)
+      return false;
+
+    const char* end;
+    const char* input = latch_.peek(end);
+    if (!input)
+      return false;
+    size_t length = end ? size_t(end - input) : strlen(input);
+    auto nul = static_cast<const char*>(memchr(input, 0, length));
+    if (nul)  // the input stops at the first '\0'
+      length = size_t(nul - input);
+
+    StructuralIndex index(resources_->allocator());
+    if (!index.build(input, length))
+      return false;
+
+    char c = index.next();
+    if ((c == '[' || c == '{') &&
+        parseIndexedVariant(index, variant, filter, nestingLimit))
+      return true;
+
+    variant.setNull(resources_);
+    return false;
+  }
+
+  template <typename TFilter>
+  bool parseIndexedVariant(StructuralIndex& index, VariantData& variant,
+                           TFilter filter,
+                           DeserializationOption::NestingLimit nestingLimit) {
+    switch (index.next()) {
+      case '[':
+        if (filter.allowArray())
+          return parseIndexedArray(index, variant.toArray(), filter,
+                                   nestingLimit);
+        else
+          return skipIndexedCollection(index, nestingLimit);
+
+      case '{':
+        if (filter.allowObject())
+          return parseIndexedObject(index, variant.toObject(), filter,
+                                    nestingLimit);
+        else
+          return skipIndexedCollection(index, nestingLimit);
+
+      case '"':
+        if (filter.allowValue())
+          return parseIndexedStringValue(index, variant);
+        else
+          return skipIndexedString(index);
+
+      case '\0':
+        return false;
+
+      default:
+        return parseIndexedToken(index, &variant, filter.allowValue());
+    }
+  }
+
+  bool skipIndexedVariant(StructuralIndex& index,
+                          DeserializationOption::NestingLimit nestingLimit) {
+    switch (index.next()) {
+      case '[':
+      case '{':
+        return skipIndexedCollection(index, nestingLimit);
+
+      case '"':
+        return skipIndexedString(index);
+
+      case '\0':
+        return false;
+
+      default:
+        return parseIndexedToken(index, nullptr, false);
+    }
+  }
+
+  template <typename TFilter>
+  bool parseIndexedArray(StructuralIndex& index, ArrayData& array,
+                         TFilter filter,
+                         DeserializationOption::NestingLimit nestingLimit) {
+    if (nestingLimit.reached())
+      return false;
+
+    index.consume();  // '['
+
+    // Empty array?
+    if (index.next() == ']') {
+      index.consume();
+      return true;
+    }
+
+    TFilter elementFilter = filter[0UL];
+
+    for (;;) {
+      if (elementFilter.allow()) {
+        VariantData* value = array.addElement(resources_);
+        if (!value)
+          return false;
+        if (!parseIndexedVariant(index, *value, elementFilter,
+                                 nestingLimit.decrement()))
+          return false;
+      } else {
+        if (!skipIndexedVariant(index, nestingLimit.decrement()))
+          return false;
+      }
+
+      char c = index.next();
+      if (c != ',' && c != ']')
+        return false;
+      index.consume();
+      if (c == ']')
+        return true;
+    }
+  }
+
+  template <typename TFilter>
+  bool parseIndexedObject(StructuralIndex& index, ObjectData& object,
+                          TFilter filter,
+                          DeserializationOption::NestingLimit nestingLimit) {
+    if (nestingLimit.reached())
+      return false;
+
+    index.consume();  // '{'
+
+    // Empty object?
+    if (index.next() == '}') {
+      index.consume();
+      return true;
+    }
+
+    for (;;) {
+      if (index.next() != '"')
+        return false;
+      stringStorage_.startString();
+      if (!parseIndexedQuotedString(index))
+        return false;
+
+      if (index.next() != ':')
+        return false;
+      index.consume();
+
+      JsonString key = stringStorage_.str();
+      TFilter memberFilter = filter[key.c_str()];
+
+      if (memberFilter.allow()) {
+        auto member = object.getMember(adaptString(key.c_str()), resources_);
+        if (!member) {
+          member = addMember(object, stringStorage_);
+          if (!member)
+            return false;
+        } else {
+          member->setNull(resources_);
+        }
+        if (!parseIndexedVariant(index, *member, memberFilter,
+                                 nestingLimit.decrement()))
+          return false;
+      } else {
+        if (!skipIndexedVariant(index, nestingLimit.decrement()))
+          return false;
+      }
+
+      char c = index.next();
+      if (c != ',' && c != '}')
+        return false;
+      index.consume();
+      if (c == '}')
+        return true;
+    }
+  }
+
+  // Strings contain no position, so we only need to count the brackets and
+  // braces.
+  bool skipIndexedCollection(StructuralIndex& index,
+                             DeserializationOption::NestingLimit nestingLimit) {
+    uint8_t depth = 0;
+    uint8_t checkedDepth = 0;
+
+    for (;;) {
+      switch (index.next()) {
+        case '[':
+        case '{':
+          if (depth == checkedDepth) {
+            if (nestingLimit.reached())
+              return false;
+            nestingLimit = nestingLimit.decrement();
+            checkedDepth++;
+          }
+          depth++;
+          break;
+
+        case ']':
+        case '}':
+          if (--depth == 0) {
+            index.consume();
+            return true;
+          }
+          break;
+
+        case '\'':
+        case '\\':
+        case '\0':
+          return false;
+
+        default:  // string, token, or separator
+          break;
+      }
+      index.consume();
+    }
+  }
+
+  bool parseIndexedStringValue(StructuralIndex& index, VariantData& variant) {
+    stringStorage_.startString();
+    if (!parseIndexedQuotedString(index))
+      return false;
+    stringStorage_.save(&variant);
+    return true;
+  }
+
+  bool parseIndexedQuotedString(StructuralIndex& index) {
+#  if ARDUINOJSON_DECODE_UNICODE
+    Utf16::Codepoint codepoint;
+#  endif
+    const char* p = index.position() + 1;  // skip '"'
+    const char* end = index.end();
+    index.consume();
+
+    for (;;) {
+      const char* special = findFirst(p, end, SpecialCharInString('"'));
+      stringStorage_.append(p, size_t(special - p));
+      p = special;
+
+      if (p == end)
+        return false;
+      char c = *p++;
+      if (c == '"')
+        break;
+
+      // backslash
+      if (p == end)
+        return false;
+      c = *p;
+      if (c == 'u') {
+#  if ARDUINOJSON_DECODE_UNICODE
+        p++;
+        uint16_t codeunit = 0;
+        for (uint8_t i = 0; i < 4; ++i, ++p) {
+          uint8_t value = p != end ? decodeHex(*p) : 0xFF;
+          if (value > 0x0F)
+            return false;
+          codeunit = uint16_t((codeunit << 4) | value);
+        }
+        if (codepoint.append(codeunit))
+          Utf8::encodeCodepoint(codepoint.value(), stringStorage_);
+#  else
+        stringStorage_.append('\\');
+#  endif
+        continue;
+      }
+      c = EscapeSequence::unescapeChar(c);
+      if (c == '\0')
+        return false;
+      p++;
+      stringStorage_.append(c);
+    }
+
+    // the closing quote must be the one found by stage 1
+    return stringStorage_.isValid() && p <= index.position();
+  }
+
+  bool skipIndexedString(StructuralIndex& index) {
+    // stage 1 already found the end of the string
+    index.consume();
+    return true;
+  }
+
+  // Parses a number or a literal; skips it if variant is null
+  bool parseIndexedToken(StructuralIndex& index, VariantData* variant,
+                         bool allowValue) {
+    const char* s = index.position();
+    size_t n = index.consumeToken();
+
+    switch (s[0]) {
+      case 't':
+        if (!tokenEquals(s, n, "true"))
+          return false;
+        if (allowValue)
+          variant->setBoolean(true);
+        return true;
+
+      case 'f':
+        if (!tokenEquals(s, n, "false"))
+          return false;
+        if (allowValue)
+          variant->setBoolean(false);
+        return true;
+
+      case 'n':
+        return tokenEquals(s, n, "null");
+
+      default:
+        for (size_t i = 0; i < n; i++) {
+          if (!canBeInNumber(s[i]))
+            return false;
+        }
+        return !allowValue || parseNumber(s, s + n, *variant);
+    }
+  }
+
+  static bool tokenEquals(const char* s, size_t n, const char* keyword) {
+    return strlen(keyword) == n && memcmp(s, keyword, n) == 0;
+  }
+#endif
+
+  VariantData* addMember(ObjectData& object, StringBuilder& key) {
+    return key.addMember(object);
+  }
+
+  VariantData* addMember(ObjectData& object, StringMover& key) {
+    return object.addMember(adaptString(key.save()), resources_);
+  }
+
+  ResourceManager* resources_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses a JSON input, filters, and puts the result in a JsonDocument.
+// https://arduinojson.org/v7/api/json/deserializejson/
+template <typename TDestination, typename... Args>
+typename detail::enable_if<
+    detail::is_deserialize_destination<TDestination>::value,
+    DeserializationError>::type
+deserializeJson(TDestination&& dst, Args&&... args) {
+  using namespace detail;
+  return deserialize<JsonDeserializer>(detail::forward<TDestination>(dst),
+                                       detail::forward<Args>(args)...);
+}
+
+// Parses a JSON input, filters, and puts the result in a JsonDocument.
+// https://arduinojson.org/v7/api/json/deserializejson/
+template <typename TDestination, typename TChar, typename... Args>
+typename detail::enable_if<
+    detail::is_deserialize_destination<TDestination>::value,
+    DeserializationError>::type
+deserializeJson(TDestination&& dst, TChar* input, Args&&... args) {
+  using namespace detail;
+  return deserialize<JsonDeserializer>(detail::forward<TDestination>(dst),
+                                       input, detail::forward<Args>(args)...);
+}
+
+// Parses a JSON input in place, filters, and puts the result in a JsonDocument.
+// The strings are unescaped in the input buffer, so the document keeps
+// pointers to it: the buffer must outlive the document and its content is
+// modified. Strings containing "\u0000" are truncated.
+template <typename TDestination, typename... Args>
+typename detail::enable_if<
+    detail::is_deserialize_destination<TDestination>::value,
+    DeserializationError>::type
+deserializeJsonInPlace(TDestination&& dst, char* input, size_t inputSize,
+                       const Args&... args) {
+  using namespace detail;
+  return doDeserialize<JsonDeserializer>(
+      dst, InPlaceReader(input, input ? inputSize : 0),
+      makeDeserializationOptions(args...));
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
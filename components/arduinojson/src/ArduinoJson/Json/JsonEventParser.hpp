@@ -0,0 +1,300 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Json/JsonLexer.hpp>
+#include <ArduinoJson/Memory/StringBuffer.hpp>
+#include <ArduinoJson/Variant/JsonVariantConst.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// The callbacks of parseJsonEvents().
+// Derive from this class and redefine the functions you need; the others do
+// nothing. The strings are only valid during the call.
+// A key or a string longer than ARDUINOJSON_EVENT_STRING_SIZE comes in parts:
+// onKeyPart() or onStringPart() receives each full buffer, then onKey() or
+// onString() receives the rest. A part may end in the middle of a UTF-8
+// sequence.
+struct JsonEventHandler {
+  void onStartObject() {}
+  void onKeyPart(JsonString) {}
+  void onKey(JsonString) {}
+  void onEndObject() {}
+  void onStartArray() {}
+  void onEndArray() {}
+  void onStringPart(JsonString) {}
+  void onString(JsonString) {}
+  void onNumber(JsonVariantConst) {}
+  void onBoolean(bool) {}
+  void onNull() {}
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+using EventStringStorage = StringBuffer<ARDUINOJSON_EVENT_STRING_SIZE>;
+
+template <typename TReader>
+class JsonEventParser : JsonLexer<TReader, EventStringStorage> {
+  using base = JsonLexer<TReader, EventStringStorage>;
+
+ public:
+  JsonEventParser(TReader reader) : base(EventStringStorage(), reader) {}
+
+  template <typename THandler>
+  DeserializationError parse(THandler& handler,
+                             DeserializationOption::NestingLimit nestingLimit) {
+    bool isNumber = false;
+    DeserializationError::Code err =
+        parseVariant(handler, nestingLimit, isNumber);
+
+    if (!err && latch_.last() != 0 && isNumber) {
+      // We don't detect trailing characters earlier, so we need to check now
+      return DeserializationError::InvalidInput;
+    }
+
+    return err;
+  }
+
+ private:
+  using base::current;
+  using base::eat;
+  using base::latch_;
+  using base::move;
+  using base::parseKey;
+  using base::parseNumericValue;
+  using base::parseQuotedString;
+  using base::skipKeyword;
+  using base::skipSpacesAndComments;
+  using base::stringStorage_;
+
+  // Pass the full buffer of a long key or string to the handler
+  template <typename THandler>
+  static void keyPartSink(void* handler, JsonString part) {
+    static_cast<THandler*>(handler)->onKeyPart(part);
+  }
+
+  template <typename THandler>
+  static void stringPartSink(void* handler, JsonString part) {
+    static_cast<THandler*>(handler)->onStringPart(part);
+  }
+
+  template <typename THandler>
+  DeserializationError::Code parseVariant(
+      THandler& handler, DeserializationOption::NestingLimit nestingLimit,
+      bool& isNumber) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (current()) {
+      case '[':
+        return parseArray(handler, nestingLimit);
+
+      case '{':
+        return parseObject(handler, nestingLimit);
+
+      case '\"':
+      case '\'':
+        stringStorage_.setSink(stringPartSink<THandler>, &handler);
+        stringStorage_.startString();
+        err = parseQuotedString();
+        if (err)
+          return err;
+        handler.onString(stringStorage_.str());
+        return DeserializationError::Ok;
+
+      case 't':
+        err = skipKeyword("true");
+        if (err)
+          return err;
+        handler.onBoolean(true);
+        return DeserializationError::Ok;
+
+      case 'f':
+        err = skipKeyword("false");
+        if (err)
+          return err;
+        handler.onBoolean(false);
+        return DeserializationError::Ok;
+
+      case 'n':
+        err = skipKeyword("null");
+        if (err)
+          return err;
+        handler.onNull();
+        return DeserializationError::Ok;
+
+      default: {
+        VariantData value;
+        err = parseNumericValue(value);
+        if (err)
+          return err;
+        isNumber = true;
+        handler.onNumber(JsonVariantConst(&value, nullptr));
+        return DeserializationError::Ok;
+      }
+    }
+  }
+
+  template <typename THandler>
+  DeserializationError::Code parseArray(
+      THandler& handler, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+    handler.onStartArray();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty array?
+    if (eat(']')) {
+      handler.onEndArray();
+      return DeserializationError::Ok;
+    }
+
+    // Read each value
+    for (;;) {
+      bool isNumber;
+      err = parseVariant(handler, nestingLimit.decrement(), isNumber);
+      if (err)
+        return err;
+
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      if (eat(']')) {
+        handler.onEndArray();
+        return DeserializationError::Ok;
+      }
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  template <typename THandler>
+  DeserializationError::Code parseObject(
+      THandler& handler, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+    handler.onStartObject();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (eat('}')) {
+      handler.onEndObject();
+      return DeserializationError::Ok;
+    }
+
+    // Read each key value pair
+    for (;;) {
+      stringStorage_.setSink(keyPartSink<THandler>, &handler);
+      err = parseKey();
+      if (err)
+        return err;
+
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      if (!eat(':'))
+        return DeserializationError::InvalidInput;
+
+      handler.onKey(stringStorage_.str());
+
+      bool isNumber;
+      err = parseVariant(handler, nestingLimit.decrement(), isNumber);
+      if (err)
+        return err;
+
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      if (eat('}')) {
+        handler.onEndObject();
+        return DeserializationError::Ok;
+      }
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses a JSON input and calls the handler for each token, without building
+// a JsonDocument. Nothing is allocated: the strings are stored in a buffer of
+// ARDUINOJSON_EVENT_STRING_SIZE characters, and the longer ones come in parts
+// (see JsonEventHandler).
+template <typename TInput, typename THandler>
+DeserializationError parseJsonEvents(
+    TInput&& input, THandler& handler,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  auto reader = makeReader(detail::forward<TInput>(input));
+  return JsonEventParser<decltype(reader)>(reader).parse(handler,
+                                                         nestingLimit);
+}
+
+// Parses a JSON input and calls the handler for each token, without building
+// a JsonDocument. Nothing is allocated: the strings are stored in a buffer of
+// ARDUINOJSON_EVENT_STRING_SIZE characters, and the longer ones come in parts
+// (see JsonEventHandler).
+template <typename TChar, typename THandler>
+DeserializationError parseJsonEvents(
+    TChar* input, THandler& handler,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  auto reader = makeReader(input);
+  return JsonEventParser<decltype(reader)>(reader).parse(handler,
+                                                         nestingLimit);
+}
+
+// Parses a JSON input and calls the handler for each token, without building
+// a JsonDocument. Nothing is allocated: the strings are stored in a buffer of
+// ARDUINOJSON_EVENT_STRING_SIZE characters, and the longer ones come in parts
+// (see JsonEventHandler).
+template <typename TChar, typename THandler>
+DeserializationError parseJsonEvents(
+    TChar* input, size_t inputSize, THandler& handler,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  auto reader = makeReader(input, inputSize);
+  return JsonEventParser<decltype(reader)>(reader).parse(handler,
+                                                         nestingLimit);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -4,45 +4,29 @@
 
 #pragma once
 
-#include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Json/CharacterClasses.hpp>
 #include <ArduinoJson/Json/EscapeSequence.hpp>
 #include <ArduinoJson/Json/Latch.hpp>
+#include <ArduinoJson/Json/StringScanner.hpp>
 #include <ArduinoJson/Json/Utf16.hpp>
 #include <ArduinoJson/Json/Utf8.hpp>
-#include <ArduinoJson/Memory/ResourceManager.hpp>
 #include <ArduinoJson/Numbers/parseNumber.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
-#include <ArduinoJson/Polyfills/type_traits.hpp>
-#include <ArduinoJson/Polyfills/utility.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
-template <typename TReader>
-class JsonDeserializer {
- public:
-  JsonDeserializer(ResourceManager* resources, TReader reader)
-      : stringBuilder_(resources),
-        foundSomething_(false),
-        latch_(reader),
-        resources_(resources) {}
-
-  template <typename TFilter>
-  DeserializationError parse(VariantData& variant, TFilter filter,
-                             DeserializationOption::NestingLimit nestingLimit) {
-    DeserializationError::Code err;
-
-    err = parseVariant(variant, filter, nestingLimit);
-
-    if (!err && latch_.last() != 0 && variant.isFloat()) {
-      // We don't detect trailing characters earlier, so we need to check now
-      return DeserializationError::InvalidInput;
-    }
+// The tokenizer shared by JsonDeserializer, JsonEventParser, and
+// JsonPathExtractor. It reads the strings into TStringStorage and the numbers
+// into a VariantData; the derived class decides what to do with them.
+template <typename TReader, typename TStringStorage>
+class JsonLexer {
+ protected:
+  JsonLexer(TStringStorage stringStorage, TReader reader)
+      : stringStorage_(stringStorage), foundSomething_(false), latch_(reader) {}
 
-    return err;
-  }
-
- private:
   char current() {
     return latch_.current();
   }
@@ -58,59 +42,6 @@ class JsonDeserializer {
     return true;
   }
 
-  template <typename TFilter>
-  DeserializationError::Code parseVariant(
-      VariantData& variant, TFilter filter,
-      DeserializationOption::NestingLimit nestingLimit) {
-    DeserializationError::Code err;
-
-    err = skipSpacesAndComments();
-    if (err)
-      return err;
-
-    switch (current()) {
-      case '[':
-        if (filter.allowArray())
-          return parseArray(variant.toArray(), filter, nestingLimit);
-        else
-          return skipArray(nestingLimit);
-
-      case '{':
-        if (filter.allowObject())
-          return parseObject(variant.toObject(), filter, nestingLimit);
-        else
-          return skipObject(nestingLimit);
-
-      case '\"':
-      case '\'':
-        if (filter.allowValue())
-          return parseStringValue(variant);
-        else
-          return skipQuotedString();
-
-      case 't':
-        if (filter.allowValue())
-          variant.setBoolean(true);
-        return skipKeyword("true");
-
-      case 'f':
-        if (filter.allowValue())
-          variant.setBoolean(false);
-        return skipKeyword("false");
-
-      case 'n':
-        // the variant should already by null, except if the same object key was
-        // used twice, as in {"a":1,"a":null}
-        return skipKeyword("null");
-
-      default:
-        if (filter.allowValue())
-          return parseNumericValue(variant);
-        else
-          return skipNumericValue();
-    }
-  }
-
   DeserializationError::Code skipVariant(
       DeserializationOption::NestingLimit nestingLimit) {
     DeserializationError::Code err;
@@ -121,10 +52,8 @@ class JsonDeserializer {
 
     switch (current()) {
       case '[':
-        return skipArray(nestingLimit);
-
       case '{':
-        return skipObject(nestingLimit);
+        return skipCollection(nestingLimit);
 
       case '\"':
       case '\'':
@@ -144,59 +73,70 @@ class JsonDeserializer {
     }
   }
 
-  template <typename TFilter>
-  DeserializationError::Code parseArray(
-      ArrayData& array, TFilter filter,
+  // Skips an array or an object without tokenizing its content: we only track
+  // the nesting depth and whether we're in a string. The content of the
+  // skipped collection isn't validated, so a filter accepts anything between
+  // balanced brackets, like [1 2 x}.
+  // With ARDUINOJSON_ENABLE_COMMENTS, the comments can contain brackets and
+  // quotes, so we parse the content, which validates it too.
+  DeserializationError::Code skipCollection(
       DeserializationOption::NestingLimit nestingLimit) {
+#if ARDUINOJSON_ENABLE_COMMENTS
+    // comments can contain brackets and quotes
+    if (current() == '[')
+      return skipArray(nestingLimit);
+    else
+      return skipObject(nestingLimit);
+#else
     DeserializationError::Code err;
+    uint8_t depth = 0;
+    uint8_t checkedDepth = 0;  // number of levels checked against the limit
 
-    if (nestingLimit.reached())
-      return DeserializationError::TooDeep;
+    ARDUINOJSON_ASSERT(current() == '[' || current() == '{');
 
-    // Skip opening braket
-    ARDUINOJSON_ASSERT(current() == '[');
-    move();
-
-    // Skip spaces
-    err = skipSpacesAndComments();
-    if (err)
-      return err;
+    for (;;) {
+      // Jump to the next bracket, brace, or quote
+      const char* end;
+      const char* chunk = latch_.peek(end);
+      if (chunk)
+        latch_.advance(size_t(findFirst(chunk, end, StructuralChar()) - chunk));
 
-    // Empty array?
-    if (eat(']'))
-      return DeserializationError::Ok;
+      switch (current()) {
+        case '\0':
+          return DeserializationError::IncompleteInput;
 
-    TFilter elementFilter = filter[0UL];
+        case '[':
+        case '{':
+          if (depth == checkedDepth) {
+            if (nestingLimit.reached())
+              return DeserializationError::TooDeep;
+            nestingLimit = nestingLimit.decrement();
+            checkedDepth++;
+          }
+          depth++;
+          move();
+          break;
 
-    // Read each value
-    for (;;) {
-      if (elementFilter.allow()) {
-        // Allocate slot in array
-        VariantData* value = array.addElement(resources_);
-        if (!value)
-          return DeserializationError::NoMemory;
-
-        // 1 - Parse value
-        err = parseVariant(*value, elementFilter, nestingLimit.decrement());
-        if (err)
-          return err;
-      } else {
-        err = skipVariant(nestingLimit.decrement());
-        if (err)
-          return err;
-      }
+        case ']':
+        case '}':
+          move();
+          if (--depth == 0)
+            return DeserializationError::Ok;
+          break;
 
-      // 2 - Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
+        case '\"':
+        case '\'':
+          err = skipQuotedString();
+          if (err)
+            return err;
+          break;
 
-      // 3 - More values?
-      if (eat(']'))
-        return DeserializationError::Ok;
-      if (!eat(','))
-        return DeserializationError::InvalidInput;
+        default:
+          move();
+          break;
+      }
     }
+#endif
   }
 
   DeserializationError::Code skipArray(
@@ -230,90 +170,6 @@ class JsonDeserializer {
     }
   }
 
-  template <typename TFilter>
-  DeserializationError::Code parseObject(
-      ObjectData& object, TFilter filter,
-      DeserializationOption::NestingLimit nestingLimit) {
-    DeserializationError::Code err;
-
-    if (nestingLimit.reached())
-      return DeserializationError::TooDeep;
-
-    // Skip opening brace
-    ARDUINOJSON_ASSERT(current() == '{');
-    move();
-
-    // Skip spaces
-    err = skipSpacesAndComments();
-    if (err)
-      return err;
-
-    // Empty object?
-    if (eat('}'))
-      return DeserializationError::Ok;
-
-    // Read each key value pair
-    for (;;) {
-      // Parse key
-      err = parseKey();
-      if (err)
-        return err;
-
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-
-      // Colon
-      if (!eat(':'))
-        return DeserializationError::InvalidInput;
-
-      JsonString key = stringBuilder_.str();
-
-      TFilter memberFilter = filter[key.c_str()];
-
-      if (memberFilter.allow()) {
-        auto member = object.getMember(adaptString(key.c_str()), resources_);
-        if (!member) {
-          // Save key in memory pool.
-          auto savedKey = stringBuilder_.save();
-
-          // Allocate slot in object
-          member = object.addMember(savedKey, resources_);
-          if (!member)
-            return DeserializationError::NoMemory;
-        } else {
-          member->setNull(resources_);
-        }
-
-        // Parse value
-        err = parseVariant(*member, memberFilter, nestingLimit.decrement());
-        if (err)
-          return err;
-      } else {
-        err = skipVariant(nestingLimit.decrement());
-        if (err)
-          return err;
-      }
-
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-
-      // More keys/values?
-      if (eat('}'))
-        return DeserializationError::Ok;
-      if (!eat(','))
-        return DeserializationError::InvalidInput;
-
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-    }
-  }
-
   DeserializationError::Code skipObject(
       DeserializationOption::NestingLimit nestingLimit) {
     DeserializationError::Code err;
@@ -373,7 +229,7 @@ class JsonDeserializer {
   }
 
   DeserializationError::Code parseKey() {
-    stringBuilder_.startString();
+    stringStorage_.startString();
     if (isQuote(current())) {
       return parseQuotedString();
     } else {
@@ -381,20 +237,6 @@ class JsonDeserializer {
     }
   }
 
-  DeserializationError::Code parseStringValue(VariantData& variant) {
-    DeserializationError::Code err;
-
-    stringBuilder_.startString();
-
-    err = parseQuotedString();
-    if (err)
-      return err;
-
-    variant.setOwnedString(stringBuilder_.save());
-
-    return DeserializationError::Ok;
-  }
-
   DeserializationError::Code parseQuotedString() {
 #if ARDUINOJSON_DECODE_UNICODE
     Utf16::Codepoint codepoint;
@@ -404,6 +246,16 @@ class JsonDeserializer {
 
     move();
     for (;;) {
+      // Copy the characters that don't need special treatment in one go
+      const char* end;
+      const char* chunk = latch_.peek(end);
+      if (chunk) {
+        size_t n = size_t(
+            findFirst(chunk, end, SpecialCharInString(stopChar)) - chunk);
+        stringStorage_.append(chunk, n);
+        latch_.advance(n);
+      }
+
       char c = current();
       move();
       if (c == stopChar)
@@ -426,9 +278,9 @@ class JsonDeserializer {
           if (err)
             return err;
           if (codepoint.append(codeunit))
-            Utf8::encodeCodepoint(codepoint.value(), stringBuilder_);
+            Utf8::encodeCodepoint(codepoint.value(), stringStorage_);
 #else
-          stringBuilder_.append('\\');
+          stringStorage_.append('\\');
 #endif
           continue;
         }
@@ -440,10 +292,10 @@ class JsonDeserializer {
         move();
       }
 
-      stringBuilder_.append(c);
+      stringStorage_.append(c);
     }
 
-    if (!stringBuilder_.isValid())
+    if (!stringStorage_.isValid())
       return DeserializationError::NoMemory;
 
     return DeserializationError::Ok;
@@ -456,14 +308,14 @@ class JsonDeserializer {
     if (canBeInNonQuotedString(c)) {  // no quotes
       do {
         move();
-        stringBuilder_.append(c);
+        stringStorage_.append(c);
         c = current();
       } while (canBeInNonQuotedString(c));
     } else {
       return DeserializationError::InvalidInput;
     }
 
-    if (!stringBuilder_.isValid())
+    if (!stringStorage_.isValid())
       return DeserializationError::NoMemory;
 
     return DeserializationError::Ok;
@@ -482,6 +334,12 @@ class JsonDeserializer {
 
     move();
     for (;;) {
+      const char* end;
+      const char* chunk = latch_.peek(end);
+      if (chunk)
+        latch_.advance(size_t(
+            findFirst(chunk, end, SpecialCharInString(stopChar)) - chunk));
+
       char c = current();
       move();
       if (c == stopChar)
@@ -506,7 +364,22 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
+  // Parses the number in a VariantData, which doesn't need any allocation
   DeserializationError::Code parseNumericValue(VariantData& result) {
+    // Parse the number directly in the input if possible...
+    const char* end;
+    const char* s = latch_.peek(end);
+    if (s) {
+      const char* p = s;
+      while (p != end && canBeInNumber(*p))
+        p++;
+      if (!parseNumber(s, p, result))
+        return DeserializationError::InvalidInput;
+      latch_.advance(size_t(p - s));
+      return DeserializationError::Ok;
+    }
+
+    // ...otherwise, copy it to the buffer
     uint8_t n = 0;
 
     char c = current();
@@ -515,9 +388,8 @@ class JsonDeserializer {
       buffer_[n++] = c;
       c = current();
     }
-    buffer_[n] = 0;
 
-    if (!parseNumber(buffer_, result))
+    if (!parseNumber(buffer_, buffer_ + n, result))
       return DeserializationError::InvalidInput;
 
     return DeserializationError::Ok;
@@ -547,35 +419,6 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
-  static inline bool isBetween(char c, char min, char max) {
-    return min <= c && c <= max;
-  }
-
-  static inline bool canBeInNumber(char c) {
-    return isBetween(c, '0', '9') || c == '+' || c == '-' || c == '.' ||
-#if ARDUINOJSON_ENABLE_NAN || ARDUINOJSON_ENABLE_INFINITY
-           isBetween(c, 'A', 'Z') || isBetween(c, 'a', 'z');
-#else
-           c == 'e' || c == 'E';
-#endif
-  }
-
-  static inline bool canBeInNonQuotedString(char c) {
-    return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
-           isBetween(c, 'A', 'Z');
-  }
-
-  static inline bool isQuote(char c) {
-    return c == '\'' || c == '\"';
-  }
-
-  static inline uint8_t decodeHex(char c) {
-    if (c < 'A')
-      return uint8_t(c - '0');
-    c = char(c & ~0x20);  // uppercase
-    return uint8_t(c - 'A' + 10);
-  }
-
   DeserializationError::Code skipSpacesAndComments() {
     for (;;) {
       switch (current()) {
@@ -655,41 +498,12 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
-  StringBuilder stringBuilder_;
+  TStringStorage stringStorage_;
   bool foundSomething_;
   Latch<TReader> latch_;
-  ResourceManager* resources_;
   char buffer_[64];  // using a member instead of a local variable because it
                      // ended in the recursive path after compiler inlined the
                      // code
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
-
-ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
-
-// Parses a JSON input, filters, and puts the result in a JsonDocument.
-// https://arduinojson.org/v7/api/json/deserializejson/
-template <typename TDestination, typename... Args>
-typename detail::enable_if<
-    detail::is_deserialize_destination<TDestination>::value,
-    DeserializationError>::type
-deserializeJson(TDestination&& dst, Args&&... args) {
-  using namespace detail;
-  return deserialize<JsonDeserializer>(detail::forward<TDestination>(dst),
-                                       detail::forward<Args>(args)...);
-}
-
-// Parses a JSON input, filters, and puts the result in a JsonDocument.
-// https://arduinojson.org/v7/api/json/deserializejson/
-template <typename TDestination, typename TChar, typename... Args>
-typename detail::enable_if<
-    detail::is_deserialize_destination<TDestination>::value,
-    DeserializationError>::type
-deserializeJson(TDestination&& dst, TChar* input, Args&&... args) {
-  using namespace detail;
-  return deserialize<JsonDeserializer>(detail::forward<TDestination>(dst),
-                                       input, detail::forward<Args>(args)...);
-}
-
-ARDUINOJSON_END_PUBLIC_NAMESPACE
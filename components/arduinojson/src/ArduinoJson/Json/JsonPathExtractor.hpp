@@ -0,0 +1,418 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Json/JsonEventParser.hpp>
+#include <ArduinoJson/Variant/JsonVariantConst.hpp>
+
+#include <string.h>  // strcmp
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A step of a JsonPath: either an object key or an array index.
+class JsonPathStep {
+ public:
+  constexpr JsonPathStep(const char* key) : key_(key), index_(0) {}
+
+  // A negative index fails to compile in a constant expression, and matches
+  // nothing otherwise
+  constexpr JsonPathStep(int index)
+      : key_(nullptr), index_(index >= 0 ? size_t(index) : negativeIndex()) {}
+
+  bool matches(const char* key) const {
+    return key_ && strcmp(key_, key) == 0;
+  }
+
+  bool matches(size_t index) const {
+    return !key_ && index_ == index;
+  }
+
+ private:
+  // Not constexpr on purpose
+  static size_t negativeIndex() {
+    return size_t(-1);  // an array can't be that long
+  }
+
+  const char* key_;
+  size_t index_;
+};
+
+// The location of a value in a JSON document.
+// Create it with jsonPath().
+template <size_t N>
+struct JsonPath {
+  JsonPathStep steps[N];
+};
+
+// Creates the path of a value, for extractJson().
+template <typename... TSteps>
+constexpr JsonPath<sizeof...(TSteps)> jsonPath(TSteps... steps) {
+  static_assert(sizeof...(TSteps) > 0, "A JsonPath needs at least one step");
+  return {{JsonPathStep(steps)...}};
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Copies the extracted value to the destination variable.
+// Returns false if the value doesn't fit.
+template <typename T>
+struct JsonPathAssigner {
+  // The strings only live during the parsing
+  static_assert(!is_pointer<T>::value && !is_same<T, JsonString>::value,
+                "extractJson() can't store a pointer nor a JsonString; use a "
+                "char array instead");
+
+  static bool assign(void* dst, JsonVariantConst src) {
+    if (src.is<T>())
+      *static_cast<T*>(dst) = src.as<T>();
+    return true;
+  }
+};
+
+template <size_t N>
+struct JsonPathAssigner<char[N]> {
+  static bool assign(void* dst, JsonVariantConst src) {
+    if (!src.is<JsonString>())
+      return true;
+    JsonString s = src.as<JsonString>();
+    if (s.size() >= N)
+      return false;
+    memcpy(dst, s.c_str(), s.size());
+    static_cast<char*>(dst)[s.size()] = 0;
+    return true;
+  }
+};
+
+struct JsonPathTarget {
+  const JsonPathStep* steps;
+  size_t size;
+  void* value;
+  bool (*assign)(void* dst, JsonVariantConst src);
+};
+
+inline void fillJsonPathTargets(JsonPathTarget*) {}
+
+template <size_t N, typename T, typename... TRest>
+inline void fillJsonPathTargets(JsonPathTarget* targets,
+                                const JsonPath<N>& path, T& value,
+                                TRest&... rest) {
+  targets->steps = path.steps;
+  targets->size = N;
+  targets->value = &value;
+  targets->assign = JsonPathAssigner<T>::assign;
+  fillJsonPathTargets(targets + 1, rest...);
+}
+
+using JsonPathMask = uint32_t;
+
+const size_t JsonPathMaxTargets = sizeof(JsonPathMask) * 8;
+
+template <typename TReader>
+class JsonPathExtractor : JsonLexer<TReader, EventStringStorage> {
+  using base = JsonLexer<TReader, EventStringStorage>;
+
+ public:
+  JsonPathExtractor(TReader reader) : base(EventStringStorage(), reader) {}
+
+  DeserializationError parse(const JsonPathTarget* targets, size_t count,
+                             DeserializationOption::NestingLimit nestingLimit) {
+    ARDUINOJSON_ASSERT(count <= JsonPathMaxTargets);
+    targets_ = targets;
+    count_ = count;
+    remaining_ = mask(count);
+    return parseVariant(remaining_, 0, nestingLimit);
+  }
+
+ private:
+  using base::current;
+  using base::eat;
+  using base::move;
+  using base::parseKey;
+  using base::parseNumericValue;
+  using base::parseQuotedString;
+  using base::skipCollection;
+  using base::skipKeyword;
+  using base::skipSpacesAndComments;
+  using base::skipVariant;
+  using base::stringStorage_;
+
+  static JsonPathMask mask(size_t count) {
+    return count < JsonPathMaxTargets ? (JsonPathMask(1) << count) - 1
+                                      : JsonPathMask(-1);
+  }
+
+  static bool contains(JsonPathMask targets, size_t i) {
+    return (targets >> i) & 1;
+  }
+
+  // candidates: the targets whose path matches up to this depth
+  DeserializationError::Code parseVariant(
+      JsonPathMask candidates, size_t depth,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    JsonPathMask leaves = 0, branches = 0;
+    for (size_t i = 0; i < count_; i++) {
+      if (!contains(candidates, i))
+        continue;
+      if (targets_[i].size == depth)
+        leaves |= JsonPathMask(1) << i;
+      else
+        branches |= JsonPathMask(1) << i;
+    }
+
+    switch (current()) {
+      case '[':
+        if (!branches)
+          return skipCollection(nestingLimit);
+        return parseArray(branches, depth, nestingLimit);
+
+      case '{':
+        if (!branches)
+          return skipCollection(nestingLimit);
+        return parseObject(branches, depth, nestingLimit);
+
+      default:
+        if (!leaves)
+          return skipVariant(nestingLimit);
+        return parseValue(leaves);
+    }
+  }
+
+  DeserializationError::Code parseValue(JsonPathMask leaves) {
+    DeserializationError::Code err;
+    VariantData value;
+
+    switch (current()) {
+      case '\"':
+      case '\'':
+        stringStorage_.startString();
+        err = parseQuotedString();
+        if (err)
+          return err;
+        value.setLinkedString(stringStorage_.str().c_str());
+        break;
+
+      case 't':
+        err = skipKeyword("true");
+        value.setBoolean(true);
+        break;
+
+      case 'f':
+        err = skipKeyword("false");
+        value.setBoolean(false);
+        break;
+
+      case 'n':
+        err = skipKeyword("null");
+        break;
+
+      default:
+        err = parseNumericValue(value);
+        break;
+    }
+
+    if (err)
+      return err;
+
+    for (size_t i = 0; i < count_; i++) {
+      if (!contains(leaves, i))
+        continue;
+      if (!targets_[i].assign(targets_[i].value,
+                              JsonVariantConst(&value, nullptr)))
+        return DeserializationError::NoMemory;
+    }
+    remaining_ &= ~leaves;
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseArray(
+      JsonPathMask branches, size_t depth,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty array?
+    if (eat(']'))
+      return DeserializationError::Ok;
+
+    // Read each value
+    for (size_t index = 0;; index++) {
+      JsonPathMask children = 0;
+      for (size_t i = 0; i < count_; i++) {
+        if (contains(branches, i) && targets_[i].steps[depth].matches(index))
+          children |= JsonPathMask(1) << i;
+      }
+
+      if (children)
+        err = parseVariant(children, depth + 1, nestingLimit.decrement());
+      else
+        err = skipVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Everything extracted?
+      if (!remaining_)
+        return DeserializationError::Ok;
+
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      if (eat(']'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  DeserializationError::Code parseObject(
+      JsonPathMask branches, size_t depth,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (eat('}'))
+      return DeserializationError::Ok;
+
+    // Read each key value pair
+    for (;;) {
+      JsonPathMask children = 0;
+
+      // A key that doesn't fit in the buffer can't match any path
+      err = parseKey();
+      if (err == DeserializationError::Ok) {
+        const char* key = stringStorage_.str().c_str();
+        for (size_t i = 0; i < count_; i++) {
+          if (contains(branches, i) && targets_[i].steps[depth].matches(key))
+            children |= JsonPathMask(1) << i;
+        }
+      } else if (err != DeserializationError::NoMemory) {
+        return err;
+      }
+
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      if (!eat(':'))
+        return DeserializationError::InvalidInput;
+
+      if (children)
+        err = parseVariant(children, depth + 1, nestingLimit.decrement());
+      else
+        err = skipVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Everything extracted?
+      if (!remaining_)
+        return DeserializationError::Ok;
+
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      if (eat('}'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
+  const JsonPathTarget* targets_ = nullptr;
+  size_t count_ = 0;
+  JsonPathMask remaining_ = 0;  // the targets not extracted yet
+};
+
+template <typename TReader, typename... TArgs>
+DeserializationError doExtractJson(TReader reader,
+                                   TArgs&&... pathsAndValues) {
+  static_assert(sizeof...(TArgs) % 2 == 0,
+                "extractJson() expects pairs of path and value");
+  static_assert(sizeof...(TArgs) / 2 <= JsonPathMaxTargets,
+                "Too many paths for extractJson()");
+  JsonPathTarget targets[sizeof...(TArgs) / 2];
+  fillJsonPathTargets(targets, pathsAndValues...);
+  return JsonPathExtractor<TReader>(reader).parse(
+      targets, sizeof...(TArgs) / 2, DeserializationOption::NestingLimit());
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Extracts the values at the specified paths in a single pass, without
+// building a JsonDocument nor allocating. Everything else is skipped, and the
+// parsing stops as soon as all the values are found.
+// The arguments after the input are pairs of JsonPath and destination
+// variable; a variable is left untouched if its path is missing or if the
+// value has a different type. Strings are copied to char arrays; they must not
+// exceed ARDUINOJSON_EVENT_STRING_SIZE characters.
+template <typename TInput, typename... TArgs,
+          typename = typename detail::enable_if<!detail::is_integral<
+              typename detail::first_or_void<TArgs...>::type>::value>::type>
+DeserializationError extractJson(TInput&& input,
+                                 TArgs&&... pathsAndValues) {
+  using namespace detail;
+  return doExtractJson(makeReader(detail::forward<TInput>(input)),
+                       pathsAndValues...);
+}
+
+// Extracts the values at the specified paths in a single pass, without
+// building a JsonDocument nor allocating.
+template <typename TChar, typename... TArgs,
+          typename = typename detail::enable_if<!detail::is_integral<
+              typename detail::first_or_void<TArgs...>::type>::value>::type>
+DeserializationError extractJson(TChar* input, TArgs&&... pathsAndValues) {
+  using namespace detail;
+  return doExtractJson(makeReader(input), pathsAndValues...);
+}
+
+// Extracts the values at the specified paths in a single pass, without
+// building a JsonDocument nor allocating.
+template <typename TChar, typename... TArgs>
+DeserializationError extractJson(TChar* input, size_t inputSize,
+                                 TArgs&&... pathsAndValues) {
+  using namespace detail;
+  return doExtractJson(makeReader(input, inputSize), pathsAndValues...);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -39,6 +39,21 @@ class JsonSerializer : public VariantDataVisitor<size_t> {
     return bytesWritten();
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  size_t visit(const PackedArray& array) {
+    write('[');
+
+    for (size_t i = 0; i < array.size; i++) {
+      if (i > 0)
+        write(',');
+      array.accept(i, *this);
+    }
+
+    write(']');
+    return bytesWritten();
+  }
+#endif
+
   size_t visit(const ObjectData& object) {
     write('{');
 
@@ -0,0 +1,339 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Filter.hpp>
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Json/JsonLexer.hpp>
+#include <ArduinoJson/Memory/ResourceCounter.hpp>
+#include <ArduinoJson/Memory/StringCounter.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The first pass of DeserializationOption::ExactSize: counts what
+// JsonDeserializer would allocate for the same input and filter.
+// It only parses the numbers of the arrays that JsonDeserializer could pack
+// (see ARDUINOJSON_ENABLE_PACKED_ARRAYS); when the input is invalid, the
+// second pass reports the error.
+template <typename TReader>
+class JsonSizer : JsonLexer<TReader, StringCounter> {
+  using base = JsonLexer<TReader, StringCounter>;
+
+  // the InPlaceReader leaves the strings in the input (see makeStringStorage())
+  static const bool copiesStrings = !is_same<TReader, InPlaceReader>::value;
+
+ public:
+  JsonSizer(ResourceCounter* counter, TReader reader)
+      : base(StringCounter(counter->allocator()), reader), counter_(counter) {}
+
+  template <typename TFilter>
+  DeserializationError parse(TFilter filter,
+                             DeserializationOption::NestingLimit nestingLimit) {
+    return parseVariant(filter, nestingLimit);
+  }
+
+ private:
+  using base::current;
+  using base::eat;
+  using base::move;
+  using base::parseKey;
+  using base::parseNumericValue;
+  using base::parseQuotedString;
+  using base::skipCollection;
+  using base::skipQuotedString;
+  using base::skipSpacesAndComments;
+  using base::skipVariant;
+  using base::stringStorage_;
+
+  template <typename TFilter>
+  DeserializationError::Code parseVariant(
+      TFilter filter, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (current()) {
+      case '[':
+        if (filter.allowArray())
+          return parseArray(filter, nestingLimit);
+        else
+          return skipCollection(nestingLimit);
+
+      case '{':
+        if (filter.allowObject())
+          return parseObject(filter, nestingLimit);
+        else
+          return skipCollection(nestingLimit);
+
+      case '\"':
+      case '\'':
+        if (filter.allowValue())
+          return parseStringValue();
+        else
+          return skipQuotedString();
+
+      default:
+        return skipVariant(nestingLimit);
+    }
+  }
+
+  template <typename TFilter>
+  DeserializationError::Code parseArray(
+      TFilter filter, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty array?
+    if (eat(']'))
+      return DeserializationError::Ok;
+
+    TFilter elementFilter = filter[0UL];
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    size_t count = 0;
+    uint8_t packedType = PackedArray::Invalid;
+#endif
+
+    // Read each value
+    for (;;) {
+      if (elementFilter.allow()) {
+        counter_->addSlot();
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+        if (count < PackedArray::minElements && elementFilter.allowValue()) {
+          uint8_t type;
+          err = parseVariant(elementFilter, nestingLimit.decrement(), type);
+          packedType = count ? PackedArray::merge(packedType, type) : type;
+          count++;
+        } else {
+          err = parseVariant(elementFilter, nestingLimit.decrement());
+        }
+#else
+        err = parseVariant(elementFilter, nestingLimit.decrement());
+#endif
+      } else {
+        err = skipVariant(nestingLimit.decrement());
+      }
+      if (err)
+        return err;
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+      // Like JsonDeserializer::parseArray(), which packs the array here
+      if (count == PackedArray::minElements &&
+          packedType != PackedArray::Invalid) {
+        counter_->freeSlots(count);
+        err = parsePackedElements(packedType, count, elementFilter,
+                                  nestingLimit);
+        if (err || packedType != PackedArray::Invalid)
+          return err;
+        // the array was unpacked, so we continue with the slots
+      }
+#endif
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More values?
+      if (eat(']'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // Same as parseVariant(), but also returns the type of packed array that
+  // can store the value (see VariantData::packArray()).
+  // Only called when the filter allows the values.
+  template <typename TFilter>
+  DeserializationError::Code parseVariant(
+      TFilter filter, DeserializationOption::NestingLimit nestingLimit,
+      uint8_t& packedType) {
+    packedType = PackedArray::Invalid;
+
+    DeserializationError::Code err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (current()) {
+      case '[':
+      case '{':
+      case '\"':
+      case '\'':
+      case 't':
+      case 'f':
+      case 'n':
+        return parseVariant(filter, nestingLimit);
+
+      default: {
+        VariantData value;
+        err = parseNumericValue(value);
+        packedType = value.packedType();
+        return err;
+      }
+    }
+  }
+
+  // Like JsonDeserializer::parsePackedElements(), counts nothing for the
+  // packed elements, until an element that the packed array can't store
+  // moves them back to slots, in which case it sets packedType to Invalid.
+  template <typename TFilter>
+  DeserializationError::Code parsePackedElements(
+      uint8_t& packedType, size_t size, TFilter elementFilter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    for (;;) {
+      // 1 - Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // 2 - More values?
+      if (eat(']'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // 3 - Parse value
+      char c = current();
+      if (c != '-' && !isBetween(c, '0', '9')) {
+        packedType = PackedArray::Invalid;
+        counter_->addSlots(size + 1);  // see VariantData::unpackArray()
+        return parseVariant(elementFilter, nestingLimit.decrement());
+      }
+
+      VariantData value;
+      err = parseNumericValue(value);
+      if (err)
+        return err;
+      packedType = PackedArray::merge(packedType, value.packedType());
+      if (packedType == PackedArray::Invalid) {
+        counter_->addSlots(size + 1);  // see VariantData::addPackedElement()
+        return DeserializationError::Ok;
+      }
+      size++;
+    }
+  }
+#endif
+
+  template <typename TFilter>
+  DeserializationError::Code parseObject(
+      TFilter filter, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (eat('}'))
+      return DeserializationError::Ok;
+
+    // Read each key value pair
+    for (;;) {
+      // Parse key
+      err = parseKey();
+      if (err)
+        return err;
+      if (copiesStrings)
+        counter_->buildString(stringStorage_);
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // Colon
+      if (!eat(':'))
+        return DeserializationError::InvalidInput;
+
+      if (stringStorage_.isComplete())
+        err = parseMember(filter[stringStorage_.str().c_str()],
+                          nestingLimit.decrement());
+      else  // couldn't be copied, count it as if the filter allowed it
+        err = parseMember(AllowAllFilter(), nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More keys/values?
+      if (eat('}'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
+  // Counts the member whose key was just parsed.
+  // A duplicate key is counted twice, so the result is an upper bound.
+  template <typename TFilter>
+  DeserializationError::Code parseMember(
+      TFilter memberFilter, DeserializationOption::NestingLimit nestingLimit) {
+    if (!memberFilter.allow())
+      return skipVariant(nestingLimit);
+    counter_->addSlot();
+    if (copiesStrings)
+      counter_->saveString(stringStorage_);
+    return parseVariant(memberFilter, nestingLimit);
+  }
+
+  DeserializationError::Code parseStringValue() {
+    DeserializationError::Code err;
+
+    stringStorage_.startString();
+
+    err = parseQuotedString();
+    if (err)
+      return err;
+
+    if (copiesStrings) {
+      counter_->buildString(stringStorage_);
+      if (!VariantData::fitsTinyString(stringStorage_.size()))
+        counter_->saveString(stringStorage_);
+    }
+
+    return DeserializationError::Ok;
+  }
+
+  ResourceCounter* counter_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,545 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/CharacterClasses.hpp>
+#include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/StringScanner.hpp>
+#include <ArduinoJson/Json/Utf16.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Memory/StringBuilder.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses a JSON input pushed in chunks of any size, like the ones received by
+// an HTTP client callback, so the input never needs to be buffered.
+// The parser saves its state between the calls to feed(), so a chunk can end
+// anywhere, even in the middle of a string or a number.
+// Like deserializeJson(), it clears the document and ignores the characters
+// that follow the root value.
+//
+//   JsonStreamDeserializer parser(doc);
+//   parser.feed(chunk, chunkSize);  // for each chunk
+//   DeserializationError err = parser.finish();
+class JsonStreamDeserializer {
+ public:
+  explicit JsonStreamDeserializer(
+      JsonDocument& doc, DeserializationOption::NestingLimit nestingLimit =
+                             DeserializationOption::NestingLimit())
+      : doc_(&doc),
+        resources_(detail::VariantAttorney::getResourceManager(doc)),
+        root_(detail::VariantAttorney::getOrCreateData(doc)),
+        stringStorage_(resources_),
+        nestingLimit_(nestingLimit) {
+    doc.clear();
+  }
+
+  ~JsonStreamDeserializer() {
+    if (stack_)
+      resources_->allocator()->deallocate(stack_);
+  }
+
+  JsonStreamDeserializer(const JsonStreamDeserializer&) = delete;
+  JsonStreamDeserializer& operator=(const JsonStreamDeserializer&) = delete;
+
+  // Parses the next chunk of the input.
+  // Returns the first error found so far: once an error occurs, the following
+  // chunks are ignored.
+  DeserializationError feed(const char* chunk, size_t length) {
+    const char* end = chunk + length;
+    while (chunk != end && !error_)
+      chunk = step(chunk, end);
+    return error_;
+  }
+
+  // Signals the end of the input and returns the result of the parsing.
+  DeserializationError finish() {
+    if (!error_ && state_ == InNumber)
+      endNumber();
+    if (!error_ && state_ != Done)
+      error_ = endOfInputError();
+    detail::shrinkJsonDocument(*doc_);
+    return error_;
+  }
+
+ private:
+  enum State : uint8_t {
+    ExpectingValue,
+    ExpectingFirstValue,  // after '[': a value or ']'
+    ExpectingKey,
+    ExpectingFirstKey,  // after '{': a key or '}'
+    ExpectingColon,
+    ExpectingSeparator,  // after a value in a collection: ',', ']' or '}'
+    InString,
+    InEscapeSequence,
+    InUnicodeEscape,
+    InNonQuotedKey,
+    InNumber,
+    InKeyword,  // true, false, or null
+#if ARDUINOJSON_ENABLE_COMMENTS
+    InCommentStart,  // after '/'
+    InBlockComment,
+    InBlockCommentStar,
+    InLineComment,
+#endif
+    Done,
+  };
+
+  // A collection being parsed, with the nesting limit of its parent
+  struct Frame {
+    detail::VariantData* collection;
+    DeserializationOption::NestingLimit nestingLimit;
+  };
+
+  // Returns the error for an input that ends before the root value
+  DeserializationError::Code endOfInputError() const {
+#if ARDUINOJSON_ENABLE_COMMENTS
+    switch (state_) {
+      case InCommentStart:  // a '/' must start a comment
+        return DeserializationError::InvalidInput;
+      case InBlockComment:
+      case InBlockCommentStar:
+      case InLineComment:
+        return DeserializationError::IncompleteInput;
+      default:
+        break;
+    }
+#endif
+    return foundSomething_ ? DeserializationError::IncompleteInput
+                           : DeserializationError::EmptyInput;
+  }
+
+  static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+  }
+
+  // Processes the character at p, or more when it can do it in bulk.
+  // Returns the position of the next character to process.
+  const char* step(const char* p, const char* end) {
+    char c = *p;
+
+    switch (state_) {
+      case ExpectingValue:
+      case ExpectingFirstValue:
+      case ExpectingKey:
+      case ExpectingFirstKey:
+      case ExpectingColon:
+      case ExpectingSeparator:
+        if (isSpace(c))
+          return p + 1;
+#if ARDUINOJSON_ENABLE_COMMENTS
+        if (c == '/') {
+          stateBeforeComment_ = state_;
+          state_ = InCommentStart;
+          return p + 1;
+        }
+#endif
+        foundSomething_ = true;
+        break;
+
+      case InString:
+        return parseStringChunk(p, end);
+
+      case InEscapeSequence:
+        parseEscapeSequence(c);
+        return p + 1;
+
+      case InUnicodeEscape:
+        parseUnicodeEscape(c);
+        return p + 1;
+
+      case InNonQuotedKey:
+        if (detail::canBeInNonQuotedString(c)) {
+          stringStorage_.append(c);
+          return p + 1;
+        }
+        endKey();
+        return p;  // the next state processes c
+
+      case InNumber:
+        if (detail::canBeInNumber(c)) {
+          if (numberSize_ == sizeof(number_) - 1)
+            error_ = DeserializationError::InvalidInput;
+          else
+            number_[numberSize_++] = c;
+          return p + 1;
+        }
+        endNumber();
+        // like deserializeJson(), reject anything after a root number
+        if (state_ == Done)
+          error_ = DeserializationError::InvalidInput;
+        return p;  // the next state processes c
+
+      case InKeyword:
+        parseKeyword(c);
+        return p + 1;
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+      case InCommentStart:
+        if (c == '*')
+          state_ = InBlockComment;
+        else if (c == '/')
+          state_ = InLineComment;
+        else
+          error_ = DeserializationError::InvalidInput;
+        return p + 1;
+
+      case InBlockComment:
+        if (c == '*')
+          state_ = InBlockCommentStar;
+        return p + 1;
+
+      case InBlockCommentStar:
+        if (c == '/')
+          state_ = stateBeforeComment_;
+        else if (c != '*')
+          state_ = InBlockComment;
+        return p + 1;
+
+      case InLineComment:
+        if (c == '\n')
+          state_ = stateBeforeComment_;
+        return p + 1;
+#endif
+
+      case Done:
+        return end;
+    }
+
+    switch (state_) {
+      case ExpectingFirstValue:
+        if (c == ']') {
+          endCollection();
+          break;
+        }
+        if (addElement())
+          startValue(c);
+        break;
+
+      case ExpectingValue:
+        startValue(c);
+        break;
+
+      case ExpectingFirstKey:
+        if (c == '}') {
+          endCollection();
+          break;
+        }
+        startKey(c);
+        break;
+
+      case ExpectingKey:
+        startKey(c);
+        break;
+
+      case ExpectingColon:
+        if (c == ':')
+          addMember();
+        else
+          error_ = DeserializationError::InvalidInput;
+        break;
+
+      default:
+        ARDUINOJSON_ASSERT(state_ == ExpectingSeparator);
+        if (c == ',') {
+          if (!currentIsArray())
+            state_ = ExpectingKey;
+          else if (addElement())
+            state_ = ExpectingValue;
+        } else if (c == (currentIsArray() ? ']' : '}'))
+          endCollection();
+        else
+          error_ = DeserializationError::InvalidInput;
+        break;
+    }
+    return p + 1;
+  }
+
+  void startValue(char c) {
+    detail::VariantData* variant = depth_ > 0 ? slot_ : root_;
+    ARDUINOJSON_ASSERT(variant != nullptr);
+
+    switch (c) {
+      case '[':
+        variant->toArray();
+        startCollection(variant, ExpectingFirstValue);
+        break;
+
+      case '{':
+        variant->toObject();
+        startCollection(variant, ExpectingFirstKey);
+        break;
+
+      case '\"':
+      case '\'':
+        slot_ = variant;
+        startString(c, false);
+        break;
+
+      case 't':
+        variant->setBoolean(true);
+        startKeyword("true");
+        break;
+
+      case 'f':
+        variant->setBoolean(false);
+        startKeyword("false");
+        break;
+
+      case 'n':
+        // the variant should already by null, except if the same object key was
+        // used twice, as in {"a":1,"a":null}
+        startKeyword("null");
+        break;
+
+      default:
+        if (!detail::canBeInNumber(c)) {
+          error_ = DeserializationError::InvalidInput;
+          break;
+        }
+        slot_ = variant;
+        number_[0] = c;
+        numberSize_ = 1;
+        state_ = InNumber;
+        break;
+    }
+  }
+
+  void endValue() {
+    state_ = depth_ > 0 ? ExpectingSeparator : Done;
+  }
+
+  void startCollection(detail::VariantData* collection, State state) {
+    if (nestingLimit_.reached()) {
+      error_ = DeserializationError::TooDeep;
+      return;
+    }
+    if (depth_ == stackCapacity_ && !growStack()) {
+      error_ = DeserializationError::NoMemory;
+      return;
+    }
+    stack_[depth_].collection = collection;
+    stack_[depth_].nestingLimit = nestingLimit_;
+    depth_++;
+    nestingLimit_ = nestingLimit_.decrement();
+    state_ = state;
+  }
+
+  void endCollection() {
+    ARDUINOJSON_ASSERT(depth_ > 0);
+    depth_--;
+    nestingLimit_ = stack_[depth_].nestingLimit;
+    endValue();
+  }
+
+  bool currentIsArray() const {
+    ARDUINOJSON_ASSERT(depth_ > 0);
+    return stack_[depth_ - 1].collection->isArray();
+  }
+
+  bool growStack() {
+    size_t capacity = stackCapacity_ ? stackCapacity_ * 2U : 8;
+    if (capacity > 0xFF)
+      capacity = 0xFF;  // the nesting limit can't be higher
+    size_t size = capacity * sizeof(Frame);
+    void* p = stack_ ? resources_->allocator()->reallocate(stack_, size)
+                     : resources_->allocator()->allocate(size);
+    if (!p)
+      return false;
+    stack_ = static_cast<Frame*>(p);
+    stackCapacity_ = uint8_t(capacity);
+    return true;
+  }
+
+  void startKey(char c) {
+    if (detail::isQuote(c)) {
+      startString(c, true);
+    } else if (detail::canBeInNonQuotedString(c)) {
+      stringStorage_.startString();
+      stringStorage_.append(c);
+      state_ = InNonQuotedKey;
+    } else {
+      error_ = DeserializationError::InvalidInput;
+    }
+  }
+
+  // Like deserializeJson(), the elements are added before their values, as soon
+  // as the ',' tells that there is one, so that a partial document matches.
+  bool addElement() {
+    slot_ = stack_[depth_ - 1].collection->asArray()->addElement(resources_);
+    if (!slot_) {
+      error_ = DeserializationError::NoMemory;
+      return false;
+    }
+    return true;
+  }
+
+  void endKey() {
+    if (!stringStorage_.isValid()) {
+      error_ = DeserializationError::NoMemory;
+      return;
+    }
+    state_ = ExpectingColon;
+  }
+
+  // Adds the member of the key in stringStorage_ once the ':' is read, so that
+  // an incomplete pair leaves the previous value of a duplicate key intact.
+  void addMember() {
+    detail::ObjectData* object = stack_[depth_ - 1].collection->asObject();
+    ARDUINOJSON_ASSERT(object != nullptr);
+
+    JsonString key = stringStorage_.str();
+    slot_ = object->getMember(detail::adaptString(key.c_str()), resources_);
+    if (!slot_) {
+      slot_ = stringStorage_.addMember(*object);
+      if (!slot_) {
+        error_ = DeserializationError::NoMemory;
+        return;
+      }
+    } else {
+      slot_->setNull(resources_);
+    }
+
+    state_ = ExpectingValue;
+  }
+
+  void startString(char stopChar, bool isKey) {
+    stringStorage_.startString();
+    stopChar_ = stopChar;
+    stringIsKey_ = isKey;
+#if ARDUINOJSON_DECODE_UNICODE
+    codepoint_ = detail::Utf16::Codepoint();
+#endif
+    state_ = InString;
+  }
+
+  const char* parseStringChunk(const char* p, const char* end) {
+    // Copy the characters that don't need special treatment in one go
+    const char* special =
+        detail::findFirst(p, end, detail::SpecialCharInString(stopChar_));
+    stringStorage_.append(p, size_t(special - p));
+    if (special == end)
+      return end;
+
+    char c = *special;
+    if (c == stopChar_)
+      endString();
+    else if (c == '\\')
+      state_ = InEscapeSequence;
+    else  // '\0'
+      error_ = DeserializationError::InvalidInput;
+    return special + 1;
+  }
+
+  void endString() {
+    if (!stringStorage_.isValid()) {
+      error_ = DeserializationError::NoMemory;
+      return;
+    }
+    if (stringIsKey_) {
+      endKey();
+    } else {
+      stringStorage_.save(slot_);
+      endValue();
+    }
+  }
+
+  void parseEscapeSequence(char c) {
+    if (c == 'u') {
+#if ARDUINOJSON_DECODE_UNICODE
+      codeunit_ = 0;
+      hexDigits_ = 0;
+      state_ = InUnicodeEscape;
+#else
+      stringStorage_.append('\\');
+      stringStorage_.append('u');
+      state_ = InString;
+#endif
+      return;
+    }
+
+    c = detail::EscapeSequence::unescapeChar(c);
+    if (c == '\0') {
+      error_ = DeserializationError::InvalidInput;
+      return;
+    }
+    stringStorage_.append(c);
+    state_ = InString;
+  }
+
+  void parseUnicodeEscape(char c) {
+#if ARDUINOJSON_DECODE_UNICODE
+    uint8_t value = detail::decodeHex(c);
+    if (value > 0x0F) {
+      error_ = DeserializationError::InvalidInput;
+      return;
+    }
+    codeunit_ = uint16_t((codeunit_ << 4) | value);
+    if (++hexDigits_ < 4)
+      return;
+    if (codepoint_.append(codeunit_))
+      detail::Utf8::encodeCodepoint(codepoint_.value(), stringStorage_);
+    state_ = InString;
+#else
+    (void)c;
+#endif
+  }
+
+  void startKeyword(const char* keyword) {
+    keyword_ = keyword + 1;  // the first character is already matched
+    state_ = InKeyword;
+  }
+
+  void parseKeyword(char c) {
+    if (c != *keyword_) {
+      error_ = DeserializationError::InvalidInput;
+      return;
+    }
+    if (*++keyword_ == '\0')
+      endValue();
+  }
+
+  void endNumber() {
+    if (!detail::parseNumber(number_, number_ + numberSize_, *slot_)) {
+      error_ = DeserializationError::InvalidInput;
+      return;
+    }
+    endValue();
+  }
+
+  JsonDocument* doc_;
+  detail::ResourceManager* resources_;
+  detail::VariantData* root_;
+  detail::VariantData* slot_ = nullptr;  // where the current value goes
+  detail::StringBuilder stringStorage_;
+  DeserializationOption::NestingLimit nestingLimit_;
+  Frame* stack_ = nullptr;
+  uint8_t depth_ = 0;
+  uint8_t stackCapacity_ = 0;
+  State state_ = ExpectingValue;
+#if ARDUINOJSON_ENABLE_COMMENTS
+  State stateBeforeComment_ = ExpectingValue;
+#endif
+  DeserializationError::Code error_ = DeserializationError::Ok;
+  bool foundSomething_ = false;
+  bool stringIsKey_ = false;
+  char stopChar_ = 0;
+#if ARDUINOJSON_DECODE_UNICODE
+  detail::Utf16::Codepoint codepoint_;
+  uint16_t codeunit_ = 0;
+  uint8_t hexDigits_ = 0;
+#endif
+  const char* keyword_ = nullptr;  // the remaining characters
+  uint8_t numberSize_ = 0;
+  char number_[64];
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
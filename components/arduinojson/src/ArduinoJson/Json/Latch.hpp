@@ -0,0 +1,123 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename TReader, typename Enable = void>
+class Latch {
+ public:
+  Latch(TReader reader) : reader_(reader), loaded_(false) {
+#if ARDUINOJSON_DEBUG
+    ended_ = false;
+#endif
+  }
+
+  void clear() {
+    loaded_ = false;
+  }
+
+  int last() const {
+    return current_;
+  }
+
+  FORCE_INLINE char current() {
+    if (!loaded_) {
+      load();
+    }
+    return current_;
+  }
+
+  // Streams can't be scanned in bulk
+  const char* peek(const char*& end) {
+    end = nullptr;
+    return nullptr;
+  }
+
+  void advance(size_t) {
+    ARDUINOJSON_ASSERT(false);
+  }
+
+ private:
+  void load() {
+    ARDUINOJSON_ASSERT(!ended_);
+    int c = reader_.read();
+#if ARDUINOJSON_DEBUG
+    if (c <= 0)
+      ended_ = true;
+#endif
+    current_ = static_cast<char>(c > 0 ? c : 0);
+    loaded_ = true;
+  }
+
+  TReader reader_;
+  char current_;  // NOLINT(clang-analyzer-optin.cplusplus.UninitializedObject)
+                  // Not initialized in constructor (+10 bytes on AVR)
+  bool loaded_;
+#if ARDUINOJSON_DEBUG
+  bool ended_;
+#endif
+};
+
+// Contiguous readers don't need a latch: the current character is the one
+// under the cursor.
+template <typename TReader>
+class Latch<TReader,
+            typename enable_if<is_contiguous_reader<TReader>::value>::type> {
+ public:
+  Latch(TReader reader) : reader_(reader) {
+#if ARDUINOJSON_DEBUG
+    ended_ = false;
+#endif
+  }
+
+  // Moves to the next character, unless the input ended
+  void clear() {
+    const char* end;
+    const char* ptr = reader_.peek(end);
+    if (end ? ptr != end : *ptr != 0)
+      reader_.advance(1);
+#if ARDUINOJSON_DEBUG
+    else
+      ended_ = true;
+#endif
+  }
+
+  char last() {
+    return get();
+  }
+
+  FORCE_INLINE char current() {
+    ARDUINOJSON_ASSERT(!ended_);
+    return get();
+  }
+
+  // Returns the unread characters, they stop at `end`, or at the first '\0'
+  // if `end` is null.
+  const char* peek(const char*& end) {
+    return reader_.peek(end);
+  }
+
+  void advance(size_t n) {
+    reader_.advance(n);
+  }
+
+ private:
+  FORCE_INLINE char get() {
+    const char* end;
+    const char* ptr = reader_.peek(end);
+    return ptr != end ? *ptr : 0;
+  }
+
+  TReader reader_;
+#if ARDUINOJSON_DEBUG
+  bool ended_;
+#endif
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
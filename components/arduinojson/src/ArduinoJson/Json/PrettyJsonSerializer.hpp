@@ -40,6 +40,26 @@ class PrettyJsonSerializer : public JsonSerializer<TWriter> {
     return this->bytesWritten();
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  size_t visit(const PackedArray& array) {
+    if (array.size > 0) {
+      base::write("[\r\n");
+      nesting_++;
+      for (size_t i = 0; i < array.size; i++) {
+        indent();
+        array.accept(i, *this);
+        base::write(i + 1 == array.size ? "\r\n" : ",\r\n");
+      }
+      nesting_--;
+      indent();
+      base::write("]");
+    } else {
+      base::write("[]");
+    }
+    return this->bytesWritten();
+  }
+#endif
+
   size_t visit(const ObjectData& object) {
     auto it = object.createIterator(base::resources_);
     if (!it.done()) {
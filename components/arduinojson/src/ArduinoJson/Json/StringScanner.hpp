@@ -0,0 +1,232 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/integer.hpp>
+
+#include <string.h>  // memcpy
+
+#if ARDUINOJSON_ENABLE_SIMD
+#  if defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#  else
+#    include <arm_neon.h>
+#  endif
+#endif
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+#if ARDUINOJSON_SIZEOF_POINTER >= 4
+// SWAR: tests one machine word at a time
+// https://graphics.stanford.edu/~seander/bithacks.html#ValueInWord
+namespace swar {
+using word_t = uint_t<ARDUINOJSON_SIZEOF_POINTER * 8>::type;
+
+const word_t ones = word_t(~word_t(0)) / 0xFF;  // 0x0101...
+const word_t highBits = word_t(ones << 7);      // 0x8080...
+
+inline word_t load(const char* p) {
+  word_t w;
+  memcpy(&w, p, sizeof(w));  // unaligned load
+  return w;
+}
+
+inline word_t repeat(char c) {
+  return word_t(ones * static_cast<unsigned char>(c));
+}
+
+// Returns a non-zero value if one of the bytes of w is zero
+inline word_t hasZero(word_t w) {
+  return (w - ones) & ~w & highBits;
+}
+
+// Returns a non-zero value if one of the bytes of w is equal to c
+inline word_t has(word_t w, char c) {
+  return hasZero(w ^ repeat(c));
+}
+}  // namespace swar
+#endif
+
+#if ARDUINOJSON_ENABLE_SIMD
+// SIMD: tests 16 bytes at a time
+namespace simd {
+#  if defined(__SSE2__) || defined(_M_X64)
+using block_t = __m128i;
+
+inline block_t load(const char* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+inline block_t has(block_t b, char c) {
+  return _mm_cmpeq_epi8(b, _mm_set1_epi8(c));
+}
+
+inline block_t either(block_t a, block_t b) {
+  return _mm_or_si128(a, b);
+}
+
+inline bool any(block_t b) {
+  return _mm_movemask_epi8(b) != 0;
+}
+
+// Returns one bit per byte
+inline uint16_t mask(block_t b) {
+  return static_cast<uint16_t>(_mm_movemask_epi8(b));
+}
+#  else
+using block_t = uint8x16_t;
+
+inline block_t load(const char* p) {
+  return vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+}
+
+inline block_t has(block_t b, char c) {
+  return vceqq_u8(b, vdupq_n_u8(static_cast<uint8_t>(c)));
+}
+
+inline block_t either(block_t a, block_t b) {
+  return vorrq_u8(a, b);
+}
+
+inline bool any(block_t b) {
+  return vmaxvq_u8(b) != 0;
+}
+
+// Returns one bit per byte
+inline uint16_t mask(block_t b) {
+  static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                      1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t bits = vandq_u8(b, vld1q_u8(weights));
+  return static_cast<uint16_t>(vaddv_u8(vget_low_u8(bits)) |
+                               (vaddv_u8(vget_high_u8(bits)) << 8));
+}
+#  endif
+}  // namespace simd
+#endif
+
+// Matches the characters that need special treatment in a quoted string: the
+// closing quote, a backslash, or a '\0'
+class SpecialCharInString {
+ public:
+  SpecialCharInString(char stopChar) : stopChar_(stopChar) {}
+
+  bool operator()(char c) const {
+    return c == stopChar_ || c == '\\' || c == '\0';
+  }
+
+#if ARDUINOJSON_SIZEOF_POINTER >= 4
+  bool operator()(swar::word_t w) const {
+    return (swar::has(w, stopChar_) | swar::has(w, '\\') | swar::hasZero(w)) !=
+           0;
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_SIMD
+  bool operator()(simd::block_t b) const {
+    return simd::any(simd::either(
+        simd::either(simd::has(b, stopChar_), simd::has(b, '\\')),
+        simd::has(b, '\0')));
+  }
+#endif
+
+ private:
+  char stopChar_;
+};
+
+// Matches the characters that change the nesting depth outside of a string:
+// brackets, braces, quotes, or a '\0'
+struct StructuralChar {
+  bool operator()(char c) const {
+    switch (c) {
+      case '[':
+      case ']':
+      case '{':
+      case '}':
+      case '"':
+      case '\'':
+      case '\0':
+        return true;
+      default:
+        return false;
+    }
+  }
+
+#if ARDUINOJSON_SIZEOF_POINTER >= 4
+  bool operator()(swar::word_t w) const {
+    // '[' and ']' only differ from '{' and '}' by bit 5
+    swar::word_t lower = w | swar::repeat(0x20);
+    return (swar::has(lower, '{') | swar::has(lower, '}') |
+            swar::has(w, '"') | swar::has(w, '\'') | swar::hasZero(w)) != 0;
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_SIMD
+  bool operator()(simd::block_t b) const {
+    simd::block_t brackets = simd::either(
+        simd::either(simd::has(b, '['), simd::has(b, ']')),
+        simd::either(simd::has(b, '{'), simd::has(b, '}')));
+    simd::block_t others = simd::either(
+        simd::either(simd::has(b, '"'), simd::has(b, '\'')),
+        simd::has(b, '\0'));
+    return simd::any(simd::either(brackets, others));
+  }
+#endif
+};
+
+// The following functions return a pointer to the first character of
+// [p, end) that matches, or end if there is none.
+// Blocks that contain a match are rescanned one character at a time, so the
+// wide variants only need to tell if a block contains a match.
+
+template <typename TMatcher>
+inline const char* findFirstScalar(const char* p, const char* end,
+                                   TMatcher match) {
+  while (p != end && !match(*p))
+    p++;
+  return p;
+}
+
+#if ARDUINOJSON_SIZEOF_POINTER >= 4
+template <typename TMatcher>
+inline const char* findFirstSwar(const char* p, const char* end,
+                                 TMatcher match) {
+  while (size_t(end - p) >= sizeof(swar::word_t)) {
+    if (match(swar::load(p)))
+      break;
+    p += sizeof(swar::word_t);
+  }
+  return findFirstScalar(p, end, match);
+}
+#endif
+
+#if ARDUINOJSON_ENABLE_SIMD
+template <typename TMatcher>
+inline const char* findFirstSimd(const char* p, const char* end,
+                                 TMatcher match) {
+  while (end - p >= 16) {
+    if (match(simd::load(p)))
+      break;
+    p += 16;
+  }
+  return findFirstScalar(p, end, match);
+}
+#endif
+
+// If end is null, the input is terminated by a '\0', so we cannot read ahead.
+template <typename TMatcher>
+inline const char* findFirst(const char* p, const char* end, TMatcher match) {
+  if (!end)
+    return findFirstScalar(p, end, match);
+#if ARDUINOJSON_ENABLE_SIMD
+  return findFirstSimd(p, end, match);
+#elif ARDUINOJSON_SIZEOF_POINTER >= 4
+  return findFirstSwar(p, end, match);
+#else
+  return findFirstScalar(p, end, match);
+#endif
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
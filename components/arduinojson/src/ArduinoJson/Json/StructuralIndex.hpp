@@ -0,0 +1,243 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/StringScanner.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+#include <stdint.h>  // uint32_t, uint64_t
+
+#ifdef _MSC_VER
+#  include <intrin.h>  // _BitScanForward64
+#endif
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Stage 1 of the two-stage parser (see ARDUINOJSON_ENABLE_STRUCTURAL_INDEX)
+// Records the position of the brackets, braces, colons, commas, single quotes,
+// backslashes, opening double quotes, and first characters of the other tokens
+// (numbers, literals...) that are not in a string.
+// The input is processed in blocks of 64 bytes, each character class being
+// represented by a 64-bit mask.
+// Stage 2 walks the positions with next() and consume(), so it never needs to
+// look at the spaces.
+class StructuralIndex {
+ public:
+  StructuralIndex(Allocator* allocator) : allocator_(allocator) {}
+
+  ~StructuralIndex() {
+    if (positions_)
+      allocator_->deallocate(positions_);
+  }
+
+  StructuralIndex(const StructuralIndex&) = delete;
+  StructuralIndex& operator=(const StructuralIndex&) = delete;
+
+  // Returns false if the input is too large or if the allocation fails
+  bool build(const char* input, size_t length) {
+    if (length >= 0xFFFFFFFF)
+      return false;
+
+    input_ = input;
+    length_ = length;
+    uint64_t escapedCarry = 0;  // 1 if the first character is escaped
+    uint64_t inStringCarry = 0;  // all ones if the block starts in a string
+    uint64_t tokenCarry = 0;  // 1 if the previous character is in a token
+
+    for (size_t offset = 0; offset < length; offset += 64) {
+      Masks masks = classify(input + offset, length - offset);
+
+      uint64_t escaped = findEscapedChars(masks.backslashes, escapedCarry);
+      uint64_t quotes = masks.quotes & ~escaped;
+
+      // Bits are set from an opening quote (included) to the closing quote
+      // (excluded)
+      uint64_t inString = prefixXor(quotes) ^ inStringCarry;
+      inStringCarry = (inString >> 63) ? ~uint64_t(0) : 0;
+
+      // Backslashes are invalid outside of strings; we record them so that
+      // stage 2 can fail
+      uint64_t structurals = masks.structurals | masks.backslashes;
+
+      uint64_t tokens = ~(structurals | masks.quotes | masks.spaces);
+      uint64_t tokenStarts = tokens & ~((tokens << 1) | tokenCarry);
+      tokenCarry = tokens >> 63;
+
+      uint64_t found =
+          ((structurals | tokenStarts) & ~inString) | (quotes & inString);
+      while (found) {
+        if (!append(uint32_t(offset + countTrailingZeros(found))))
+          return false;
+        found &= found - 1;
+      }
+    }
+
+    // sentinel
+    return append(uint32_t(length));
+  }
+
+  // Returns the character at the next position, or '\0' at the end of the
+  // input
+  char next() const {
+    ARDUINOJSON_ASSERT(next_ < size_);
+    return next_ + 1 < size_ ? input_[positions_[next_]] : '\0';
+  }
+
+  const char* position() const {
+    return input_ + positions_[next_];
+  }
+
+  void consume() {
+    ARDUINOJSON_ASSERT(next_ + 1 < size_);
+    next_++;
+  }
+
+  const char* end() const {
+    return input_ + length_;
+  }
+
+  // Consumes the token at the next position and returns its size
+  size_t consumeToken() {
+    ARDUINOJSON_ASSERT(next_ + 1 < size_);
+    size_t begin = positions_[next_++];
+    size_t end = positions_[next_];
+    while (isSpace(input_[end - 1]))
+      end--;
+    return end - begin;
+  }
+
+ private:
+  struct Masks {
+    uint64_t quotes;
+    uint64_t backslashes;
+    uint64_t structurals;
+    uint64_t spaces;
+  };
+
+  static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+  }
+
+  static Masks classify(const char* p, size_t available) {
+    char block[64];
+    if (available < 64) {
+      memcpy(block, p, available);
+      memset(block + available, ' ', 64 - available);
+      p = block;
+    }
+    Masks masks = {0, 0, 0, 0};
+#if ARDUINOJSON_ENABLE_SIMD
+    for (int i = 0; i < 64; i += 16) {
+      simd::block_t b = simd::load(p + i);
+      simd::block_t brackets = simd::either(
+          simd::either(simd::has(b, '['), simd::has(b, ']')),
+          simd::either(simd::has(b, '{'), simd::has(b, '}')));
+      simd::block_t separators = simd::either(
+          simd::either(simd::has(b, ':'), simd::has(b, ',')),
+          simd::has(b, '\''));
+      simd::block_t spaces = simd::either(
+          simd::either(simd::has(b, ' '), simd::has(b, '\t')),
+          simd::either(simd::has(b, '\r'), simd::has(b, '\n')));
+      masks.quotes |= uint64_t(simd::mask(simd::has(b, '"'))) << i;
+      masks.backslashes |= uint64_t(simd::mask(simd::has(b, '\\'))) << i;
+      masks.structurals |=
+          uint64_t(simd::mask(simd::either(brackets, separators))) << i;
+      masks.spaces |= uint64_t(simd::mask(spaces)) << i;
+    }
+#else
+    for (int i = 0; i < 64; i++) {
+      uint64_t bit = uint64_t(1) << i;
+      switch (p[i]) {
+        case '"':
+          masks.quotes |= bit;
+          break;
+        case '\\':
+          masks.backslashes |= bit;
+          break;
+        case '[':
+        case ']':
+        case '{':
+        case '}':
+        case ':':
+        case ',':
+        case '\'':
+          masks.structurals |= bit;
+          break;
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+          masks.spaces |= bit;
+          break;
+      }
+    }
+#endif
+    return masks;
+  }
+
+  // Returns the characters preceded by an odd number of backslashes.
+  // Backslashes are rare, so we process them one by one.
+  static uint64_t findEscapedChars(uint64_t backslashes, uint64_t& carry) {
+    uint64_t escaped = carry;
+    uint64_t escapes = backslashes & ~escaped;
+    carry = 0;
+    while (escapes) {
+      uint64_t bit = escapes & (~escapes + 1);  // lowest bit
+      if (bit >> 63)
+        carry = 1;
+      escaped |= bit << 1;
+      escapes &= ~(bit | bit << 1);
+    }
+    return escaped;
+  }
+
+  // Bit i of the result is the parity of bits 0 to i of x
+  static uint64_t prefixXor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+  }
+
+  static unsigned countTrailingZeros(uint64_t x) {
+    ARDUINOJSON_ASSERT(x != 0);
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return unsigned(index);
+#else
+    return unsigned(__builtin_ctzll(x));
+#endif
+  }
+
+  bool append(uint32_t position) {
+    if (size_ == capacity_) {
+      size_t newCapacity = capacity_ ? capacity_ * 2 : 64;
+      size_t newSize = newCapacity * sizeof(uint32_t);
+      void* p = positions_ ? allocator_->reallocate(positions_, newSize)
+                           : allocator_->allocate(newSize);
+      if (!p)
+        return false;
+      positions_ = static_cast<uint32_t*>(p);
+      capacity_ = newCapacity;
+    }
+    positions_[size_++] = position;
+    return true;
+  }
+
+  Allocator* allocator_;
+  const char* input_ = nullptr;
+  size_t length_ = 0;
+  uint32_t* positions_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+  size_t next_ = 0;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
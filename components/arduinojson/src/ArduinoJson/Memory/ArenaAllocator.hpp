@@ -0,0 +1,194 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Alignment.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// An allocator that carves the blocks out of a buffer by moving a pointer,
+// and frees them all at once with clear().
+// It never returns memory to the heap while in use, so it can't fragment it.
+// deallocate() only reclaims the last block, and reallocate() resizes the
+// last block in place (other blocks can shrink but are copied to grow).
+// Call clear() only when no JsonDocument uses the allocator anymore.
+// The blocks that come from the fallback allocator are freed one by one, as
+// usual.
+class ArenaAllocator : public Allocator {
+ public:
+  // Allocates from the specified buffer; when it's full, allocations go to
+  // fallback or fail if there is none
+  ArenaAllocator(void* buffer, size_t capacity, Allocator* fallback = nullptr)
+      : buffer_(reinterpret_cast<char*>(buffer)),
+        capacity_(capacity),
+        fallback_(fallback) {
+    clear();
+  }
+
+  // Allocates from chunks of chunkSize bytes, requested from upstream when
+  // needed; clear() keeps the chunks to reuse them
+  explicit ArenaAllocator(
+      size_t chunkSize,
+      Allocator* upstream = detail::DefaultAllocator::instance())
+      : chunkSize_(chunkSize), upstream_(upstream) {
+    clear();
+  }
+
+  virtual ~ArenaAllocator() {
+    while (chunks_) {
+      Chunk* next = chunks_->next;
+      upstream_->deallocate(chunks_);
+      chunks_ = next;
+    }
+  }
+
+  ArenaAllocator(const ArenaAllocator&) = delete;
+  ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+  // Returns the number of bytes that a block of the specified size takes in
+  // the arena, header and padding included
+  static size_t footprint(size_t size) {
+    return headerSize + detail::addPadding(size);
+  }
+
+  void* allocate(size_t size) override {
+    size_t n = footprint(size);
+    if (size_t(end_ - ptr_) < n && !nextChunk(n))
+      return fallback_ ? fallback_->allocate(size) : nullptr;
+    char* block = ptr_;
+    ptr_ += n;
+    last_ = block;
+    return setSize(block, size);
+  }
+
+  void deallocate(void* ptr) override {
+    if (isFallback(ptr)) {
+      fallback_->deallocate(ptr);
+      return;
+    }
+    if (ptr && header(ptr) == last_) {
+      ptr_ = last_;
+      last_ = nullptr;
+    }
+  }
+
+  void* reallocate(void* ptr, size_t newSize) override {
+    if (!ptr)
+      return allocate(newSize);
+    if (isFallback(ptr))
+      return fallback_->reallocate(ptr, newSize);
+
+    char* block = header(ptr);
+    if (block == last_) {
+      size_t n = footprint(newSize);
+      if (size_t(end_ - block) >= n) {
+        ptr_ = block + n;
+        return setSize(block, newSize);
+      }
+    } else if (newSize <= getSize(block)) {
+      // the end of the block is lost until clear()
+      return setSize(block, newSize);
+    }
+
+    void* newPtr = allocate(newSize);
+    if (newPtr)
+      memcpy(newPtr, ptr, getSize(block));
+    return newPtr;
+  }
+
+  // Frees all the blocks in O(1)
+  void clear() {
+    current_ = nullptr;
+    last_ = nullptr;
+    if (buffer_) {
+      ptr_ = detail::addPadding(buffer_);
+      end_ = buffer_ + capacity_;
+      if (ptr_ > end_)
+        ptr_ = end_;
+    } else {
+      ptr_ = end_ = nullptr;
+    }
+  }
+
+ private:
+  struct Chunk {
+    Chunk* next;
+    size_t capacity;
+  };
+
+  static const size_t headerSize = detail::AddPadding<sizeof(size_t)>::value;
+  static const size_t chunkHeaderSize =
+      detail::AddPadding<sizeof(Chunk)>::value;
+
+  // Returns true if the block comes from the fallback allocator
+  bool isFallback(void* ptr) const {
+    auto p = reinterpret_cast<char*>(ptr);
+    return fallback_ && ptr && (p < buffer_ || p >= buffer_ + capacity_);
+  }
+
+  static char* header(void* ptr) {
+    return reinterpret_cast<char*>(ptr) - headerSize;
+  }
+
+  static size_t getSize(char* block) {
+    size_t size;
+    memcpy(&size, block, sizeof(size));
+    return size;
+  }
+
+  static void* setSize(char* block, size_t size) {
+    memcpy(block, &size, sizeof(size));
+    return block + headerSize;
+  }
+
+  // Moves to the next chunk with enough room, allocating it if needed
+  bool nextChunk(size_t footprint) {
+    if (!upstream_)
+      return false;
+
+    Chunk* chunk = current_ ? current_->next : chunks_;
+    while (chunk && chunk->capacity < footprint)
+      chunk = chunk->next;  // skip too small chunks, they'll be reused later
+
+    if (!chunk) {
+      size_t capacity = footprint > chunkSize_ ? footprint : chunkSize_;
+      chunk = reinterpret_cast<Chunk*>(
+          upstream_->allocate(chunkHeaderSize + capacity));
+      if (!chunk)
+        return false;
+      chunk->capacity = capacity;
+      // insert after the current chunk so it comes before the unused ones
+      if (current_) {
+        chunk->next = current_->next;
+        current_->next = chunk;
+      } else {
+        chunk->next = chunks_;
+        chunks_ = chunk;
+      }
+    }
+
+    current_ = chunk;
+    ptr_ = reinterpret_cast<char*>(chunk) + chunkHeaderSize;
+    end_ = ptr_ + chunk->capacity;
+    last_ = nullptr;
+    return true;
+  }
+
+  char* buffer_ = nullptr;
+  size_t capacity_ = 0;
+  size_t chunkSize_ = 0;
+  Allocator* upstream_ = nullptr;
+  Allocator* fallback_ = nullptr;
+  Chunk* chunks_ = nullptr;
+  Chunk* current_ = nullptr;
+  char* ptr_;  // the next free byte
+  char* end_;  // the end of the current buffer or chunk
+  char* last_;  // the header of the last block
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,80 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/VariantPool.hpp>
+
+#include <stddef.h>  // offsetof
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The ids of the elements of a large array, in order (see
+// ARDUINOJSON_ENABLE_ARRAY_INDEX)
+// The ResourceManager keeps the tables in a CollectionIndexList.
+// The table is only an accelerator: if it can't be allocated, the array is
+// walked from the beginning.
+struct ArrayIndex {
+  // Below this position, walking the linked list is fast enough
+  static const size_t minElements = 16;
+
+  ArrayIndex* next;
+  SlotId head;  // the first element of the array
+  size_t count;
+  size_t capacity;
+  SlotId elements[1];
+
+  // Returns the capacity of the table for the specified number of elements
+  static size_t capacityFor(size_t elements) {
+    size_t capacity = minElements * 2;
+    while (capacity <= elements)  // leave room for the next element
+      capacity *= 2;
+    return capacity;
+  }
+
+  static size_t sizeFor(size_t capacity) {
+    return offsetof(ArrayIndex, elements) + capacity * sizeof(SlotId);
+  }
+
+  static ArrayIndex* create(SlotId head, size_t elements,
+                            Allocator* allocator) {
+    size_t capacity = capacityFor(elements);
+    auto index =
+        reinterpret_cast<ArrayIndex*>(allocator->allocate(sizeFor(capacity)));
+    if (!index)
+      return nullptr;
+    index->next = nullptr;
+    index->head = head;
+    index->count = 0;
+    index->capacity = capacity;
+    return index;
+  }
+
+  // Doubles the capacity; returns null if the allocation failed, in which
+  // case the table is unchanged
+  static ArrayIndex* grow(ArrayIndex* index, Allocator* allocator) {
+    size_t capacity = index->capacity * 2;
+    auto newIndex = reinterpret_cast<ArrayIndex*>(
+        allocator->reallocate(index, sizeFor(capacity)));
+    if (newIndex)
+      newIndex->capacity = capacity;
+    return newIndex;
+  }
+
+  static void destroy(ArrayIndex* index, Allocator* allocator) {
+    allocator->deallocate(index);
+  }
+
+  bool full() const {
+    return count == capacity;
+  }
+
+  void add(SlotId id) {
+    ARDUINOJSON_ASSERT(!full());
+    elements[count++] = id;
+  }
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,58 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/VariantPool.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The indexes of the large collections of a ResourceManager (see ObjectIndex
+// and ArrayIndex), each one identified by the id of the first slot of its
+// collection, so that the collections don't need an extra field.
+template <typename TIndex>
+class CollectionIndexList {
+ public:
+  friend void swap(CollectionIndexList& a, CollectionIndexList& b) {
+    swap_(a.first_, b.first_);
+  }
+
+  bool empty() const {
+    return first_ == nullptr;
+  }
+
+  TIndex* first() const {
+    return first_;
+  }
+
+  // Returns the index of the collection whose first slot is head, or null
+  TIndex* find(SlotId head) const {
+    for (auto index = first_; index; index = index->next) {
+      if (index->head == head)
+        return index;
+    }
+    return nullptr;
+  }
+
+  void add(TIndex* index) {
+    index->next = first_;
+    first_ = index;
+  }
+
+  void remove(TIndex* index) {
+    auto link = &first_;
+    while (*link != index) {
+      ARDUINOJSON_ASSERT(*link != nullptr);
+      link = &(*link)->next;
+    }
+    *link = index->next;
+  }
+
+ private:
+  TIndex* first_ = nullptr;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,159 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Alignment.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+class ResourceManager;
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// The counters of an InstrumentedAllocator
+struct AllocationStats {
+  size_t allocations = 0;    // successful calls to allocate()
+  size_t reallocations = 0;  // successful calls to reallocate()
+  size_t deallocations = 0;
+  size_t failures = 0;  // calls to allocate() or reallocate() that failed
+  size_t bytes = 0;     // currently allocated
+  size_t peakBytes = 0;
+  size_t blocks = 0;  // currently allocated
+  size_t peakBlocks = 0;
+};
+
+// The allocations of a JsonDocument, by origin
+// (see ARDUINOJSON_ENABLE_ALLOCATION_STATS)
+struct AllocationProfile {
+  AllocationStats pools;          // the memory pools of the variants
+  AllocationStats strings;        // the strings stored in the document
+  AllocationStats stringBuilder;  // the strings being deserialized
+  AllocationStats indexes;        // the indexes of the large collections
+  AllocationStats packedArrays;   // see ARDUINOJSON_ENABLE_PACKED_ARRAYS
+};
+
+// An allocator that forwards to another one and counts the allocations.
+// Each block has a size header, so the byte counts are exact: they don't
+// include the header nor the overhead of the upstream allocator.
+class InstrumentedAllocator : public Allocator {
+ public:
+  explicit InstrumentedAllocator(
+      Allocator* upstream = detail::DefaultAllocator::instance())
+      : upstream_(upstream) {}
+
+  virtual ~InstrumentedAllocator() {}
+
+  InstrumentedAllocator(const InstrumentedAllocator&) = delete;
+  InstrumentedAllocator& operator=(const InstrumentedAllocator&) = delete;
+
+  // Exchanges the upstream allocators and the counters
+  friend void swap(InstrumentedAllocator& a, InstrumentedAllocator& b) {
+    detail::swap_(a.upstream_, b.upstream_);
+    detail::swap_(a.stats_, b.stats_);
+  }
+
+  void* allocate(size_t size) override {
+    auto block = static_cast<char*>(upstream_->allocate(headerSize + size));
+    if (!block) {
+      stats_.failures++;
+      return nullptr;
+    }
+    stats_.allocations++;
+    added(size);
+    return setSize(block, size);
+  }
+
+  void deallocate(void* ptr) override {
+    if (!ptr)
+      return;
+    char* block = header(ptr);
+    stats_.deallocations++;
+    removed(getSize(block));
+    upstream_->deallocate(block);
+  }
+
+  void* reallocate(void* ptr, size_t newSize) override {
+    if (!ptr)
+      return allocate(newSize);
+    char* block = header(ptr);
+    size_t oldSize = getSize(block);
+    block = static_cast<char*>(
+        upstream_->reallocate(block, headerSize + newSize));
+    if (!block) {
+      stats_.failures++;
+      return nullptr;
+    }
+    stats_.reallocations++;
+    stats_.bytes -= oldSize;
+    stats_.bytes += newSize;
+    if (stats_.bytes > stats_.peakBytes)
+      stats_.peakBytes = stats_.bytes;
+    return setSize(block, newSize);
+  }
+
+  const AllocationStats& stats() const {
+    return stats_;
+  }
+
+  // Zeroes the counters and lowers the peaks to the current values, to
+  // measure the next operations only
+  void resetStats() {
+    AllocationStats stats;
+    stats.bytes = stats.peakBytes = stats_.bytes;
+    stats.blocks = stats.peakBlocks = stats_.blocks;
+    stats_ = stats;
+  }
+
+ private:
+  friend class detail::ResourceManager;
+
+  static const size_t headerSize = detail::AddPadding<sizeof(size_t)>::value;
+
+  static char* header(void* ptr) {
+    return reinterpret_cast<char*>(ptr) - headerSize;
+  }
+
+  static size_t getSize(char* block) {
+    size_t size;
+    memcpy(&size, block, sizeof(size));
+    return size;
+  }
+
+  static void* setSize(char* block, size_t size) {
+    memcpy(block, &size, sizeof(size));
+    return block + headerSize;
+  }
+
+  void added(size_t size) {
+    stats_.bytes += size;
+    if (stats_.bytes > stats_.peakBytes)
+      stats_.peakBytes = stats_.bytes;
+    if (++stats_.blocks > stats_.peakBlocks)
+      stats_.peakBlocks = stats_.blocks;
+  }
+
+  void removed(size_t size) {
+    stats_.bytes -= size;
+    stats_.blocks--;
+  }
+
+  // Moves a block allocated by another InstrumentedAllocator to this one, so
+  // it's counted here when it's freed. The upstream allocators must be the
+  // same.
+  void adopt(void* ptr, InstrumentedAllocator& from) {
+    size_t size = getSize(header(ptr));
+    from.removed(size);
+    added(size);
+  }
+
+  Allocator* upstream_;
+  AllocationStats stats_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
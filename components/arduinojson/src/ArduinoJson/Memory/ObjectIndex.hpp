@@ -0,0 +1,121 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/VariantPool.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+#include <stddef.h>  // offsetof
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A hash table of the members of a large object (see
+// ARDUINOJSON_ENABLE_OBJECT_INDEX)
+// The ResourceManager keeps the tables in a CollectionIndexList.
+// Open addressing with linear probing; each entry caches the hash of the key.
+// The table is only an accelerator: if it can't be allocated, the object is
+// searched linearly.
+struct ObjectIndex {
+  // Below this number of members, the linked list is fast enough
+  static const size_t minMembers = 16;
+
+  struct Entry {
+    uint32_t hash;
+    SlotId id;  // NULL_SLOT if the entry is empty
+  };
+
+  ObjectIndex* next;
+  SlotId head;  // the first member of the object
+  size_t count;
+  size_t capacity;  // a power of two
+  Entry entries[1];
+
+  // FNV-1a, like StringIndex
+  template <typename TAdaptedString>
+  static uint32_t hash(const TAdaptedString& key) {
+    uint32_t h = 2166136261u;
+    size_t n = key.size();
+    for (size_t i = 0; i < n; i++) {
+      h ^= uint8_t(key[i]);
+      h *= 16777619u;
+    }
+    return h;
+  }
+
+  // Returns the capacity of the table for the specified number of members
+  static size_t capacityFor(size_t members) {
+    size_t capacity = minMembers * 2;
+    while (members * 4 > capacity * 3)  // keep the load factor under 75%
+      capacity *= 2;
+    return capacity;
+  }
+
+  static size_t sizeFor(size_t capacity) {
+    return offsetof(ObjectIndex, entries) + capacity * sizeof(Entry);
+  }
+
+  static ObjectIndex* create(SlotId head, size_t members,
+                             Allocator* allocator) {
+    size_t capacity = capacityFor(members);
+    auto index =
+        reinterpret_cast<ObjectIndex*>(allocator->allocate(sizeFor(capacity)));
+    if (!index)
+      return nullptr;
+    index->next = nullptr;
+    index->head = head;
+    index->count = 0;
+    index->capacity = capacity;
+    for (size_t i = 0; i < capacity; i++)
+      index->entries[i].id = NULL_SLOT;
+    return index;
+  }
+
+  static void destroy(ObjectIndex* index, Allocator* allocator) {
+    allocator->deallocate(index);
+  }
+
+  size_t mask() const {
+    return capacity - 1;
+  }
+
+  // Returns false if the table is full, in which case it must be rebuilt
+  bool add(uint32_t h, SlotId id) {
+    if ((count + 1) * 4 > capacity * 3)
+      return false;
+    size_t i = h & mask();
+    while (entries[i].id != NULL_SLOT)
+      i = (i + 1) & mask();
+    entries[i].hash = h;
+    entries[i].id = id;
+    count++;
+    return true;
+  }
+
+  void remove(uint32_t h, SlotId id) {
+    size_t i = h & mask();
+    while (entries[i].id != id) {
+      ARDUINOJSON_ASSERT(entries[i].id != NULL_SLOT);
+      i = (i + 1) & mask();
+    }
+
+    // Backward shift deletion, like in StringIndex
+    for (size_t j = (i + 1) & mask(); entries[j].id != NULL_SLOT;
+         j = (j + 1) & mask()) {
+      size_t home = entries[j].hash & mask();
+      bool reachable =
+          i <= j ? (i < home && home <= j) : (i < home || home <= j);
+      if (!reachable) {
+        entries[i] = entries[j];
+        i = j;
+      }
+    }
+    entries[i].id = NULL_SLOT;
+    count--;
+  }
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
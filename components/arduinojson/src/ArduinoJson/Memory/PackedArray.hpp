@@ -0,0 +1,304 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Numbers/FloatTraits.hpp>
+#include <ArduinoJson/Numbers/JsonFloat.hpp>
+#include <ArduinoJson/Numbers/JsonInteger.hpp>
+#include <ArduinoJson/Numbers/convertNumber.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+
+#include <stddef.h>  // offsetof
+#include <stdint.h>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The elements of an array of numbers, stored contiguously with the smallest
+// type that represents all of them exactly, instead of one slot per element
+// (see ARDUINOJSON_ENABLE_PACKED_ARRAYS).
+// The integers and the floating-point values don't share an array, so that
+// the elements keep their type.
+// The ResourceManager keeps the arrays in a PackedArrayList.
+struct PackedArray {
+  // Below this number of elements, the slots are good enough
+  static const size_t minElements = 16;
+
+  enum {
+    Int16,
+    Int32,
+    Float32,
+    Float64,  // a JsonFloat that doesn't fit in a float
+    Invalid  // a value that a packed array can't store
+  };
+
+  PackedArray* next;
+  PackedArray* prev;
+  size_t size;
+  size_t capacity;
+  uint8_t type;
+  union {  // for the alignment of the elements
+    int16_t asInt16;
+    int32_t asInt32;
+    float asFloat32;
+    JsonFloat asFloat64;
+  } elements[1];
+
+  // Returns the type of packed array that can store the value
+  static uint8_t typeOf(JsonInteger value) {
+    if (canConvertNumber<int16_t>(value))
+      return Int16;
+    if (canConvertNumber<int32_t>(value))
+      return Int32;
+    return Invalid;
+  }
+
+  static uint8_t typeOf(JsonUInt value) {
+    if (canConvertNumber<int16_t>(value))
+      return Int16;
+    if (canConvertNumber<int32_t>(value))
+      return Int32;
+    return Invalid;
+  }
+
+  static uint8_t typeOf(JsonFloat value) {
+    if (sizeof(JsonFloat) == sizeof(float))
+      return Float32;
+    // the range check prevents the overflow of the cast
+    const JsonFloat highest = FloatTraits<float>::highest();
+    if (value >= -highest && value <= highest && float(value) == value)
+      return Float32;
+    return Float64;  // including NaN and the infinities
+  }
+
+  // Returns the type that can store the values of both types
+  static uint8_t merge(uint8_t a, uint8_t b) {
+    if (a == Invalid || b == Invalid || isFloat(a) != isFloat(b))
+      return Invalid;
+    return a > b ? a : b;
+  }
+
+  static bool isFloat(uint8_t type) {
+    return type == Float32 || type == Float64;
+  }
+
+  static size_t elementSize(uint8_t type) {
+    switch (type) {
+      case Int16:
+        return sizeof(int16_t);
+      case Int32:
+        return sizeof(int32_t);
+      case Float32:
+        return sizeof(float);
+      default:
+        return sizeof(JsonFloat);
+    }
+  }
+
+  static size_t sizeFor(uint8_t type, size_t capacity) {
+    return offsetof(PackedArray, elements) + capacity * elementSize(type);
+  }
+
+  static PackedArray* create(uint8_t type, size_t capacity,
+                             Allocator* allocator) {
+    ARDUINOJSON_ASSERT(type != Invalid);
+    auto array = reinterpret_cast<PackedArray*>(
+        allocator->allocate(sizeFor(type, capacity)));
+    if (!array)
+      return nullptr;
+    array->next = nullptr;
+    array->prev = nullptr;
+    array->size = 0;
+    array->capacity = capacity;
+    array->type = type;
+    return array;
+  }
+
+  // Changes the capacity, and widens the elements to the specified type.
+  // Returns null if the allocation failed, in which case the array is
+  // unchanged.
+  static PackedArray* resize(PackedArray* array, uint8_t type,
+                             size_t capacity, Allocator* allocator) {
+    ARDUINOJSON_ASSERT(capacity >= array->size);
+    ARDUINOJSON_ASSERT(merge(array->type, type) == type);
+    auto newArray = reinterpret_cast<PackedArray*>(
+        allocator->reallocate(array, sizeFor(type, capacity)));
+    if (!newArray)
+      return nullptr;
+    newArray->capacity = capacity;
+    if (newArray->type != type)
+      newArray->widen(type);
+    return newArray;
+  }
+
+  static void destroy(PackedArray* array, Allocator* allocator) {
+    allocator->deallocate(array);
+  }
+
+  bool isFloat() const {
+    return isFloat(type);
+  }
+
+  bool full() const {
+    return size == capacity;
+  }
+
+  // The value must fit in the type of the array
+  void add(JsonInteger value) {
+    ARDUINOJSON_ASSERT(!full());
+    ARDUINOJSON_ASSERT(merge(type, typeOf(value)) == type);
+    if (type == Int16)
+      int16s()[size++] = int16_t(value);
+    else
+      int32s()[size++] = int32_t(value);
+  }
+
+  void add(JsonFloat value) {
+    ARDUINOJSON_ASSERT(!full());
+    ARDUINOJSON_ASSERT(merge(type, typeOf(value)) == type);
+    if (type == Float32)
+      float32s()[size++] = float(value);
+    else
+      float64s()[size++] = value;
+  }
+
+  JsonInteger getInteger(size_t index) const {
+    ARDUINOJSON_ASSERT(index < size && !isFloat());
+    if (type == Int16)
+      return int16s()[index];
+    else
+      return int32s()[index];
+  }
+
+  JsonFloat getFloat(size_t index) const {
+    ARDUINOJSON_ASSERT(index < size && isFloat());
+    if (type == Float32)
+      return float32s()[index];
+    else
+      return float64s()[index];
+  }
+
+  // Calls visit.visit() with the element at the specified index, with the
+  // type that the parser gives to this number
+  template <typename TVisitor>
+  typename TVisitor::result_type accept(size_t index, TVisitor& visit) const {
+    if (isFloat())
+      return visit.visit(getFloat(index));
+    JsonInteger value = getInteger(index);
+    if (value >= 0)
+      return visit.visit(JsonUInt(value));
+    else
+      return visit.visit(value);
+  }
+
+ private:
+  // Converts the elements in place, from the last one, as they grow
+  void widen(uint8_t newType) {
+    size_t i = size;
+    if (newType == Int32) {
+      ARDUINOJSON_ASSERT(type == Int16);
+      while (i--)
+        int32s()[i] = int16s()[i];
+    } else {
+      ARDUINOJSON_ASSERT(type == Float32 && newType == Float64);
+      while (i--)
+        float64s()[i] = float32s()[i];
+    }
+    type = newType;
+  }
+
+  // The elements are accessed through pointers, as they go beyond the
+  // declared size of the array
+  int16_t* int16s() {
+    return reinterpret_cast<int16_t*>(elements);
+  }
+
+  const int16_t* int16s() const {
+    return reinterpret_cast<const int16_t*>(elements);
+  }
+
+  int32_t* int32s() {
+    return reinterpret_cast<int32_t*>(elements);
+  }
+
+  const int32_t* int32s() const {
+    return reinterpret_cast<const int32_t*>(elements);
+  }
+
+  float* float32s() {
+    return reinterpret_cast<float*>(elements);
+  }
+
+  const float* float32s() const {
+    return reinterpret_cast<const float*>(elements);
+  }
+
+  JsonFloat* float64s() {
+    return reinterpret_cast<JsonFloat*>(elements);
+  }
+
+  const JsonFloat* float64s() const {
+    return reinterpret_cast<const JsonFloat*>(elements);
+  }
+};
+
+// The packed arrays of a ResourceManager, so that clear() can release them.
+// It's doubly linked because the arrays are released one by one, when their
+// variant changes.
+class PackedArrayList {
+ public:
+  friend void swap(PackedArrayList& a, PackedArrayList& b) {
+    swap_(a.first_, b.first_);
+  }
+
+  bool empty() const {
+    return first_ == nullptr;
+  }
+
+  PackedArray* first() const {
+    return first_;
+  }
+
+  void add(PackedArray* array) {
+    array->prev = nullptr;
+    array->next = first_;
+    if (first_)
+      first_->prev = array;
+    first_ = array;
+  }
+
+  void remove(PackedArray* array) {
+    if (array->prev)
+      array->prev->next = array->next;
+    else
+      first_ = array->next;
+    if (array->next)
+      array->next->prev = array->prev;
+  }
+
+  // Updates the links to an array that moved (see PackedArray::resize())
+  void relink(PackedArray* array) {
+    if (array->prev)
+      array->prev->next = array;
+    else
+      first_ = array;
+    if (array->next)
+      array->next->prev = array;
+  }
+
+  // Returns the number of bytes of the arrays
+  size_t size() const {
+    size_t total = 0;
+    for (auto array = first_; array; array = array->next)
+      total += PackedArray::sizeFor(array->type, array->capacity);
+    return total;
+  }
+
+ private:
+  PackedArray* first_ = nullptr;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
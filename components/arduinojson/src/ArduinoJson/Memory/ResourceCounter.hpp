@@ -0,0 +1,168 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Memory/StringBuilder.hpp>
+#include <ArduinoJson/Memory/StringCounter.hpp>
+
+#include <string.h>  // memcmp, memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Counts the slots and the string bytes that a deserializer would allocate
+// (see DeserializationOption::ExactSize).
+// The identical strings are counted once, like in the StringPool: the counter
+// keeps a copy of each string in a hash table, which it frees when it's
+// destroyed, before the document reserves the memory.
+// If the allocator fails, the strings that can't be compared are counted
+// again, so the result is then an upper bound.
+// The deserializer reuses the slots that it frees (see freeSlots()), so the
+// result is the largest number of slots in use at the same time.
+class ResourceCounter {
+ public:
+  explicit ResourceCounter(Allocator* allocator) : allocator_(allocator) {}
+
+  ~ResourceCounter() {
+    for (size_t i = 0; i < capacity_; i++) {
+      if (table_[i].data)
+        allocator_->deallocate(table_[i].data);
+    }
+    if (table_)
+      allocator_->deallocate(table_);
+  }
+
+  ResourceCounter(const ResourceCounter&) = delete;
+  ResourceCounter& operator=(const ResourceCounter&) = delete;
+
+  Allocator* allocator() const {
+    return allocator_;
+  }
+
+  void addSlot() {
+    addSlots(1);
+  }
+
+  void addSlots(size_t n) {
+    usedSlots_ += n;
+    if (usedSlots_ > slots_)
+      slots_ = usedSlots_;
+  }
+
+  // Counts the slots that the deserializer frees, like when it packs an array
+  // (see ARDUINOJSON_ENABLE_PACKED_ARRAYS); the next slots reuse them.
+  void freeSlots(size_t n) {
+    ARDUINOJSON_ASSERT(n <= usedSlots_);
+    usedSlots_ -= n;
+  }
+
+  // Counts a string that went through the StringBuilder
+  void buildString(const StringCounter& s) {
+    if (!builderCapacity_)
+      builderCapacity_ = StringBuilder::initialCapacity;
+    while (builderCapacity_ < s.size())
+      builderCapacity_ = builderCapacity_ * 2 + 1;  // like StringBuilder
+  }
+
+  // Counts a string that the StringBuilder saved in the StringPool
+  void saveString(StringCounter& s) {
+    if (!add(s))
+      return;  // already in the pool
+    strings_++;
+    stringBytes_ += ResourceManager::stringFootprint(s.size());
+  }
+
+  size_t slots() const {
+    return slots_;
+  }
+
+  // Returns the size of the string buffer, including the index of the
+  // StringPool and the last string of the StringBuilder
+  size_t stringBytes() const {
+    if (!builderCapacity_)
+      return 0;
+    return stringBytes_ + ResourceManager::stringIndexFootprint(strings_) +
+           ResourceManager::stringFootprint(builderCapacity_);
+  }
+
+ private:
+  struct Entry {
+    char* data;  // null marks the empty entries
+    size_t size;
+    uint32_t hash;
+  };
+
+  // Returns false if the string was already there
+  bool add(StringCounter& s) {
+    if (!s.isComplete())
+      return true;  // can't compare it, count it again
+    if ((count_ + 1) * 4 > capacity_ * 3 && !grow())
+      return true;
+
+    JsonString str = s.str();
+    size_t i = find(s.hash(), str);
+    Entry& entry = table_[i];
+    if (entry.data)
+      return false;
+
+    entry.data = static_cast<char*>(allocator_->allocate(str.size() + 1));
+    if (!entry.data)
+      return true;
+    memcpy(entry.data, str.c_str(), str.size());
+    entry.size = str.size();
+    entry.hash = s.hash();
+    count_++;
+    return true;
+  }
+
+  // Returns the entry of the string, or the empty entry where it goes
+  size_t find(uint32_t hash, JsonString str) const {
+    size_t mask = capacity_ - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+      const Entry& entry = table_[i];
+      if (!entry.data)
+        return i;
+      if (entry.hash == hash && entry.size == str.size() &&
+          memcmp(entry.data, str.c_str(), str.size()) == 0)
+        return i;
+    }
+  }
+
+  // Doubles the capacity of the table
+  bool grow() {
+    size_t capacity = capacity_ ? capacity_ * 2 : 16;
+    auto table =
+        static_cast<Entry*>(allocator_->allocate(capacity * sizeof(Entry)));
+    if (!table)
+      return false;
+    for (size_t i = 0; i < capacity; i++)
+      table[i].data = nullptr;
+    for (size_t i = 0; i < capacity_; i++) {
+      if (!table_[i].data)
+        continue;
+      size_t j = table_[i].hash & (capacity - 1);
+      while (table[j].data)
+        j = (j + 1) & (capacity - 1);
+      table[j] = table_[i];
+    }
+    if (table_)
+      allocator_->deallocate(table_);
+    table_ = table;
+    capacity_ = capacity;
+    return true;
+  }
+
+  Allocator* allocator_;
+  size_t slots_ = 0;
+  size_t usedSlots_ = 0;
+  size_t strings_ = 0;
+  size_t stringBytes_ = 0;
+  size_t builderCapacity_ = 0;
+  Entry* table_ = nullptr;
+  size_t capacity_ = 0;  // a power of two
+  size_t count_ = 0;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,540 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/ArrayIndex.hpp>
+#include <ArduinoJson/Memory/CollectionIndexList.hpp>
+#include <ArduinoJson/Memory/ObjectIndex.hpp>
+#include <ArduinoJson/Memory/PackedArray.hpp>
+#include <ArduinoJson/Memory/StringPool.hpp>
+#include <ArduinoJson/Memory/StringReserve.hpp>
+#include <ArduinoJson/Memory/SymbolTable.hpp>
+#include <ArduinoJson/Memory/VariantPoolList.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+#if ARDUINOJSON_ENABLE_ALLOCATION_STATS
+#  include <ArduinoJson/Memory/InstrumentedAllocator.hpp>
+#endif
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+class VariantSlot;
+class VariantPool;
+
+class ResourceManager {
+ public:
+  ResourceManager(Allocator* allocator = DefaultAllocator::instance())
+      : allocator_(allocator),
+#if ARDUINOJSON_ENABLE_ALLOCATION_STATS
+        pools_(allocator),
+        strings_(allocator),
+        stringBuilder_(allocator),
+        indexes_(allocator),
+        packedArrays_(allocator),
+#endif
+        overflowed_(false) {}
+
+  ~ResourceManager() {
+    stringPool_.clear(stringAllocator());
+    variantPools_.destroy(poolAllocator());
+    if (stringReserve_)
+      StringReserve::destroy(stringReserve_, allocator_);
+    setSymbolTable(nullptr);
+    clearIndexes();
+    clearPackedArrays();
+  }
+
+  ResourceManager(const ResourceManager&) = delete;
+  ResourceManager& operator=(const ResourceManager& src) = delete;
+
+  friend void swap(ResourceManager& a, ResourceManager& b) {
+    swap(a.stringPool_, b.stringPool_);
+    swap(a.variantPools_, b.variantPools_);
+    swap_(a.allocator_, b.allocator_);
+    swap_(a.overflowed_, b.overflowed_);
+    swap_(a.keepCapacity_, b.keepCapacity_);
+    swap_(a.recycleStrings_, b.recycleStrings_);
+#if ARDUINOJSON_AUTO_SHRINK
+    swap_(a.autoShrink_, b.autoShrink_);
+#endif
+    swap_(a.stringReserve_, b.stringReserve_);
+    swap_(a.reservedStringBytes_, b.reservedStringBytes_);
+    swap_(a.recycledStringBytes_, b.recycledStringBytes_);
+    swap_(a.stringBuilderPeak_, b.stringBuilderPeak_);
+    // the tables know the address of the links, so they can't be swapped
+    SymbolTable* aSymbols = a.symbolTable();
+    a.setSymbolTable(b.symbolTable());
+    b.setSymbolTable(aSymbols);
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+    swap(a.objectIndexes_, b.objectIndexes_);
+#endif
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+    swap(a.arrayIndexes_, b.arrayIndexes_);
+#endif
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    swap(a.packedArrayList_, b.packedArrayList_);
+#endif
+#if ARDUINOJSON_ENABLE_ALLOCATION_STATS
+    swap(a.pools_, b.pools_);
+    swap(a.strings_, b.strings_);
+    swap(a.stringBuilder_, b.stringBuilder_);
+    swap(a.indexes_, b.indexes_);
+    swap(a.packedArrays_, b.packedArrays_);
+#endif
+  }
+
+  Allocator* allocator() const {
+    return allocator_;
+  }
+
+  size_t size() const {
+    return VariantPool::slotsToBytes(variantPools_.usage()) +
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+           packedArrayList_.size() +
+#endif
+           stringPool_.size();
+  }
+
+  bool overflowed() const {
+    return overflowed_;
+  }
+
+#if ARDUINOJSON_AUTO_SHRINK
+  bool autoShrink() const {
+    return autoShrink_ && !keepCapacity_;
+  }
+
+  void setAutoShrink(bool enabled) {
+    autoShrink_ = enabled;
+  }
+#endif
+
+  // Makes clear() keep the variant pools.
+  // If recycleStrings is true, clear() also grows the string buffer to fit the
+  // strings it frees, so the same strings fit next time. Otherwise, the next
+  // clear() shrinks it back to the reservation.
+  void setKeepCapacity(bool enabled, bool recycleStrings) {
+    keepCapacity_ = enabled;
+    recycleStrings_ = enabled && recycleStrings;
+    if (!recycleStrings_)
+      recycledStringBytes_ = 0;
+  }
+
+  // Applies the settings and the reservations of another ResourceManager
+  bool copySettings(const ResourceManager& src) {
+#if ARDUINOJSON_AUTO_SHRINK
+    autoShrink_ = src.autoShrink_;
+#endif
+    keepCapacity_ = src.keepCapacity_;
+    recycleStrings_ = src.recycleStrings_;
+    recycledStringBytes_ = src.recycledStringBytes_;
+    setSymbolTable(src.symbolTable());
+    return reserve(src.reservedSlots(), src.reservedStringBytes_);
+  }
+
+  // Makes the object keys link to the strings of a shared table, or stores
+  // them in the string pool if table is null.
+  // The document must be empty, as its keys may link to the previous table.
+  void setSymbolTable(SymbolTable* table) {
+    if (table == symbols_.table)
+      return;
+    if (symbols_.table)
+      symbols_.table->detach(&symbols_);
+    if (table)
+      table->attach(&symbols_);
+  }
+
+  SymbolTable* symbolTable() const {
+    return symbols_.table;
+  }
+
+  // Returns how another document must store a key that this one doesn't own.
+  // If this document is attached to a SymbolTable, the key may be one of the
+  // table, which only the documents attached to the same table can link to;
+  // the others must store a copy (see ObjectData::addMember()).
+  JsonString::Ownership unownedKeyOwnership() const {
+    return symbols_.table ? JsonString::Copied : JsonString::Linked;
+  }
+
+  // Returns the copy of the key in the SymbolTable, or null if there is no
+  // table or if the key couldn't be added to it
+  template <typename TAdaptedString>
+  const char* internKey(TAdaptedString key) {
+    if (!symbols_.table)
+      return nullptr;
+    return symbols_.table->intern(key);
+  }
+
+  // Reserves the memory for the specified number of slots and bytes of
+  // strings; clear() keeps it.
+  // If the document already contains strings, the string buffer will be
+  // allocated by the next call to clear().
+  bool reserve(size_t slots, size_t stringBytes) {
+    reservedStringBytes_ = stringBytes;
+    bool ok = variantPools_.reserve(slots, poolAllocator());
+    if (stringPool_.empty() && !updateStringReserve())
+      ok = false;
+    return ok;
+  }
+
+  // Changes the reservation without allocating nor freeing anything; the next
+  // call to clear() applies it
+  void setReservation(size_t slots, size_t stringBytes) {
+    variantPools_.setReservation(slots);
+    reservedStringBytes_ = stringBytes;
+  }
+
+  size_t reservedSlots() const {
+    return variantPools_.reservedSlots();
+  }
+
+  size_t reservedStringBytes() const {
+    return reservedStringBytes_;
+  }
+
+  bool keepCapacity() const {
+    return keepCapacity_;
+  }
+
+  // Returns the number of bytes that a string takes in the string buffer
+  static size_t stringFootprint(size_t length) {
+    return ArenaAllocator::footprint(sizeofString(length) + blockOverhead);
+  }
+
+  // Returns the number of bytes that the index of the strings takes in the
+  // string buffer
+  static size_t stringIndexFootprint(size_t strings) {
+    return StringPool::indexArenaSize(strings, blockOverhead);
+  }
+
+#if ARDUINOJSON_ENABLE_ALLOCATION_STATS
+  AllocationProfile allocationProfile() const {
+    AllocationProfile profile;
+    profile.pools = pools_.stats();
+    profile.strings = strings_.stats();
+    profile.stringBuilder = stringBuilder_.stats();
+    profile.indexes = indexes_.stats();
+    profile.packedArrays = packedArrays_.stats();
+    return profile;
+  }
+#endif
+
+  SlotWithId allocSlot() {
+    auto p = variantPools_.allocSlot(poolAllocator());
+    if (!p)
+      overflowed_ = true;
+    return p;
+  }
+
+  void freeSlot(SlotWithId id) {
+    // the slot may be the first one of a collection
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+    if (!objectIndexes_.empty())
+      destroyObjectIndex(getObjectIndex(id.id()));
+#endif
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+    if (!arrayIndexes_.empty())
+      destroyArrayIndex(getArrayIndex(id.id()));
+#endif
+    variantPools_.freeSlot(id);
+  }
+
+  VariantSlot* getSlot(SlotId id) const {
+    return variantPools_.getSlot(id);
+  }
+
+  template <typename TAdaptedString>
+  StringNode* saveString(TAdaptedString str) {
+    if (str.isNull())
+      return 0;
+
+    auto node = stringPool_.add(str, stringAllocator());
+    if (!node)
+      overflowed_ = true;
+
+    return node;
+  }
+
+  // Stores a node created with createString()
+  void saveString(StringNode* node) {
+#if ARDUINOJSON_ENABLE_ALLOCATION_STATS
+    strings_.adopt(node, stringBuilder_);
+#endif
+    stringPool_.add(node, stringAllocator());
+  }
+
+  template <typename TAdaptedString>
+  StringNode* getString(const TAdaptedString& str) const {
+    return stringPool_.get(str);
+  }
+
+  StringNode* createString(size_t length) {
+    if (length > stringBuilderPeak_)
+      stringBuilderPeak_ = length;
+    auto node = StringNode::create(length, stringBuilderAllocator());
+    if (!node)
+      overflowed_ = true;
+    return node;
+  }
+
+  StringNode* resizeString(StringNode* node, size_t length) {
+    if (length > stringBuilderPeak_)
+      stringBuilderPeak_ = length;
+    node = StringNode::resize(node, length, stringBuilderAllocator());
+    if (!node)
+      overflowed_ = true;
+    return node;
+  }
+
+  void destroyString(StringNode* node) {
+    StringNode::destroy(node, stringBuilderAllocator());
+  }
+
+  void dereferenceString(const char* s) {
+    stringPool_.dereference(s, stringAllocator());
+  }
+
+  // The indexes are a cache, so they can be created from a const document
+
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  // Returns the index of the object whose first member is the specified slot,
+  // or null if it doesn't have one
+  ObjectIndex* getObjectIndex(SlotId head) const {
+    return objectIndexes_.find(head);
+  }
+
+  // Allocates an empty index for the specified object
+  ObjectIndex* createObjectIndex(SlotId head, size_t members) const {
+    auto index = ObjectIndex::create(head, members, indexAllocator());
+    if (index)
+      objectIndexes_.add(index);
+    return index;
+  }
+
+  void destroyObjectIndex(ObjectIndex* index) const {
+    if (!index)
+      return;
+    objectIndexes_.remove(index);
+    ObjectIndex::destroy(index, indexAllocator());
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  // Returns the index of the array whose first element is the specified slot,
+  // or null if it doesn't have one
+  ArrayIndex* getArrayIndex(SlotId head) const {
+    return arrayIndexes_.find(head);
+  }
+
+  // Allocates an empty index for the specified array
+  ArrayIndex* createArrayIndex(SlotId head, size_t elements) const {
+    auto index = ArrayIndex::create(head, elements, indexAllocator());
+    if (index)
+      arrayIndexes_.add(index);
+    return index;
+  }
+
+  // Doubles the capacity of the index; destroys it if the allocation fails
+  ArrayIndex* growArrayIndex(ArrayIndex* index) const {
+    arrayIndexes_.remove(index);
+    auto newIndex = ArrayIndex::grow(index, indexAllocator());
+    if (newIndex)
+      arrayIndexes_.add(newIndex);
+    else
+      ArrayIndex::destroy(index, indexAllocator());
+    return newIndex;
+  }
+
+  void destroyArrayIndex(ArrayIndex* index) const {
+    if (!index)
+      return;
+    arrayIndexes_.remove(index);
+    ArrayIndex::destroy(index, indexAllocator());
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // Allocates an empty packed array; returns null if the allocation fails
+  PackedArray* createPackedArray(uint8_t type, size_t capacity) {
+    auto array = PackedArray::create(type, capacity, packedArrayAllocator());
+    if (array)
+      packedArrayList_.add(array);
+    else
+      overflowed_ = true;
+    return array;
+  }
+
+  // See PackedArray::resize()
+  PackedArray* resizePackedArray(PackedArray* array, uint8_t type,
+                                 size_t capacity) {
+    auto newArray =
+        PackedArray::resize(array, type, capacity, packedArrayAllocator());
+    if (newArray)
+      packedArrayList_.relink(newArray);
+    else
+      overflowed_ = true;
+    return newArray;
+  }
+
+  void destroyPackedArray(PackedArray* array) {
+    packedArrayList_.remove(array);
+    PackedArray::destroy(array, packedArrayAllocator());
+  }
+#endif
+
+  void clear() {
+    if (recycleStrings_) {
+      // the strings, plus the one that was being built
+      size_t stringBytes = stringPool_.arenaSize(blockOverhead) +
+                           stringFootprint(stringBuilderPeak_);
+      if (stringBytes > recycledStringBytes_)
+        recycledStringBytes_ = stringBytes;
+    }
+    stringBuilderPeak_ = 0;
+    clearIndexes();
+    clearPackedArrays();
+    variantPools_.clear(poolAllocator(), keepCapacity_);
+    overflowed_ = false;
+    stringPool_.clear(stringAllocator());
+    if (stringReserve_)
+      stringReserve_->clear();
+    updateStringReserve();
+  }
+
+  void shrinkToFit() {
+    variantPools_.shrinkToFit(poolAllocator());
+  }
+
+ private:
+  void clearIndexes() {
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+    while (!objectIndexes_.empty())
+      destroyObjectIndex(objectIndexes_.first());
+#endif
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+    while (!arrayIndexes_.empty())
+      destroyArrayIndex(arrayIndexes_.first());
+#endif
+  }
+
+  void clearPackedArrays() {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    while (!packedArrayList_.empty())
+      destroyPackedArray(packedArrayList_.first());
+#endif
+  }
+
+  // (Re)allocates the string buffer to match the reservation, or the strings
+  // that clear() recycles if there are more. There must be no string.
+  bool updateStringReserve() {
+    size_t bytes = reservedStringBytes_ > recycledStringBytes_
+                       ? reservedStringBytes_
+                       : recycledStringBytes_;
+    size_t capacity = stringReserve_ ? stringReserve_->capacity() : 0;
+    if (bytes ? bytes <= capacity : !capacity)
+      return true;
+    stringPool_.clear(stringAllocator());  // the index may be in the buffer
+    if (stringReserve_)
+      StringReserve::destroy(stringReserve_, allocator_);
+    stringReserve_ = nullptr;
+    if (bytes)
+      stringReserve_ = StringReserve::create(bytes, allocator_);
+#if ARDUINOJSON_ENABLE_ALLOCATION_STATS
+    strings_.upstream_ = stringUpstream();
+    stringBuilder_.upstream_ = stringUpstream();
+#endif
+    return stringReserve_ || !bytes;
+  }
+
+  Allocator* stringUpstream() {
+    if (stringReserve_)
+      return stringReserve_;
+    return allocator_;
+  }
+
+  // With ARDUINOJSON_ENABLE_ALLOCATION_STATS, each kind of allocation goes
+  // through its own InstrumentedAllocator
+#if ARDUINOJSON_ENABLE_ALLOCATION_STATS
+  static const size_t blockOverhead = InstrumentedAllocator::headerSize;
+
+  Allocator* poolAllocator() {
+    return &pools_;
+  }
+
+  Allocator* stringAllocator() {
+    return &strings_;
+  }
+
+  Allocator* stringBuilderAllocator() {
+    return &stringBuilder_;
+  }
+
+  Allocator* indexAllocator() const {
+    return &indexes_;
+  }
+
+  Allocator* packedArrayAllocator() {
+    return &packedArrays_;
+  }
+#else
+  static const size_t blockOverhead = 0;
+
+  Allocator* poolAllocator() {
+    return allocator_;
+  }
+
+  Allocator* stringAllocator() {
+    return stringUpstream();
+  }
+
+  Allocator* stringBuilderAllocator() {
+    return stringUpstream();
+  }
+
+  Allocator* indexAllocator() const {
+    return allocator_;
+  }
+
+  Allocator* packedArrayAllocator() {
+    return allocator_;
+  }
+#endif
+
+  Allocator* allocator_;
+#if ARDUINOJSON_ENABLE_ALLOCATION_STATS
+  InstrumentedAllocator pools_;
+  InstrumentedAllocator strings_;
+  InstrumentedAllocator stringBuilder_;
+  mutable InstrumentedAllocator indexes_;  // like the indexes
+  InstrumentedAllocator packedArrays_;
+#endif
+  bool overflowed_;
+  bool keepCapacity_ = false;
+  bool recycleStrings_ = false;
+#if ARDUINOJSON_AUTO_SHRINK
+  bool autoShrink_ = true;
+#endif
+  StringReserve* stringReserve_ = nullptr;
+  size_t reservedStringBytes_ = 0;
+  size_t recycledStringBytes_ = 0;  // the strings freed by clear()
+  size_t stringBuilderPeak_ = 0;  // the largest string builder since clear()
+  SymbolTableLink symbols_;
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  mutable CollectionIndexList<ObjectIndex> objectIndexes_;
+#endif
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  mutable CollectionIndexList<ArrayIndex> arrayIndexes_;
+#endif
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  PackedArrayList packedArrayList_;
+#endif
+  StringPool stringPool_;
+  VariantPoolList variantPools_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,90 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Strings/JsonString.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Stores the current string in a fixed-size buffer, so it never allocates.
+// Each string overwrites the previous one.
+// When the buffer is full, the string is invalid, unless a sink is set: the
+// buffer then passes its content to the sink and starts over.
+template <size_t TCapacity>
+class StringBuffer {
+ public:
+  using Sink = void (*)(void* context, JsonString part);
+
+  void setSink(Sink sink, void* context) {
+    sink_ = sink;
+    sinkContext_ = context;
+  }
+
+  void startString() {
+    size_ = 0;
+    overflowed_ = false;
+  }
+
+  void append(const char* s) {
+    while (*s)
+      append(*s++);
+  }
+
+  void append(const char* s, size_t n) {
+    while (n > TCapacity - size_) {
+      size_t part = TCapacity - size_;
+      memcpy(buffer_ + size_, s, part);
+      size_ += part;
+      if (!flush())
+        return;
+      s += part;
+      n -= part;
+    }
+    memcpy(buffer_ + size_, s, n);
+    size_ += n;
+  }
+
+  void append(char c) {
+    if (size_ == TCapacity && !flush())
+      return;
+    buffer_[size_++] = c;
+  }
+
+  // Returns false if the string didn't fit in the buffer
+  bool isValid() const {
+    return !overflowed_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  JsonString str() {
+    buffer_[size_] = 0;
+    return JsonString(buffer_, size_, JsonString::Copied);
+  }
+
+ private:
+  // Passes the full buffer to the sink; returns false if there is none
+  bool flush() {
+    if (!sink_) {
+      overflowed_ = true;
+      return false;
+    }
+    sink_(sinkContext_, str());
+    size_ = 0;
+    return true;
+  }
+
+  char buffer_[TCapacity + 1];  // +1 for the terminator
+  size_t size_ = 0;
+  bool overflowed_ = false;
+  Sink sink_ = nullptr;
+  void* sinkContext_ = nullptr;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
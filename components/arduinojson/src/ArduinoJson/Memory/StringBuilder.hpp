@@ -5,6 +5,9 @@
 #pragma once
 
 #include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+#include <string.h>  // memcpy
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
@@ -40,14 +43,43 @@ class StringBuilder {
     return node;
   }
 
+  // Adds a member with the current string as key: linked to the SymbolTable
+  // of the document if it has one (the node is kept for the next string),
+  // stored in the string pool otherwise.
+  VariantData* addMember(ObjectData& object) {
+    ARDUINOJSON_ASSERT(node_ != nullptr);
+    auto key = resources_->internKey(adaptString(node_->data, size_));
+    if (key)
+      return object.addMember(adaptString(key), resources_);
+    return object.addMember(save(), resources_);
+  }
+
+  // Stores the string in the variant, or in the string pool if it's too long;
+  // a tiny string keeps the node for the next string.
+  void save(VariantData* variant) {
+    ARDUINOJSON_ASSERT(node_ != nullptr);
+    if (!variant->setTinyString(adaptString(node_->data, size_)))
+      variant->setOwnedString(save());
+  }
+
   void append(const char* s) {
     while (*s)
       append(*s++);
   }
 
   void append(const char* s, size_t n) {
-    while (n-- > 0)  // TODO: memcpy
-      append(*s++);
+    if (!node_)
+      return;
+    if (size_ + n > node_->length) {
+      size_t capacity = node_->length;
+      while (size_ + n > capacity)
+        capacity = capacity * 2U + 1;
+      node_ = resources_->resizeString(node_, capacity);
+      if (!node_)
+        return;
+    }
+    memcpy(node_->data + size_, s, n);
+    size_ += n;
   }
 
   void append(char c) {
@@ -0,0 +1,104 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Strings/JsonString.hpp>
+
+#include <stdint.h>  // uint32_t
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The string storage of the sizers (see DeserializationOption::ExactSize).
+// It computes the length and the hash of the strings, and keeps a temporary
+// copy so the ResourceCounter can compare them and the filter can look up the
+// keys. If the copy can't grow, only the length and the hash remain.
+class StringCounter {
+ public:
+  explicit StringCounter(Allocator* allocator) : allocator_(allocator) {}
+
+  // Doesn't copy the string, only the allocator
+  StringCounter(const StringCounter& src) : allocator_(src.allocator_) {}
+
+  ~StringCounter() {
+    if (buffer_)
+      allocator_->deallocate(buffer_);
+  }
+
+  StringCounter& operator=(const StringCounter&) = delete;
+
+  void startString() {
+    size_ = 0;
+    stored_ = 0;
+    hash_ = 2166136261u;
+  }
+
+  void append(const char* s) {
+    while (*s)
+      append(*s++);
+  }
+
+  void append(const char* s, size_t n) {
+    for (size_t i = 0; i < n; i++)
+      append(s[i]);
+  }
+
+  void append(char c) {
+    if (stored_ == size_ && (stored_ < capacity_ || grow()))
+      buffer_[stored_++] = c;
+    size_++;
+    hash_ ^= uint8_t(c);  // FNV-1a
+    hash_ *= 16777619u;
+  }
+
+  bool isValid() const {
+    return true;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  uint32_t hash() const {
+    return hash_;
+  }
+
+  // Returns false if the copy of the string is incomplete, in which case it
+  // can't be compared nor looked up in a filter
+  bool isComplete() const {
+    return stored_ == size_;
+  }
+
+  // Requires isComplete()
+  JsonString str() {
+    ARDUINOJSON_ASSERT(isComplete());
+    if (!buffer_)
+      return JsonString("", 0, JsonString::Linked);
+    buffer_[size_] = 0;
+    return JsonString(buffer_, size_, JsonString::Copied);
+  }
+
+ private:
+  bool grow() {
+    size_t capacity = capacity_ ? capacity_ * 2 : 31;
+    auto buffer = static_cast<char*>(
+        buffer_ ? allocator_->reallocate(buffer_, capacity + 1)
+                : allocator_->allocate(capacity + 1));
+    if (!buffer)
+      return false;
+    buffer_ = buffer;
+    capacity_ = capacity;
+    return true;
+  }
+
+  Allocator* allocator_;
+  char* buffer_ = nullptr;
+  size_t capacity_ = 0;  // not counting the terminator
+  size_t size_ = 0;
+  size_t stored_ = 0;  // the number of characters in buffer_
+  uint32_t hash_ = 0;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
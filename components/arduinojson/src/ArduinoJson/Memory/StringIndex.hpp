@@ -0,0 +1,158 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/StringNode.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+#include <string.h>  // memset
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A hash table of the StringNodes of a StringPool (see
+// ARDUINOJSON_ENABLE_STRING_INDEX)
+// Open addressing with linear probing; the hash is cached in StringNode.
+// The table is only an accelerator: if it can't be allocated, the StringPool
+// falls back to searching its linked list.
+class StringIndex {
+ public:
+  // Below this number of strings, the linked list is fast enough
+  static const size_t minStrings = 16;
+
+  StringIndex() = default;
+  StringIndex(const StringIndex&) = delete;
+  void operator=(StringIndex&& src) = delete;
+
+  ~StringIndex() {
+    ARDUINOJSON_ASSERT(table_ == nullptr);
+  }
+
+  friend void swap(StringIndex& a, StringIndex& b) {
+    swap_(a.table_, b.table_);
+    swap_(a.capacity_, b.capacity_);
+  }
+
+  // FNV-1a
+  template <typename TAdaptedString>
+  static uint32_t hash(const TAdaptedString& str) {
+    uint32_t h = 2166136261u;
+    size_t n = str.size();
+    for (size_t i = 0; i < n; i++) {
+      h ^= uint8_t(str[i]);
+      h *= 16777619u;
+    }
+    return h;
+  }
+
+  bool isEnabled() const {
+    return table_ != nullptr;
+  }
+
+  // Returns the size of the table in bytes
+  size_t size() const {
+    return capacity_ * sizeof(StringNode*);
+  }
+
+  // Returns the capacity of the table for the specified number of strings,
+  // or 0 if they don't need a table
+  static size_t capacityFor(size_t count) {
+    if (count < minStrings)
+      return 0;
+    size_t capacity = minStrings * 2;
+    while (count * 4 > capacity * 3)  // keep the load factor under 75%
+      capacity *= 2;
+    return capacity;
+  }
+
+  void clear(Allocator* allocator) {
+    if (table_)
+      allocator->deallocate(table_);
+    table_ = nullptr;
+    capacity_ = 0;
+  }
+
+  template <typename TAdaptedString>
+  StringNode* find(const TAdaptedString& str, uint32_t h) const {
+    ARDUINOJSON_ASSERT(table_ != nullptr);
+    for (size_t i = h & mask(); table_[i]; i = (i + 1) & mask()) {
+      auto node = table_[i];
+      if (node->hash == h &&
+          stringEquals(str, adaptString(node->data, node->length)))
+        return node;
+    }
+    return nullptr;
+  }
+
+  // Adds the node that was just inserted in the linked list.
+  // count is the number of strings, including the new one
+  void add(StringNode* node, StringNode* strings, size_t count,
+           Allocator* allocator) {
+    if (count * 4 > capacity_ * 3) {  // keep the load factor under 75%
+      size_t capacity = capacityFor(count);
+      if (!capacity)
+        return;
+      rebuild(strings, capacity, allocator);
+    } else {
+      insert(node);
+    }
+  }
+
+  void remove(StringNode* node) {
+    if (!table_)
+      return;
+
+    size_t i = node->hash & mask();
+    while (table_[i] != node) {
+      ARDUINOJSON_ASSERT(table_[i] != nullptr);
+      i = (i + 1) & mask();
+    }
+
+    // Backward shift deletion: move up the following nodes that would no
+    // longer be reachable
+    for (size_t j = (i + 1) & mask(); table_[j]; j = (j + 1) & mask()) {
+      size_t home = table_[j]->hash & mask();
+      bool reachable =
+          i <= j ? (i < home && home <= j) : (i < home || home <= j);
+      if (!reachable) {
+        table_[i] = table_[j];
+        i = j;
+      }
+    }
+    table_[i] = nullptr;
+  }
+
+ private:
+  size_t mask() const {
+    return capacity_ - 1;
+  }
+
+  void insert(StringNode* node) {
+    size_t i = node->hash & mask();
+    while (table_[i])
+      i = (i + 1) & mask();
+    table_[i] = node;
+  }
+
+  void rebuild(StringNode* strings, size_t capacity, Allocator* allocator) {
+    clear(allocator);
+    auto table = reinterpret_cast<StringNode**>(
+        allocator->allocate(capacity * sizeof(StringNode*)));
+    if (!table)
+      return;  // the pool will search the linked list
+    memset(table, 0, capacity * sizeof(StringNode*));
+    table_ = table;
+    capacity_ = capacity;
+    for (auto node = strings; node; node = node->next)
+      insert(node);
+  }
+
+  StringNode** table_ = nullptr;
+  size_t capacity_ = 0;  // a power of two
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
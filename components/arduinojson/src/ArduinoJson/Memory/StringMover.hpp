@@ -0,0 +1,71 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Strings/JsonString.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+#include <string.h>  // memmove
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Writes the unescaped strings back into the input buffer.
+// This is safe because the write pointer never passes the read pointer: an
+// escape sequence is always longer than the character it produces, and the
+// terminator overwrites the closing quote (or the colon after a key).
+class StringMover {
+ public:
+  StringMover(char* ptr) : writePtr_(ptr), startPtr_(ptr) {}
+
+  void startString() {
+    startPtr_ = writePtr_;
+  }
+
+  const char* save() {
+    const char* s = startPtr_;
+    *writePtr_++ = 0;
+    return s;
+  }
+
+  // Links the variant to the string, which is already in the input
+  void save(VariantData* variant) {
+    variant->setLinkedString(save());
+  }
+
+  void append(const char* s) {
+    while (*s)
+      append(*s++);
+  }
+
+  void append(const char* s, size_t n) {
+    if (writePtr_ != s)  // no need to move until the first escape sequence
+      memmove(writePtr_, s, n);
+    writePtr_ += n;
+  }
+
+  void append(char c) {
+    *writePtr_++ = c;
+  }
+
+  bool isValid() const {
+    return true;
+  }
+
+  size_t size() const {
+    return size_t(writePtr_ - startPtr_);
+  }
+
+  JsonString str() const {
+    *writePtr_ = 0;
+    return JsonString(startPtr_, size(), JsonString::Linked);
+  }
+
+ private:
+  char* writePtr_;
+  char* startPtr_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
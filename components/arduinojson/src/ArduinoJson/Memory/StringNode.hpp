@@ -22,6 +22,10 @@ struct StringNode {
   using length_type = uint_t<ARDUINOJSON_STRING_LENGTH_SIZE * 8>::type;
 
   struct StringNode* next;
+#if ARDUINOJSON_ENABLE_STRING_INDEX
+  struct StringNode* prev;
+  uint32_t hash;  // set by StringPool
+#endif
   references_type references;
   length_type length;
   char data[1];
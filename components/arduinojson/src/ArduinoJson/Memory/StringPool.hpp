@@ -0,0 +1,194 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/ArenaAllocator.hpp>
+#include <ArduinoJson/Memory/StringNode.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+#if ARDUINOJSON_ENABLE_STRING_INDEX
+#  include <ArduinoJson/Memory/StringIndex.hpp>
+#endif
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+class VariantSlot;
+class VariantPool;
+
+class StringPool {
+ public:
+  StringPool() = default;
+  StringPool(const StringPool&) = delete;
+  void operator=(StringPool&& src) = delete;
+
+  ~StringPool() {
+    ARDUINOJSON_ASSERT(strings_ == nullptr);
+  }
+
+  friend void swap(StringPool& a, StringPool& b) {
+    swap_(a.strings_, b.strings_);
+#if ARDUINOJSON_ENABLE_STRING_INDEX
+    swap(a.index_, b.index_);
+    swap_(a.count_, b.count_);
+#endif
+  }
+
+  void clear(Allocator* allocator) {
+    while (strings_) {
+      auto node = strings_;
+      strings_ = node->next;
+      StringNode::destroy(node, allocator);
+    }
+#if ARDUINOJSON_ENABLE_STRING_INDEX
+    index_.clear(allocator);
+    count_ = 0;
+#endif
+  }
+
+  bool empty() const {
+    return strings_ == nullptr;
+  }
+
+  size_t size() const {
+    size_t total = 0;
+    for (auto node = strings_; node; node = node->next)
+      total += sizeofString(node->length);
+    return total;
+  }
+
+  // Returns the number of bytes that these strings take in an ArenaAllocator,
+  // including the index and the smaller tables it replaced.
+  // overhead is the number of bytes that the allocator adds to each block.
+  size_t arenaSize(size_t overhead) const {
+    size_t total = 0;
+    for (auto node = strings_; node; node = node->next)
+      total += ArenaAllocator::footprint(sizeofString(node->length) + overhead);
+#if ARDUINOJSON_ENABLE_STRING_INDEX
+    if (index_.isEnabled())
+      total += 2 * ArenaAllocator::footprint(index_.size() + overhead);
+#endif
+    return total;
+  }
+
+  // Returns the number of bytes that the index of the specified number of
+  // strings takes in an ArenaAllocator, like arenaSize()
+  static size_t indexArenaSize(size_t count, size_t overhead) {
+#if ARDUINOJSON_ENABLE_STRING_INDEX
+    size_t capacity = StringIndex::capacityFor(count);
+    if (capacity)
+      return 2 * ArenaAllocator::footprint(capacity * sizeof(StringNode*) +
+                                           overhead);
+#else
+    (void)count;
+    (void)overhead;
+#endif
+    return 0;
+  }
+
+  template <typename TAdaptedString>
+  StringNode* add(TAdaptedString str, Allocator* allocator) {
+    ARDUINOJSON_ASSERT(str.isNull() == false);
+
+    auto node = get(str);
+    if (node) {
+      node->references++;
+      return node;
+    }
+
+    size_t n = str.size();
+
+    node = StringNode::create(n, allocator);
+    if (!node)
+      return nullptr;
+
+    stringGetChars(str, node->data, n);
+    node->data[n] = 0;  // force NUL terminator
+    add(node, allocator);
+    return node;
+  }
+
+  void add(StringNode* node, Allocator* allocator) {
+    ARDUINOJSON_ASSERT(node != nullptr);
+    node->next = strings_;
+#if ARDUINOJSON_ENABLE_STRING_INDEX
+    node->prev = nullptr;
+    node->hash = StringIndex::hash(adaptString(node->data, node->length));
+    if (strings_)
+      strings_->prev = node;
+#endif
+    strings_ = node;
+#if ARDUINOJSON_ENABLE_STRING_INDEX
+    index_.add(node, strings_, ++count_, allocator);
+#else
+    (void)allocator;
+#endif
+  }
+
+  template <typename TAdaptedString>
+  StringNode* get(const TAdaptedString& str) const {
+#if ARDUINOJSON_ENABLE_STRING_INDEX
+    uint32_t hash = StringIndex::hash(str);
+    if (index_.isEnabled())
+      return index_.find(str, hash);
+    for (auto node = strings_; node; node = node->next) {
+      if (node->hash == hash &&
+          stringEquals(str, adaptString(node->data, node->length)))
+        return node;
+    }
+#else
+    for (auto node = strings_; node; node = node->next) {
+      if (stringEquals(str, adaptString(node->data, node->length)))
+        return node;
+    }
+#endif
+    return nullptr;
+  }
+
+  void dereference(const char* s, Allocator* allocator) {
+#if ARDUINOJSON_ENABLE_STRING_INDEX
+    // s always points to the data of a node of this pool
+    auto node = reinterpret_cast<StringNode*>(const_cast<char*>(s) -
+                                              offsetof(StringNode, data));
+    if (--node->references == 0) {
+      index_.remove(node);
+      if (node->prev)
+        node->prev->next = node->next;
+      else
+        strings_ = node->next;
+      if (node->next)
+        node->next->prev = node->prev;
+      count_--;
+      StringNode::destroy(node, allocator);
+    }
+#else
+    StringNode* prev = nullptr;
+    for (auto node = strings_; node; node = node->next) {
+      if (node->data == s) {
+        if (--node->references == 0) {
+          if (prev)
+            prev->next = node->next;
+          else
+            strings_ = node->next;
+          StringNode::destroy(node, allocator);
+        }
+        return;
+      }
+      prev = node;
+    }
+#endif
+  }
+
+ private:
+  StringNode* strings_ = nullptr;
+#if ARDUINOJSON_ENABLE_STRING_INDEX
+  StringIndex index_;
+  size_t count_ = 0;
+#endif
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,54 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Alignment.hpp>
+#include <ArduinoJson/Memory/ArenaAllocator.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The memory reserved for the strings of a ResourceManager.
+// It's an ArenaAllocator placed at the beginning of its own buffer, so the
+// ResourceManager only needs a pointer. The strings that don't fit go to the
+// ResourceManager's allocator.
+class StringReserve final : public ArenaAllocator {
+ public:
+  static StringReserve* create(size_t capacity, Allocator* allocator) {
+    const size_t headerSize = AddPadding<sizeof(StringReserve)>::value;
+    void* p = allocator->allocate(headerSize + capacity);
+    if (!p)
+      return nullptr;
+    return new (p) StringReserve(reinterpret_cast<char*>(p) + headerSize,
+                                 capacity, allocator);
+  }
+
+  static void destroy(StringReserve* reserve, Allocator* allocator) {
+    reserve->~StringReserve();
+    allocator->deallocate(reserve);
+  }
+
+  size_t capacity() const {
+    return size_;
+  }
+
+ private:
+  StringReserve(void* buffer, size_t capacity, Allocator* fallback)
+      : ArenaAllocator(buffer, capacity, fallback), size_(capacity) {}
+
+  // Placement new
+  static void* operator new(size_t, void* p) noexcept {
+    return p;
+  }
+
+  static void operator delete(void*, void*) noexcept {}
+
+  // Required by the virtual destructor, but never called: destroy() frees the
+  // memory with the allocator
+  static void operator delete(void*) noexcept {}
+
+  size_t size_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,142 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/StringPool.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/mutex.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+class SymbolTable;
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+class ResourceManager;
+
+// The attachment of a document to a SymbolTable; the table keeps a list of
+// them, to know if a document is still attached.
+struct SymbolTableLink {
+  SymbolTable* table = nullptr;
+  SymbolTableLink* next = nullptr;
+};
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A table of object keys that several JsonDocuments share (see
+// JsonDocument::setSymbolTable()).
+// Each key is stored once, and the documents link to it instead of copying it
+// in their own memory pool. The keys stay in the table until clear() or the
+// destruction of the table, which both require that no document is attached:
+// detach them with JsonDocument::setSymbolTable(nullptr), or destroy them,
+// before the table.
+// The documents can be used from different threads: the table serializes the
+// insertions with lock() and unlock(). By default, they use a spin lock;
+// override them to use a mutex of your RTOS instead.
+class SymbolTable {
+  friend class detail::ResourceManager;
+
+ public:
+  explicit SymbolTable(
+      Allocator* allocator = detail::DefaultAllocator::instance())
+      : allocator_(allocator) {}
+
+  SymbolTable(const SymbolTable&) = delete;
+  SymbolTable& operator=(const SymbolTable&) = delete;
+
+  // The documents must be detached: their keys are freed
+  virtual ~SymbolTable() {
+    ARDUINOJSON_ASSERT(links_ == nullptr);
+    lock();
+    for (auto link = links_; link; link = link->next)
+      link->table = nullptr;  // at least, don't let them detach later
+    strings_.clear(allocator_);
+    unlock();
+  }
+
+  // Returns the number of documents attached to this table
+  size_t documents() {
+    lock();
+    size_t n = 0;
+    for (auto link = links_; link; link = link->next)
+      n++;
+    unlock();
+    return n;
+  }
+
+  // Returns the number of bytes of the keys
+  size_t size() {
+    lock();
+    size_t n = strings_.size();
+    unlock();
+    return n;
+  }
+
+  // Frees the keys.
+  // Returns false, and does nothing, if a document is still attached.
+  bool clear() {
+    lock();
+    bool unused = links_ == nullptr;
+    if (unused)
+      strings_.clear(allocator_);
+    unlock();
+    return unused;
+  }
+
+ protected:
+  virtual void lock() {
+    mutex_.lock();
+  }
+
+  virtual void unlock() {
+    mutex_.unlock();
+  }
+
+ private:
+  // Returns the stored copy of the key, or null if it couldn't be stored
+  template <typename TAdaptedString>
+  const char* intern(TAdaptedString key) {
+    size_t n = key.size();
+    for (size_t i = 0; i < n; i++) {
+      if (key[i] == 0)
+        return nullptr;  // a linked key stops at the first '\0'
+    }
+    lock();
+    auto node = strings_.get(key);
+    if (!node)
+      node = strings_.add(key, allocator_);
+    unlock();
+    return node ? node->data : nullptr;
+  }
+
+  void attach(detail::SymbolTableLink* link) {
+    ARDUINOJSON_ASSERT(link->table == nullptr);
+    lock();
+    link->table = this;
+    link->next = links_;
+    links_ = link;
+    unlock();
+  }
+
+  void detach(detail::SymbolTableLink* link) {
+    ARDUINOJSON_ASSERT(link->table == this);
+    lock();
+    auto prev = &links_;
+    while (*prev != link)
+      prev = &(*prev)->next;
+    *prev = link->next;
+    link->table = nullptr;
+    link->next = nullptr;
+    unlock();
+  }
+
+  Allocator* allocator_;
+  detail::StringPool strings_;
+  detail::SymbolTableLink* links_ = nullptr;
+  detail::Mutex mutex_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
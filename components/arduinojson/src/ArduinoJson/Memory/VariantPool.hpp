@@ -40,15 +40,17 @@ class SlotWithId {
   SlotId id_;
 };
 
+// A range of slots in a block of VariantPoolList.
+// The pool doesn't own its slots: VariantPoolList frees the blocks.
 class VariantPool {
  public:
-  void create(SlotCount cap, Allocator* allocator);
-  void destroy(Allocator* allocator);
+  void create(VariantSlot* slots, SlotCount cap);
+  void relocate(VariantSlot* slots);
 
   SlotWithId allocSlot();
   VariantSlot* getSlot(SlotId id) const;
   void clear();
-  void shrinkToFit(Allocator*);
+  void shrinkToFit();
   SlotCount usage() const;
 
   static SlotCount bytesToSlots(size_t);
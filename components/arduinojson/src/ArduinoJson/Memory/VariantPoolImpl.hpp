@@ -0,0 +1,209 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/VariantPool.hpp>
+#include <ArduinoJson/Variant/VariantSlot.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+inline void VariantPool::create(VariantSlot* slots, SlotCount cap) {
+  ARDUINOJSON_ASSERT(cap > 0);
+  slots_ = slots;
+  capacity_ = cap;
+  usage_ = 0;
+}
+
+inline void VariantPool::relocate(VariantSlot* slots) {
+  slots_ = slots;
+}
+
+inline void VariantPool::shrinkToFit() {
+  capacity_ = usage_;
+}
+
+inline SlotWithId VariantPool::allocSlot() {
+  if (usage_ >= capacity_)
+    return {};
+  auto index = usage_++;
+  auto slot = &slots_[index];
+  return {new (slot) VariantSlot, SlotId(index)};
+}
+
+inline VariantSlot* VariantPool::getSlot(SlotId id) const {
+  ARDUINOJSON_ASSERT(id < usage_);
+  return &slots_[id];
+}
+
+inline SlotCount VariantPool::usage() const {
+  return usage_;
+}
+
+inline void VariantPool::clear() {
+  usage_ = 0;
+}
+
+inline SlotCount VariantPool::bytesToSlots(size_t n) {
+  return static_cast<SlotCount>(n / sizeof(VariantSlot));
+}
+
+inline size_t VariantPool::slotsToBytes(SlotCount n) {
+  return n * sizeof(VariantSlot);
+}
+
+inline VariantPool* VariantPoolList::addPool(Allocator* allocator) {
+  if (count_ == maxPools)
+    return nullptr;
+  if (count_ == capacity_ && !increaseCapacity(allocator))
+    return nullptr;
+  if (!spareCount_ && !useNextBlock(allocator))
+    return nullptr;
+  auto pool = &pools_[count_++];
+  SlotCount poolCapacity = ARDUINOJSON_POOL_CAPACITY;
+  if (count_ == maxPools)  // last pool is smaller because of NULL_SLOT
+    poolCapacity--;
+  if (spareCount_ < poolCapacity)
+    poolCapacity = spareCount_;
+  pool->create(spare_, poolCapacity);
+  spare_ += poolCapacity;
+  spareCount_ = SlotCount(spareCount_ - poolCapacity);
+  return pool;
+}
+
+// Allocates a block and puts it at the front of the unused blocks
+inline bool VariantPoolList::addBlock(SlotCount capacity,
+                                      Allocator* allocator) {
+  static_assert(sizeof(Block) <= sizeof(VariantSlot),
+                "The block header must fit in a slot");
+  ARDUINOJSON_ASSERT(capacity > 0);
+  auto block = reinterpret_cast<Block*>(
+      allocator->allocate((capacity + size_t(1)) * sizeof(VariantSlot)));
+  if (!block)
+    return false;
+  block->next = unused_;
+  block->capacity = capacity;
+  unused_ = block;
+  return true;
+}
+
+// Moves the next unused block to the blocks in use, allocating it if needed
+inline bool VariantPoolList::useNextBlock(Allocator* allocator) {
+  if (!unused_ && !addBlock(nextBlockSize(), allocator))
+    return false;
+  auto block = unused_;
+  unused_ = block->next;
+  block->next = blocks_;
+  block->firstPool = count_;
+  blocks_ = block;
+  spare_ = reinterpret_cast<VariantSlot*>(block) + 1;
+  spareCount_ = block->capacity;
+  return true;
+}
+
+// Frees the unused blocks after the specified one, or all if it's null
+inline void VariantPoolList::freeUnusedBlocks(Block* kept,
+                                              Allocator* allocator) {
+  auto block = kept ? kept->next : unused_;
+  while (block) {
+    auto next = block->next;
+    allocator->deallocate(block);
+    block = next;
+  }
+  if (kept)
+    kept->next = nullptr;
+  else
+    unused_ = nullptr;
+}
+
+inline void VariantPoolList::clear(Allocator* allocator, bool keepBlocks) {
+  count_ = 0;
+  freeList_ = NULL_SLOT;
+  spare_ = nullptr;
+  spareCount_ = 0;
+
+  // put the blocks in use in front of the unused ones, the first one first
+  while (blocks_) {
+    auto block = blocks_;
+    blocks_ = block->next;
+    block->next = unused_;
+    unused_ = block;
+  }
+
+  Block* kept = nullptr;  // the last block to keep
+  if (keepBlocks) {
+    // stop at the first block that shrinkToFit() cut: its last pool would
+    // waste ids and move the pools of the following blocks
+    PoolCount firstPool = 0;
+    for (auto block = unused_; block; block = block->next) {
+      auto pools = PoolCount(
+          (block->capacity + ARDUINOJSON_POOL_CAPACITY - 1) /
+          ARDUINOJSON_POOL_CAPACITY);
+      if (!pools || block->capacity != blockCapacity(firstPool, pools))
+        break;
+      firstPool = PoolCount(firstPool + pools);
+      kept = block;
+    }
+  }
+  if (!kept && isReserved(unused_))
+    kept = unused_;  // the reserved block is the first one
+  freeUnusedBlocks(kept, allocator);
+
+  if (!unused_ && pools_ != preallocatedPools_) {
+    allocator->deallocate(pools_);
+    pools_ = preallocatedPools_;
+    capacity_ = ARDUINOJSON_INITIAL_POOL_COUNT;
+  }
+}
+
+inline void VariantPoolList::shrinkToFit(Allocator* allocator) {
+  if (count_ == 0) {
+    clear(allocator);
+    return;
+  }
+  freeUnusedBlocks(nullptr, allocator);
+
+  // don't shrink the reserved block, which is the first one
+  auto block = blocks_;
+  if (count_ > block->firstPool && (block->next || !isReserved(block))) {
+    auto lastPool = &pools_[count_ - 1];
+    lastPool->shrinkToFit();
+    auto capacity = SlotCount(
+        (count_ - 1 - block->firstPool) * ARDUINOJSON_POOL_CAPACITY +
+        lastPool->usage());
+    auto slots = reinterpret_cast<VariantSlot*>(allocator->reallocate(
+        block, (capacity + size_t(1)) * sizeof(VariantSlot)));
+    ARDUINOJSON_ASSERT(slots != nullptr);  // realloc to smaller can't fail
+    block = reinterpret_cast<Block*>(slots);
+    block->capacity = capacity;
+    blocks_ = block;
+    spare_ = nullptr;
+    spareCount_ = 0;
+    for (PoolCount i = block->firstPool; i < count_; i++)
+      pools_[i].relocate(
+          slots + 1 + (i - block->firstPool) * ARDUINOJSON_POOL_CAPACITY);
+  }
+
+  if (pools_ != preallocatedPools_ && count_ != capacity_ && !reserved_) {
+    pools_ = static_cast<VariantPool*>(
+        allocator->reallocate(pools_, count_ * sizeof(VariantPool)));
+    ARDUINOJSON_ASSERT(pools_ != nullptr);  // realloc to smaller can't fail
+    capacity_ = count_;
+  }
+}
+
+inline SlotWithId VariantPoolList::allocFromFreeList() {
+  ARDUINOJSON_ASSERT(freeList_ != NULL_SLOT);
+  auto id = freeList_;
+  auto slot = getSlot(freeList_);
+  freeList_ = slot->next();
+  return {new (slot) VariantSlot, id};
+}
+
+inline void VariantPoolList::freeSlot(SlotWithId slot) {
+  slot->setNext(freeList_);
+  freeList_ = slot.id();
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
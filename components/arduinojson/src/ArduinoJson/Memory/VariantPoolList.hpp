@@ -0,0 +1,277 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/VariantPool.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+using PoolCount = SlotId;
+
+// The variant pools of a ResourceManager.
+// The pools are allocated in blocks of one or more pools (see
+// ARDUINOJSON_GEOMETRIC_POOL_GROWTH and reserve()), but they all have the
+// same capacity, so that getSlot() remains a division. Only the last pool of a
+// block can be smaller; its remaining ids are unused.
+// clear() keeps the reserved block, or every block when asked to; the kept
+// blocks are reused, in the same order, before allocating new ones.
+class VariantPoolList {
+ public:
+  VariantPoolList() = default;
+
+  ~VariantPoolList() {
+    ARDUINOJSON_ASSERT(count_ == 0);
+    ARDUINOJSON_ASSERT(blocks_ == nullptr);
+    ARDUINOJSON_ASSERT(unused_ == nullptr);
+  }
+
+  friend void swap(VariantPoolList& a, VariantPoolList& b) {
+    bool aUsedPreallocated = a.pools_ == a.preallocatedPools_;
+    bool bUsedPreallocated = b.pools_ == b.preallocatedPools_;
+
+    // Who is using preallocated pools?
+    if (aUsedPreallocated && bUsedPreallocated) {
+      // both of us => swap preallocated pools
+      for (PoolCount i = 0; i < ARDUINOJSON_INITIAL_POOL_COUNT; i++)
+        swap_(a.preallocatedPools_[i], b.preallocatedPools_[i]);
+    } else if (bUsedPreallocated) {
+      // only b => copy b's preallocated pools and give him a's pointer
+      for (PoolCount i = 0; i < b.count_; i++)
+        a.preallocatedPools_[i] = b.preallocatedPools_[i];
+      b.pools_ = a.pools_;
+      a.pools_ = a.preallocatedPools_;
+    } else if (aUsedPreallocated) {
+      // only a => copy a's preallocated pools and give him b's pointer
+      for (PoolCount i = 0; i < a.count_; i++)
+        b.preallocatedPools_[i] = a.preallocatedPools_[i];
+      a.pools_ = b.pools_;
+      b.pools_ = b.preallocatedPools_;
+    } else {
+      // neither => swap pointers
+      swap_(a.pools_, b.pools_);
+    }
+
+    swap_(a.count_, b.count_);
+    swap_(a.capacity_, b.capacity_);
+    swap_(a.freeList_, b.freeList_);
+    swap_(a.blocks_, b.blocks_);
+    swap_(a.unused_, b.unused_);
+    swap_(a.spare_, b.spare_);
+    swap_(a.spareCount_, b.spareCount_);
+    swap_(a.reserved_, b.reserved_);
+  }
+
+  VariantPoolList& operator=(VariantPoolList&& src) {
+    ARDUINOJSON_ASSERT(count_ == 0);
+    if (src.pools_ == src.preallocatedPools_) {
+      memcpy(preallocatedPools_, src.preallocatedPools_,
+             sizeof(preallocatedPools_));
+      pools_ = preallocatedPools_;
+    } else {
+      pools_ = src.pools_;
+      src.pools_ = nullptr;
+    }
+    count_ = src.count_;
+    capacity_ = src.capacity_;
+    blocks_ = src.blocks_;
+    unused_ = src.unused_;
+    spare_ = src.spare_;
+    spareCount_ = src.spareCount_;
+    reserved_ = src.reserved_;
+    src.count_ = 0;
+    src.capacity_ = 0;
+    src.blocks_ = nullptr;
+    src.unused_ = nullptr;
+    src.spare_ = nullptr;
+    src.spareCount_ = 0;
+    src.reserved_ = 0;
+    return *this;
+  }
+
+  SlotWithId allocSlot(Allocator* allocator) {
+    // try to allocate from free list
+    if (freeList_ != NULL_SLOT) {
+      return allocFromFreeList();
+    }
+
+    // try to allocate from last pool (other pools are full)
+    if (count_) {
+      auto slot = allocFromLastPool();
+      if (slot)
+        return slot;
+    }
+
+    // create a new pool and try again
+    auto pool = addPool(allocator);
+    if (!pool)
+      return {};
+
+    return allocFromLastPool();
+  }
+
+  void freeSlot(SlotWithId slot);
+
+  VariantSlot* getSlot(SlotId id) const {
+    if (id == NULL_SLOT)
+      return nullptr;
+    auto poolIndex = SlotId(id / ARDUINOJSON_POOL_CAPACITY);
+    auto indexInPool = SlotId(id % ARDUINOJSON_POOL_CAPACITY);
+    ARDUINOJSON_ASSERT(poolIndex < count_);
+    return pools_[poolIndex].getSlot(indexInPool);
+  }
+
+  // Releases all the slots, but keeps the reserved block, or all the blocks
+  // if keepBlocks is true
+  void clear(Allocator* allocator, bool keepBlocks = false);
+
+  // Frees everything, including the reserved block
+  void destroy(Allocator* allocator) {
+    reserved_ = 0;
+    clear(allocator);
+  }
+
+  SlotCount usage() const {
+    SlotCount total = 0;
+    for (PoolCount i = 0; i < count_; i++)
+      total = SlotCount(total + pools_[i].usage());
+    return total;
+  }
+
+  size_t reservedSlots() const {
+    return reserved_;
+  }
+
+  // Frees the unused blocks and shrinks the last block to the slots in use,
+  // except the reserved block
+  void shrinkToFit(Allocator* allocator);
+
+  // Allocates a single block of exactly the specified number of slots, which
+  // clear() keeps for the next use; its last pool may be smaller than the
+  // others.
+  // If some pools are already in use, the block is allocated after the next
+  // call to clear().
+  bool reserve(size_t slots, Allocator* allocator) {
+    if (slots > blockCapacity(0, maxPools))
+      return false;
+    reserved_ = SlotCount(slots);
+    if (count_ == 0 && !isReserved(unused_)) {
+      freeUnusedBlocks(nullptr, allocator);  // they have the wrong size
+      if (reserved_ && !addBlock(reserved_, allocator))
+        return false;
+    }
+    if (capacity_ < reservedPools() &&
+        !increaseCapacity(allocator, reservedPools()))
+      return false;
+    return true;
+  }
+
+  // Changes the reservation without allocating: the next call to clear()
+  // frees the reserved block if its size doesn't match anymore
+  void setReservation(size_t slots) {
+    ARDUINOJSON_ASSERT(slots <= blockCapacity(0, maxPools));
+    reserved_ = SlotCount(slots);
+  }
+
+ private:
+  // A block of pools.
+  // The header takes the first slot; the pools follow.
+  struct Block {
+    Block* next;  // the previous block in blocks_, the next one in unused_
+    SlotCount capacity;   // number of slots, excluding the header
+    PoolCount firstPool;  // index of the first pool of the block
+  };
+
+  static SlotCount blockCapacity(PoolCount firstPool, PoolCount pools) {
+    size_t capacity = size_t(pools) * ARDUINOJSON_POOL_CAPACITY;
+    if (firstPool + pools == maxPools)  // last pool is smaller
+      capacity--;
+    return SlotCount(capacity);
+  }
+
+  // Returns true if the capacity of the first block matches the reservation
+  bool isReserved(const Block* first) const {
+    return first && reserved_ && first->capacity == reserved_;
+  }
+
+  PoolCount reservedPools() const {
+    return PoolCount((reserved_ + ARDUINOJSON_POOL_CAPACITY - 1) /
+                     ARDUINOJSON_POOL_CAPACITY);
+  }
+
+  // Returns the number of slots of the next block
+  SlotCount nextBlockSize() const {
+    if (count_ == 0 && reserved_)
+      return reserved_;
+    PoolCount size = 1;
+#if ARDUINOJSON_GEOMETRIC_POOL_GROWTH
+    if (count_ > 0)
+      size = count_;  // double the capacity
+#endif
+    if (size > maxPools - count_)
+      size = PoolCount(maxPools - count_);
+    return blockCapacity(count_, size);
+  }
+
+  bool addBlock(SlotCount capacity, Allocator* allocator);
+  bool useNextBlock(Allocator* allocator);
+  void freeUnusedBlocks(Block* kept, Allocator* allocator);
+  SlotWithId allocFromFreeList();
+
+  SlotWithId allocFromLastPool() {
+    ARDUINOJSON_ASSERT(count_ > 0);
+    auto poolIndex = SlotId(count_ - 1);
+    auto slot = pools_[poolIndex].allocSlot();
+    if (!slot)
+      return {};
+    return {slot, SlotId(poolIndex * ARDUINOJSON_POOL_CAPACITY + slot.id())};
+  }
+
+  VariantPool* addPool(Allocator* allocator);
+
+  bool increaseCapacity(Allocator* allocator, PoolCount minCapacity = 0) {
+    if (capacity_ == maxPools)
+      return false;
+    void* newPools;
+    auto newCapacity = PoolCount(capacity_ * 2);
+    if (newCapacity < minCapacity)  // reserve() allocates the array at once
+      newCapacity = minCapacity;
+    if (newCapacity > maxPools)  // after shrinkToFit()
+      newCapacity = maxPools;
+
+    if (pools_ == preallocatedPools_) {
+      newPools = allocator->allocate(newCapacity * sizeof(VariantPool));
+      if (!newPools)
+        return false;
+      memcpy(newPools, preallocatedPools_, sizeof(preallocatedPools_));
+    } else {
+      newPools =
+          allocator->reallocate(pools_, newCapacity * sizeof(VariantPool));
+      if (!newPools)
+        return false;
+    }
+
+    pools_ = static_cast<VariantPool*>(newPools);
+    capacity_ = newCapacity;
+    return true;
+  }
+
+  VariantPool preallocatedPools_[ARDUINOJSON_INITIAL_POOL_COUNT];
+  VariantPool* pools_ = preallocatedPools_;
+  PoolCount count_ = 0;
+  PoolCount capacity_ = ARDUINOJSON_INITIAL_POOL_COUNT;
+  SlotId freeList_ = NULL_SLOT;
+  Block* blocks_ = nullptr;  // the blocks in use, the last one first
+  Block* unused_ = nullptr;  // the blocks kept by clear(), in order of use
+  VariantSlot* spare_ = nullptr;  // the slots of the last block not in a pool
+  SlotCount spareCount_ = 0;
+  SlotCount reserved_ = 0;  // the capacity of the block to keep
+
+ public:
+  static const PoolCount maxPools =
+      PoolCount(NULL_SLOT / ARDUINOJSON_POOL_CAPACITY + 1);
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
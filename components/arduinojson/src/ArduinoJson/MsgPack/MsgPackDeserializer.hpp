@@ -6,6 +6,7 @@
 
 #include <ArduinoJson/Deserialization/deserialize.hpp>
 #include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/MsgPack/MsgPackSizer.hpp>
 #include <ArduinoJson/MsgPack/endianess.hpp>
 #include <ArduinoJson/MsgPack/ieee754.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
@@ -16,6 +17,9 @@ ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 template <typename TReader>
 class MsgPackDeserializer {
  public:
+  // The first pass of DeserializationOption::ExactSize
+  using Sizer = MsgPackSizer<TReader>;
+
   MsgPackDeserializer(ResourceManager* resources, TReader reader)
       : resources_(resources),
         reader_(reader),
@@ -242,6 +246,10 @@ class MsgPackDeserializer {
   }
 
   DeserializationError::Code skipBytes(size_t n) {
+    return skipBytes(n, is_contiguous_reader<TReader>());
+  }
+
+  DeserializationError::Code skipBytes(size_t n, false_type) {
     for (; n; --n) {
       if (reader_.read() < 0)
         return DeserializationError::IncompleteInput;
@@ -249,6 +257,15 @@ class MsgPackDeserializer {
     return DeserializationError::Ok;
   }
 
+  DeserializationError::Code skipBytes(size_t n, true_type) {
+    const char* end;
+    const char* ptr = reader_.peek(end);
+    if (end && size_t(end - ptr) < n)
+      return DeserializationError::IncompleteInput;
+    reader_.advance(n);
+    return DeserializationError::Ok;
+  }
+
   template <typename T>
   DeserializationError::Code readInteger(T& value) {
     DeserializationError::Code err;
@@ -370,7 +387,7 @@ class MsgPackDeserializer {
     if (err)
       return err;
 
-    variant->setOwnedString(stringBuilder_.save());
+    stringBuilder_.save(variant);
     return DeserializationError::Ok;
   }
 
@@ -378,6 +395,19 @@ class MsgPackDeserializer {
     DeserializationError::Code err;
 
     stringBuilder_.startString();
+    err = appendBytes(n, is_contiguous_reader<TReader>());
+    if (err)
+      return err;
+
+    if (!stringBuilder_.isValid())
+      return DeserializationError::NoMemory;
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code appendBytes(size_t n, false_type) {
+    DeserializationError::Code err;
+
     for (; n; --n) {
       uint8_t c;
 
@@ -388,9 +418,16 @@ class MsgPackDeserializer {
       stringBuilder_.append(static_cast<char>(c));
     }
 
-    if (!stringBuilder_.isValid())
-      return DeserializationError::NoMemory;
+    return DeserializationError::Ok;
+  }
 
+  DeserializationError::Code appendBytes(size_t n, true_type) {
+    const char* end;
+    const char* ptr = reader_.peek(end);
+    if (end && size_t(end - ptr) < n)
+      return DeserializationError::IncompleteInput;
+    stringBuilder_.append(ptr, n);
+    reader_.advance(n);
     return DeserializationError::Ok;
   }
 
@@ -493,9 +530,7 @@ class MsgPackDeserializer {
         ARDUINOJSON_ASSERT(object != 0);
 
         // Save key in memory pool.
-        auto savedKey = stringBuilder_.save();
-
-        member = object->addMember(savedKey, resources_);
+        member = stringBuilder_.addMember(*object);
         if (!member)
           return DeserializationError::NoMemory;
       } else {
@@ -49,16 +49,7 @@ class MsgPackSerializer : public VariantDataVisitor<size_t> {
   }
 
   size_t visit(const ArrayData& array) {
-    size_t n = array.size(resources_);
-    if (n < 0x10) {
-      writeByte(uint8_t(0x90 + n));
-    } else if (n < 0x10000) {
-      writeByte(0xDC);
-      writeInteger(uint16_t(n));
-    } else {
-      writeByte(0xDD);
-      writeInteger(uint32_t(n));
-    }
+    writeArrayHeader(array.size(resources_));
 
     auto slotId = array.head();
     while (slotId != NULL_SLOT) {
@@ -70,6 +61,15 @@ class MsgPackSerializer : public VariantDataVisitor<size_t> {
     return bytesWritten();
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  size_t visit(const PackedArray& array) {
+    writeArrayHeader(array.size);
+    for (size_t i = 0; i < array.size; i++)
+      array.accept(i, *this);
+    return bytesWritten();
+  }
+#endif
+
   size_t visit(const ObjectData& object) {
     size_t n = object.size(resources_);
     if (n < 0x10) {
@@ -210,6 +210,18 @@ class MsgPackSerializer : public VariantDataVisitor<size_t> {
     writeBytes(reinterpret_cast<uint8_t*>(&value), sizeof(value));
   }
 
+  void writeArrayHeader(size_t n) {
+    if (n < 0x10) {
+      writeByte(uint8_t(0x90 + n));
+    } else if (n < 0x10000) {
+      writeByte(0xDC);
+      writeInteger(uint16_t(n));
+    } else {
+      writeByte(0xDD);
+      writeInteger(uint32_t(n));
+    }
+  }
+
   CountingDecorator<TWriter> writer_;
   const ResourceManager* resources_;
 };
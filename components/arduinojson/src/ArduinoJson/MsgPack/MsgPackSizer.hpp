@@ -0,0 +1,363 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/Filter.hpp>
+#include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Memory/ResourceCounter.hpp>
+#include <ArduinoJson/Memory/StringCounter.hpp>
+#include <ArduinoJson/MsgPack/endianess.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The first pass of DeserializationOption::ExactSize: counts what
+// MsgPackDeserializer would allocate for the same input and filter.
+template <typename TReader>
+class MsgPackSizer {
+ public:
+  MsgPackSizer(ResourceCounter* counter, TReader reader)
+      : counter_(counter), reader_(reader), string_(counter->allocator()) {}
+
+  template <typename TFilter>
+  DeserializationError parse(TFilter filter,
+                             DeserializationOption::NestingLimit nestingLimit) {
+    return parseVariant(filter, nestingLimit);
+  }
+
+ private:
+  template <typename TFilter>
+  DeserializationError::Code parseVariant(
+      TFilter filter, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    uint8_t code = 0;
+    err = readByte(code);
+    if (err)
+      return err;
+
+    bool allowValue = filter.allowValue();
+
+    switch (code) {
+      case 0xc1:
+        return DeserializationError::InvalidInput;
+
+      case 0xc4:  // bin 8
+      case 0xc7:  // ext 8
+        return skipString<uint8_t>(code == 0xc7);
+
+      case 0xc5:  // bin 16
+      case 0xc8:  // ext 16
+        return skipString<uint16_t>(code == 0xc8);
+
+      case 0xc6:  // bin 32
+      case 0xc9:  // ext 32
+        return skipString<uint32_t>(code == 0xc9);
+
+      case 0xcc:
+      case 0xd0:
+        return skipBytes(1);
+
+      case 0xcd:
+      case 0xd1:
+      case 0xd4:  // fixext 1
+        return skipBytes(2);
+
+      case 0xd5:  // fixext 2
+        return skipBytes(3);
+
+      case 0xca:
+      case 0xce:
+      case 0xd2:
+        return skipBytes(4);
+
+      case 0xd6:  // fixext 4
+        return skipBytes(5);
+
+      case 0xcb:
+      case 0xcf:
+      case 0xd3:
+        return skipBytes(8);
+
+      case 0xd7:  // fixext 8
+        return skipBytes(9);
+
+      case 0xd8:  // fixext 16
+        return skipBytes(17);
+
+      case 0xd9:
+        return readString<uint8_t>(allowValue);
+
+      case 0xda:
+        return readString<uint16_t>(allowValue);
+
+      case 0xdb:
+        return readString<uint32_t>(allowValue);
+
+      case 0xdc:
+        return readArray<uint16_t>(filter, nestingLimit);
+
+      case 0xdd:
+        return readArray<uint32_t>(filter, nestingLimit);
+
+      case 0xde:
+        return readObject<uint16_t>(filter, nestingLimit);
+
+      case 0xdf:
+        return readObject<uint32_t>(filter, nestingLimit);
+    }
+
+    switch (code & 0xf0) {
+      case 0x80:
+        return readObject(code & 0x0F, filter, nestingLimit);
+
+      case 0x90:
+        return readArray(code & 0x0F, filter, nestingLimit);
+    }
+
+    if ((code & 0xe0) == 0xa0)
+      return readString(code & 0x1f, allowValue);
+
+    // nil, booleans, and fixints
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readByte(uint8_t& value) {
+    int c = reader_.read();
+    if (c < 0)
+      return DeserializationError::IncompleteInput;
+    value = static_cast<uint8_t>(c);
+    return DeserializationError::Ok;
+  }
+
+  template <typename T>
+  DeserializationError::Code readInteger(T& value) {
+    auto p = reinterpret_cast<char*>(&value);
+    if (reader_.readBytes(p, sizeof(value)) != sizeof(value))
+      return DeserializationError::IncompleteInput;
+    fixEndianess(value);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code skipBytes(size_t n) {
+    return skipBytes(n, is_contiguous_reader<TReader>());
+  }
+
+  DeserializationError::Code skipBytes(size_t n, false_type) {
+    for (; n; --n) {
+      if (reader_.read() < 0)
+        return DeserializationError::IncompleteInput;
+    }
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code skipBytes(size_t n, true_type) {
+    const char* end;
+    const char* ptr = reader_.peek(end);
+    if (end && size_t(end - ptr) < n)
+      return DeserializationError::IncompleteInput;
+    reader_.advance(n);
+    return DeserializationError::Ok;
+  }
+
+  // Skips a bin or an ext, whose type adds one byte
+  template <typename T>
+  DeserializationError::Code skipString(bool isExt) {
+    DeserializationError::Code err;
+    T size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return skipBytes(size + size_t(isExt));
+  }
+
+  template <typename T>
+  DeserializationError::Code readString(bool allowValue) {
+    DeserializationError::Code err;
+    T size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return readString(size, allowValue);
+  }
+
+  DeserializationError::Code readString(size_t n, bool allowValue) {
+    DeserializationError::Code err;
+
+    if (!allowValue)
+      return skipBytes(n);
+
+    err = readString(n);
+    if (err)
+      return err;
+
+    counter_->buildString(string_);
+    if (!VariantData::fitsTinyString(string_.size()))
+      counter_->saveString(string_);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readString(size_t n) {
+    string_.startString();
+    return appendBytes(n, is_contiguous_reader<TReader>());
+  }
+
+  DeserializationError::Code appendBytes(size_t n, false_type) {
+    for (; n; --n) {
+      int c = reader_.read();
+      if (c < 0)
+        return DeserializationError::IncompleteInput;
+      string_.append(static_cast<char>(c));
+    }
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code appendBytes(size_t n, true_type) {
+    const char* end;
+    const char* ptr = reader_.peek(end);
+    if (end && size_t(end - ptr) < n)
+      return DeserializationError::IncompleteInput;
+    string_.append(ptr, n);
+    reader_.advance(n);
+    return DeserializationError::Ok;
+  }
+
+  template <typename TSize, typename TFilter>
+  DeserializationError::Code readArray(
+      TFilter filter, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    TSize size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return readArray(size, filter, nestingLimit);
+  }
+
+  template <typename TFilter>
+  DeserializationError::Code readArray(
+      size_t n, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    TFilter elementFilter = filter[0U];
+
+    for (; n; --n) {
+      if (elementFilter.allow())
+        counter_->addSlot();
+
+      err = parseVariant(elementFilter, nestingLimit.decrement());
+      if (err)
+        return err;
+    }
+
+    return DeserializationError::Ok;
+  }
+
+  template <typename TSize, typename TFilter>
+  DeserializationError::Code readObject(
+      TFilter filter, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    TSize size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return readObject(size, filter, nestingLimit);
+  }
+
+  template <typename TFilter>
+  DeserializationError::Code readObject(
+      size_t n, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    for (; n; --n) {
+      err = readKey();
+      if (err)
+        return err;
+      counter_->buildString(string_);
+
+      if (string_.isComplete())
+        err = parseMember(filter[string_.str().c_str()],
+                          nestingLimit.decrement());
+      else  // couldn't be copied, count it as if the filter allowed it
+        err = parseMember(AllowAllFilter(), nestingLimit.decrement());
+      if (err)
+        return err;
+    }
+
+    return DeserializationError::Ok;
+  }
+
+  // Counts the member whose key was just read
+  template <typename TFilter>
+  DeserializationError::Code parseMember(
+      TFilter memberFilter, DeserializationOption::NestingLimit nestingLimit) {
+    if (memberFilter.allow()) {
+      counter_->addSlot();
+      counter_->saveString(string_);
+    }
+    return parseVariant(memberFilter, nestingLimit);
+  }
+
+  DeserializationError::Code readKey() {
+    DeserializationError::Code err;
+    uint8_t code;
+
+    err = readByte(code);
+    if (err)
+      return err;
+
+    if ((code & 0xe0) == 0xa0)
+      return readString(code & 0x1f);
+
+    switch (code) {
+      case 0xd9:
+        return readKey<uint8_t>();
+
+      case 0xda:
+        return readKey<uint16_t>();
+
+      case 0xdb:
+        return readKey<uint32_t>();
+
+      default:
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  template <typename T>
+  DeserializationError::Code readKey() {
+    DeserializationError::Code err;
+    T size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return readString(size);
+  }
+
+  ResourceCounter* counter_;
+  TReader reader_;
+  StringCounter string_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
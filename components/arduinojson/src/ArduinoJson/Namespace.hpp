@@ -0,0 +1,52 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Configuration.hpp>
+#include <ArduinoJson/Polyfills/preprocessor.hpp>
+#include <ArduinoJson/version.hpp>
+
+#ifndef ARDUINOJSON_VERSION_NAMESPACE
+
+#  define ARDUINOJSON_VERSION_NAMESPACE                                \
+    ARDUINOJSON_CONCAT4(                                               \
+        ARDUINOJSON_VERSION_MACRO,                                     \
+        ARDUINOJSON_BIN2ALPHA(ARDUINOJSON_ENABLE_PROGMEM,              \
+                              ARDUINOJSON_USE_LONG_LONG,               \
+                              ARDUINOJSON_USE_DOUBLE,                  \
+                              ARDUINOJSON_CACHE_COLLECTION_SIZE),      \
+        ARDUINOJSON_BIN2ALPHA(ARDUINOJSON_ENABLE_NAN,                  \
+                              ARDUINOJSON_ENABLE_INFINITY,             \
+                              ARDUINOJSON_ENABLE_COMMENTS,             \
+                              ARDUINOJSON_DECODE_UNICODE),             \
+        ARDUINOJSON_CONCAT4(                                           \
+            ARDUINOJSON_BIN2ALPHA(ARDUINOJSON_ENABLE_STRING_INDEX,     \
+                                  ARDUINOJSON_ENABLE_TINY_STRINGS,     \
+                                  ARDUINOJSON_ENABLE_OBJECT_INDEX,     \
+                                  ARDUINOJSON_ENABLE_ARRAY_INDEX),     \
+            ARDUINOJSON_BIN2ALPHA(ARDUINOJSON_ENABLE_PACKED_ARRAYS,    \
+                                  ARDUINOJSON_ENABLE_ALLOCATION_STATS, \
+                                  0, 0),                               \
+            ARDUINOJSON_SLOT_ID_SIZE, ARDUINOJSON_STRING_LENGTH_SIZE))
+
+#endif
+
+#define ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE \
+  namespace ArduinoJson {                  \
+  inline namespace ARDUINOJSON_VERSION_NAMESPACE {
+
+#define ARDUINOJSON_END_PUBLIC_NAMESPACE \
+  }                                      \
+  }
+
+#define ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE        \
+  namespace ArduinoJson {                          \
+  inline namespace ARDUINOJSON_VERSION_NAMESPACE { \
+  namespace detail {
+
+#define ARDUINOJSON_END_PRIVATE_NAMESPACE \
+  }                                       \
+  }                                       \
+  }
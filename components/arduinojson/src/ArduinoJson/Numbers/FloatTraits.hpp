@@ -29,6 +29,14 @@ struct FloatTraits<T, 8 /*64bits*/> {
   typedef int16_t exponent_type;
   static const exponent_type exponent_max = 308;
 
+  // Parameters of the decimal to binary conversion (see decimalToFloat.hpp)
+  static const short exponent_bias = 1023;
+  static const short decimal_exponent_min = -342;  // smaller ones give zero
+  static const short fast_path_exponent_max = 22;  // 1e22 is exact
+  static const short round_to_even_exponent_min = -4;
+  static const short round_to_even_exponent_max = 23;
+  static const short significant_digits_max = 769;
+
   static pgm_ptr<T> positiveBinaryPowersOfTen() {
     ARDUINOJSON_DEFINE_PROGMEM_ARRAY(  //
         uint64_t, factors,
@@ -113,6 +121,14 @@ struct FloatTraits<T, 4 /*32bits*/> {
   typedef int8_t exponent_type;
   static const exponent_type exponent_max = 38;
 
+  // Parameters of the decimal to binary conversion (see decimalToFloat.hpp)
+  static const short exponent_bias = 127;
+  static const short decimal_exponent_min = -65;  // smaller ones give zero
+  static const short fast_path_exponent_max = 10;  // 1e10f is exact
+  static const short round_to_even_exponent_min = -17;
+  static const short round_to_even_exponent_max = 10;
+  static const short significant_digits_max = 114;
+
   static pgm_ptr<T> positiveBinaryPowersOfTen() {
     ARDUINOJSON_DEFINE_PROGMEM_ARRAY(uint32_t, factors,
                                      {
@@ -0,0 +1,339 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/FloatTraits.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/ctype.hpp>
+
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+#  include <ArduinoJson/Numbers/powersOfFive.hpp>
+
+#  include <string.h>  // memmove, memset
+#endif
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A decimal number: significand * 10^exponent
+struct Decimal {
+  uint64_t significand;  // the first 19 significant digits
+  int32_t exponent;
+  bool truncated;  // true if the significand misses non-zero digits
+
+  // The significant digits (including the decimal point, if any), needed to
+  // round correctly when the significand is truncated
+  const char* digits;
+  const char* digitsEnd;
+};
+
+const uint8_t decimalSignificandDigits = 19;
+
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+inline int countLeadingZeros(uint64_t x) {
+  ARDUINOJSON_ASSERT(x != 0);
+#  if defined(__GNUC__)
+  return __builtin_clzll(x);
+#  else
+  int n = 0;
+  while (!(x >> 63)) {
+    x <<= 1;
+    n++;
+  }
+  return n;
+#  endif
+}
+
+struct uint128 {
+  uint64_t high;
+  uint64_t low;
+};
+
+inline uint128 multiply(uint64_t a, uint64_t b) {
+  uint128 result;
+#  if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 native_uint128;
+  native_uint128 product = native_uint128(a) * b;
+  result.high = uint64_t(product >> 64);
+  result.low = uint64_t(product);
+#  else
+  uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+  uint64_t bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+  uint64_t lowLow = aLow * bLow;
+  uint64_t lowHigh = aLow * bHigh;
+  uint64_t highLow = aHigh * bLow;
+  uint64_t middle =
+      (lowLow >> 32) + (lowHigh & 0xFFFFFFFF) + (highLow & 0xFFFFFFFF);
+  result.high = aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) +
+                (middle >> 32);
+  result.low = (middle << 32) | (lowLow & 0xFFFFFFFF);
+#  endif
+  return result;
+}
+
+// Converts w * 10^q to the bits of the nearest float (without the sign), using
+// the Eisel-Lemire algorithm: https://arxiv.org/abs/2101.11408
+template <typename TFloat>
+uint64_t computeFloatBits(int32_t q, uint64_t w) {
+  using traits = FloatTraits<TFloat>;
+  const int mantissaBits = traits::mantissa_bits;
+  const int32_t infinity = 2 * traits::exponent_bias + 1;
+
+  if (w == 0 || q < traits::decimal_exponent_min)
+    return 0;
+  if (q > traits::exponent_max)
+    return uint64_t(infinity) << mantissaBits;
+
+  int leadingZeros = countLeadingZeros(w);
+  w <<= leadingZeros;
+
+  // Multiply by the truncated 5^q; the low half is only needed when the bits
+  // that we keep could change
+  auto powers = powersOfFive();
+  int index = 2 * (q - powersOfFiveMin);
+  uint128 product = multiply(w, powers[index]);
+  const uint64_t precisionMask = ~uint64_t(0) >> (mantissaBits + 3);
+  if ((product.high & precisionMask) == precisionMask) {
+    uint128 lowProduct = multiply(w, powers[index + 1]);
+    product.low += lowProduct.high;
+    if (lowProduct.high > product.low)
+      product.high++;
+  }
+
+  int upperBit = int(product.high >> 63);
+  int shift = upperBit + 64 - mantissaBits - 3;
+  uint64_t mantissa = product.high >> shift;
+
+  // (217706 * q) >> 16 is floor(log2(10^q))
+  int32_t power2 = ((217706 * q) >> 16) + 63 + upperBit - leadingZeros +
+                   traits::exponent_bias;
+
+  if (power2 <= 0) {  // subnormal
+    if (-power2 + 1 >= 64)
+      return 0;
+    mantissa >>= -power2 + 1;
+    mantissa += mantissa & 1;  // round up
+    mantissa >>= 1;
+    // if rounding set the implicit bit, we get the smallest normal number
+    return mantissa;
+  }
+
+  // We usually round up, but when exactly halfway between two floats, we round
+  // to even; this can only happen with small powers of ten.
+  if (product.low <= 1 && q >= traits::round_to_even_exponent_min &&
+      q <= traits::round_to_even_exponent_max && (mantissa & 3) == 1 &&
+      (mantissa << shift) == product.high)
+    mantissa &= ~uint64_t(1);
+
+  mantissa += mantissa & 1;  // round up
+  mantissa >>= 1;
+  if (mantissa >= (uint64_t(2) << mantissaBits)) {
+    mantissa = uint64_t(1) << mantissaBits;
+    power2++;
+  }
+  mantissa &= ~(uint64_t(1) << mantissaBits);
+
+  if (power2 >= infinity)
+    return uint64_t(infinity) << mantissaBits;
+  return mantissa | (uint64_t(power2) << mantissaBits);
+}
+
+// An unsigned integer of up to TCapacity 32-bit words
+template <size_t TCapacity>
+class BigInt {
+ public:
+  BigInt(uint64_t value) : size_(0) {
+    for (; value; value >>= 32)
+      push(uint32_t(value));
+  }
+
+  // this = this * factor + addend
+  void multiplyAdd(uint32_t factor, uint32_t addend = 0) {
+    uint64_t carry = addend;
+    for (size_t i = 0; i < size_; i++) {
+      carry += uint64_t(words_[i]) * factor;
+      words_[i] = uint32_t(carry);
+      carry >>= 32;
+    }
+    if (carry)
+      push(uint32_t(carry));
+  }
+
+  void multiplyByPowerOfFive(uint32_t n) {
+    for (; n >= 13; n -= 13)
+      multiplyAdd(1220703125);  // 5^13
+    uint32_t factor = 1;
+    while (n--)
+      factor *= 5;
+    multiplyAdd(factor);
+  }
+
+  void shiftLeft(uint32_t n) {
+    if (size_ == 0)
+      return;
+    uint32_t bits = n % 32;
+    if (bits) {
+      uint32_t carry = 0;
+      for (size_t i = 0; i < size_; i++) {
+        uint32_t word = words_[i];
+        words_[i] = (word << bits) | carry;
+        carry = word >> (32 - bits);
+      }
+      if (carry)
+        push(carry);
+    }
+    size_t words = n / 32;
+    if (words) {
+      ARDUINOJSON_ASSERT(size_ + words <= TCapacity);
+      if (size_ + words > TCapacity)
+        return;
+      memmove(words_ + words, words_, size_ * sizeof(uint32_t));
+      memset(words_, 0, words * sizeof(uint32_t));
+      size_ += words;
+    }
+  }
+
+  int compare(const BigInt& other) const {
+    if (size_ != other.size_)
+      return size_ > other.size_ ? 1 : -1;
+    for (size_t i = size_; i > 0; i--) {
+      if (words_[i - 1] != other.words_[i - 1])
+        return words_[i - 1] > other.words_[i - 1] ? 1 : -1;
+    }
+    return 0;
+  }
+
+ private:
+  void push(uint32_t word) {
+    ARDUINOJSON_ASSERT(size_ < TCapacity);
+    if (size_ < TCapacity)
+      words_[size_++] = word;
+  }
+
+  uint32_t words_[TCapacity];
+  size_t size_;
+};
+
+// Rounds correctly a decimal whose significand is truncated.
+// `bits` is the float nearest to the truncated significand, so the result is
+// either `bits` or the next float: we compare all the digits with the halfway
+// point between the two.
+template <typename TFloat>
+uint64_t roundTruncatedDecimal(const Decimal& decimal, uint64_t bits) {
+  using traits = FloatTraits<TFloat>;
+  using bigint_t = BigInt<sizeof(TFloat) == 8 ? 125 : 20>;
+  const int mantissaBits = traits::mantissa_bits;
+
+  // Load the significant digits, nine at a time; the ones after
+  // significant_digits_max can only break a tie
+  bigint_t digits(0);
+  int32_t count = 0;
+  uint32_t chunk = 0, chunkFactor = 1;
+  bool moreDigits = false;
+  for (const char* p = decimal.digits; p != decimal.digitsEnd; p++) {
+    if (!isdigit(*p))  // decimal point
+      continue;
+    if (count == traits::significant_digits_max) {
+      if (*p != '0') {
+        moreDigits = true;
+        break;
+      }
+      continue;
+    }
+    chunk = chunk * 10 + uint32_t(*p - '0');
+    chunkFactor *= 10;
+    count++;
+    if (chunkFactor == 1000000000) {
+      digits.multiplyAdd(chunkFactor, chunk);
+      chunk = 0;
+      chunkFactor = 1;
+    }
+  }
+  if (chunkFactor > 1)
+    digits.multiplyAdd(chunkFactor, chunk);
+  int32_t exponent = decimal.exponent + decimalSignificandDigits - count;
+
+  // The halfway point is (2 * mantissa + 1) * 2^(binaryExponent - 1)
+  uint64_t mantissa = bits & ((uint64_t(1) << mantissaBits) - 1);
+  int32_t binaryExponent = int32_t(bits >> mantissaBits);
+  if (binaryExponent == 0)  // subnormal
+    binaryExponent = 1;
+  else
+    mantissa |= uint64_t(1) << mantissaBits;
+  binaryExponent -= traits::exponent_bias + mantissaBits + 1;
+  bigint_t halfway(2 * mantissa + 1);
+
+  // Compare digits * 10^exponent with halfway * 2^binaryExponent
+  if (exponent >= 0)
+    digits.multiplyByPowerOfFive(uint32_t(exponent));
+  else
+    halfway.multiplyByPowerOfFive(uint32_t(-exponent));
+  if (exponent > binaryExponent)
+    digits.shiftLeft(uint32_t(exponent - binaryExponent));
+  else
+    halfway.shiftLeft(uint32_t(binaryExponent - exponent));
+
+  int diff = digits.compare(halfway);
+  if (diff == 0)  // tie: round to even
+    diff = moreDigits || (mantissa & 1) ? 1 : -1;
+  return diff > 0 ? bits + 1 : bits;
+}
+#endif
+
+template <typename TFloat>
+TFloat decimalToFloat(const Decimal& decimal) {
+  using traits = FloatTraits<TFloat>;
+
+  // Zero, whatever the exponent, like 0e400 or .e400
+  if (decimal.significand == 0)
+    return 0;
+
+  // Fast path: if the significand and the power of ten are exact, a single
+  // multiplication or division gives a correctly rounded result.
+  // This covers the short decimals, like 23.5 or -0.125
+  if (!decimal.truncated &&
+      decimal.significand <= (uint64_t(1) << (traits::mantissa_bits + 1)) &&
+      decimal.exponent >= -traits::fast_path_exponent_max &&
+      decimal.exponent <= traits::fast_path_exponent_max) {
+    TFloat value = TFloat(decimal.significand);
+    if (decimal.exponent < 0)
+      return value / make_float(TFloat(1), -decimal.exponent);
+    else
+      return value * make_float(TFloat(1), decimal.exponent);
+  }
+
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+  uint64_t bits =
+      computeFloatBits<TFloat>(decimal.exponent, decimal.significand);
+  // With a truncated significand, the result is ambiguous if the next
+  // significand gives a different float
+  if (decimal.truncated &&
+      bits != computeFloatBits<TFloat>(decimal.exponent,
+                                       decimal.significand + 1))
+    bits = roundTruncatedDecimal<TFloat>(decimal, bits);
+  return traits::forge(typename traits::mantissa_type(bits));
+#else
+  // Without the table of powers of five, we multiply by the binary powers of
+  // ten, which is not always correctly rounded
+  uint64_t significand = decimal.significand;
+  int32_t exponent = decimal.exponent;
+  while (significand > traits::mantissa_max) {
+    significand /= 10;
+    exponent++;
+  }
+  if (exponent > traits::exponent_max)
+    return traits::inf();
+  TFloat value = TFloat(significand);
+  // make_float() supports exponents up to exponent_max
+  if (exponent < -traits::exponent_max) {
+    value = make_float(value, -traits::exponent_max);
+    exponent += traits::exponent_max;
+    if (exponent < -traits::exponent_max)
+      return 0;
+  }
+  return make_float(value, exponent);
+#endif
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
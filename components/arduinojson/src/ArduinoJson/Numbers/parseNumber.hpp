@@ -0,0 +1,166 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/FloatTraits.hpp>
+#include <ArduinoJson/Numbers/convertNumber.hpp>
+#include <ArduinoJson/Numbers/decimalToFloat.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/ctype.hpp>
+#include <ArduinoJson/Polyfills/math.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Variant/Converter.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+#include <string.h>  // strlen
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Parses the number in [s, end)
+inline bool parseNumber(const char* s, const char* end, VariantData& result) {
+  ARDUINOJSON_ASSERT(s != 0);
+
+  bool is_negative = false;
+  if (s != end) {
+    switch (*s) {
+      case '-':
+        is_negative = true;
+        s++;
+        break;
+      case '+':
+        s++;
+        break;
+    }
+  }
+
+  if (s == end)
+    return false;
+
+#if ARDUINOJSON_ENABLE_NAN
+  if (*s == 'n' || *s == 'N') {
+    result.setFloat(FloatTraits<JsonFloat>::nan());
+    return true;
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_INFINITY
+  if (*s == 'i' || *s == 'I') {
+    result.setFloat(is_negative ? -FloatTraits<JsonFloat>::inf()
+                                : FloatTraits<JsonFloat>::inf());
+    return true;
+  }
+#endif
+
+  if (!isdigit(*s) && *s != '.')
+    return false;
+
+  // keep the first significant digits, skipping the leading zeros
+  Decimal decimal = {0, 0, false, nullptr, nullptr};
+  uint8_t digits = 0;
+
+  while (s != end && isdigit(*s)) {
+    uint8_t digit = uint8_t(*s - '0');
+    if (digits < decimalSignificandDigits) {
+      if (digits == 0)
+        decimal.digits = s;
+      decimal.significand = decimal.significand * 10 + digit;
+      if (decimal.significand != 0)
+        digits++;
+    } else {
+      decimal.exponent++;
+      if (digit != 0)
+        decimal.truncated = true;
+    }
+    s++;
+  }
+
+  if (s == end) {
+    // the significand holds the integer, unless it has 20 digits
+    JsonUInt maxValue = JsonUInt(-1);
+    bool fits = false;
+    uint64_t integer = decimal.significand;
+    if (decimal.exponent == 0) {
+      fits = integer <= maxValue;
+    } else if (decimal.exponent == 1) {
+      uint8_t digit = uint8_t(s[-1] - '0');
+      fits = integer <= (maxValue - digit) / 10;
+      integer = integer * 10 + digit;
+    }
+    if (fits) {
+      if (is_negative) {
+        const JsonUInt sintMantissaMax = JsonUInt(1)
+                                         << (sizeof(JsonInteger) * 8 - 1);
+        if (integer <= sintMantissaMax) {
+          result.setInteger(JsonInteger(~JsonUInt(integer) + 1));
+          return true;
+        }
+      } else {
+        result.setInteger(JsonUInt(integer));
+        return true;
+      }
+    }
+  }
+
+  if (s != end && *s == '.') {
+    s++;
+    while (s != end && isdigit(*s)) {
+      uint8_t digit = uint8_t(*s - '0');
+      if (digits < decimalSignificandDigits) {
+        if (digits == 0)
+          decimal.digits = s;
+        decimal.significand = decimal.significand * 10 + digit;
+        if (decimal.significand != 0)
+          digits++;
+        decimal.exponent--;
+      } else if (digit != 0) {
+        decimal.truncated = true;
+      }
+      s++;
+    }
+  }
+  decimal.digitsEnd = s;
+
+  if (s != end && (*s == 'e' || *s == 'E')) {
+    s++;
+    bool negative_exponent = false;
+    if (s != end && *s == '-') {
+      negative_exponent = true;
+      s++;
+    } else if (s != end && *s == '+') {
+      s++;
+    }
+
+    int32_t exponent = 0;
+    while (s != end && isdigit(*s)) {
+      // larger exponents give zero or infinity anyway; stopping here keeps
+      // the exponent, and decimal.exponent, far from the overflow
+      if (exponent < 100000000)
+        exponent = exponent * 10 + (*s - '0');
+      s++;
+    }
+    decimal.exponent += negative_exponent ? -exponent : exponent;
+  }
+
+  // we should be at the end of the string, otherwise it's an error
+  if (s != end)
+    return false;
+
+  JsonFloat value = decimalToFloat<JsonFloat>(decimal);
+  result.setFloat(is_negative ? -value : value);
+  return true;
+}
+
+inline bool parseNumber(const char* s, VariantData& result) {
+  ARDUINOJSON_ASSERT(s != 0);
+  return parseNumber(s, s + strlen(s), result);
+}
+
+template <typename T>
+inline T parseNumber(const char* s) {
+  VariantData value;
+  parseNumber(s, value);
+  return Converter<T>::fromJson(JsonVariantConst(&value, nullptr));
+}
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -22,9 +22,10 @@ class JsonPair {
   // Returns the key.
   JsonString key() const {
     if (!iterator_.done())
-      return JsonString(iterator_.key(), iterator_.ownsKey()
-                                             ? JsonString::Copied
-                                             : JsonString::Linked);
+      return JsonString(iterator_.key(),
+                        iterator_.ownsKey()
+                            ? JsonString::Copied
+                            : resources_->unownedKeyOwnership());
     else
       return JsonString();
   }
@@ -50,9 +51,10 @@ class JsonPairConst {
   // Returns the key.
   JsonString key() const {
     if (!iterator_.done())
-      return JsonString(iterator_.key(), iterator_.ownsKey()
-                                             ? JsonString::Copied
-                                             : JsonString::Linked);
+      return JsonString(iterator_.key(),
+                        iterator_.ownsKey()
+                            ? JsonString::Copied
+                            : resources_->unownedKeyOwnership());
     else
       return JsonString();
   }
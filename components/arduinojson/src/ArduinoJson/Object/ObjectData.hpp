@@ -17,24 +17,31 @@ class ObjectData : public CollectionData {
       return nullptr;
 
     it.setKey(key);
+    indexMember(it, resources);
     return it.data();
   }
 
   template <typename TAdaptedString>
   VariantData* addMember(TAdaptedString key, ResourceManager* resources) {
     ARDUINOJSON_ASSERT(!key.isNull());
-    if (key.isLinked()) {
+    const char* linkedKey =
+        key.isLinked() ? key.data() : resources->internKey(key);
+    if (linkedKey) {
       auto it = addSlot(resources);
-      if (!it.done())
-        it.setKey(key.data());
+      if (!it.done()) {
+        it.setKey(linkedKey);
+        indexMember(it, resources);
+      }
       return it.data();
     } else {
       auto storedKey = resources->saveString(key);
       if (!storedKey)
         return nullptr;
       auto it = addSlot(resources);
-      if (!it.done())
+      if (!it.done()) {
         it.setKey(storedKey);
+        indexMember(it, resources);
+      }
       return it.data();
     }
   }
@@ -68,6 +75,17 @@ class ObjectData : public CollectionData {
  private:
   template <typename TAdaptedString>
   iterator findKey(TAdaptedString key, const ResourceManager* resources) const;
+
+  // Adds a new member to the index of the object, if it has one
+  void indexMember(iterator it, ResourceManager* resources);
+
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  template <typename TAdaptedString>
+  iterator findIndexedKey(TAdaptedString key, const ObjectIndex* index,
+                          const ResourceManager* resources) const;
+
+  void buildIndex(const ResourceManager* resources) const;
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,105 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Object/ObjectData.hpp>
+#include <ArduinoJson/Variant/VariantCompare.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename TAdaptedString>
+inline VariantData* ObjectData::getMember(
+    TAdaptedString key, const ResourceManager* resources) const {
+  return findKey(key, resources).data();
+}
+
+template <typename TAdaptedString>
+VariantData* ObjectData::getOrAddMember(TAdaptedString key,
+                                        ResourceManager* resources) {
+  auto it = findKey(key, resources);
+  if (!it.done())
+    return it.data();
+  return addMember(key, resources);
+}
+
+template <typename TAdaptedString>
+inline ObjectData::iterator ObjectData::findKey(
+    TAdaptedString key, const ResourceManager* resources) const {
+  if (key.isNull())
+    return iterator();
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  auto index = resources->getObjectIndex(head());
+  if (index)
+    return findIndexedKey(key, index, resources);
+  size_t visited = 0;
+#endif
+  for (auto it = createIterator(resources); !it.done(); it.next(resources)) {
+    if (stringEquals(key, adaptString(it.key())))
+      return it;
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+    if (++visited == ObjectIndex::minMembers) {
+      buildIndex(resources);  // the next lookups will use it
+      index = resources->getObjectIndex(head());
+      if (index)
+        return findIndexedKey(key, index, resources);
+    }
+#endif
+  }
+  return iterator();
+}
+
+inline void ObjectData::indexMember(iterator it, ResourceManager* resources) {
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  auto index = resources->getObjectIndex(head());
+  if (index &&
+      !index->add(ObjectIndex::hash(adaptString(it.key())), it.currentId_))
+    buildIndex(resources);  // full, make a bigger one
+#else
+  (void)it;
+  (void)resources;
+#endif
+}
+
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+template <typename TAdaptedString>
+inline ObjectData::iterator ObjectData::findIndexedKey(
+    TAdaptedString key, const ObjectIndex* index,
+    const ResourceManager* resources) const {
+  auto h = ObjectIndex::hash(key);
+  for (size_t i = h & index->mask(); index->entries[i].id != NULL_SLOT;
+       i = (i + 1) & index->mask()) {
+    if (index->entries[i].hash != h)
+      continue;
+    auto id = index->entries[i].id;
+    auto slot = resources->getSlot(id);
+    if (stringEquals(key, adaptString(slot->key())))
+      return iterator(slot, id);
+  }
+  return iterator();
+}
+
+// Replaces the index of the object with one that has room for all the members.
+// If the allocation fails, the object has no index.
+inline void ObjectData::buildIndex(const ResourceManager* resources) const {
+  resources->destroyObjectIndex(resources->getObjectIndex(head()));
+  auto index = resources->createObjectIndex(head(), size(resources) + 1);
+  if (!index)
+    return;
+  for (auto it = createIterator(resources); !it.done(); it.next(resources)) {
+    bool added = index->add(ObjectIndex::hash(adaptString(it.key())),
+                            it.currentId_);
+    ARDUINOJSON_ASSERT(added);
+    (void)added;
+  }
+}
+#endif
+
+template <typename TAdaptedString>
+inline void ObjectData::removeMember(TAdaptedString key,
+                                     ResourceManager* resources) {
+  remove(findKey(key, resources), resources);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -28,4 +28,9 @@ struct uint_t<32> {
   typedef uint32_t type;
 };
 
+template <>
+struct uint_t<64> {
+  typedef uint64_t type;
+};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
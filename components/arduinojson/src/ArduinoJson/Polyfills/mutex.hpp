@@ -0,0 +1,85 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#if defined(ESP_PLATFORM)
+#  define ARDUINOJSON_MUTEX_FREERTOS 1
+#elif defined(__has_include) && !defined(ARDUINO)
+#  if __has_include(<mutex>)
+#    define ARDUINOJSON_MUTEX_STD 1
+#  endif
+#endif
+
+#ifndef ARDUINOJSON_MUTEX_FREERTOS
+#  define ARDUINOJSON_MUTEX_FREERTOS 0
+#endif
+
+#ifndef ARDUINOJSON_MUTEX_STD
+#  define ARDUINOJSON_MUTEX_STD 0
+#endif
+
+#if ARDUINOJSON_MUTEX_FREERTOS
+#  include <freertos/FreeRTOS.h>
+#  include <freertos/semphr.h>
+#elif ARDUINOJSON_MUTEX_STD
+#  include <mutex>
+#endif
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A mutex that blocks the waiting task instead of spinning.
+// It's a FreeRTOS mutex on ESP32, so that a low-priority task that holds it
+// inherits the priority of the task that waits for it, and a std::mutex on
+// the other hosted platforms. The targets that have neither, like AVR, are
+// single-threaded, so there it does nothing.
+class Mutex {
+ public:
+#if ARDUINOJSON_MUTEX_FREERTOS
+  Mutex() : handle_(xSemaphoreCreateMutexStatic(&buffer_)) {}
+
+  ~Mutex() {
+    vSemaphoreDelete(handle_);
+  }
+
+  void lock() {
+    xSemaphoreTake(handle_, portMAX_DELAY);
+  }
+
+  void unlock() {
+    xSemaphoreGive(handle_);
+  }
+#elif ARDUINOJSON_MUTEX_STD
+  Mutex() {}
+
+  void lock() {
+    mutex_.lock();
+  }
+
+  void unlock() {
+    mutex_.unlock();
+  }
+#else
+  Mutex() {}
+
+  void lock() {}
+
+  void unlock() {}
+#endif
+
+  Mutex(const Mutex&) = delete;
+  Mutex& operator=(const Mutex&) = delete;
+
+ private:
+#if ARDUINOJSON_MUTEX_FREERTOS
+  StaticSemaphore_t buffer_;
+  SemaphoreHandle_t handle_;
+#elif ARDUINOJSON_MUTEX_STD
+  std::mutex mutex_;
+#endif
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -215,9 +215,9 @@ class StringBuilderPrint : public Print {
     copier_.startString();
   }
 
-  StringNode* save() {
+  void save(VariantData* variant) {
     ARDUINOJSON_ASSERT(!overflowed());
-    return copier_.save();
+    copier_.save(variant);
   }
 
   size_t write(uint8_t c) {
@@ -254,7 +254,7 @@ inline void convertToJson(const ::Printable& src, JsonVariant dst) {
     data->setNull();
     return;
   }
-  data->setOwnedString(print.save());
+  print.save(data);
 }
 
 #endif
@@ -329,13 +329,17 @@ struct Converter<JsonArrayConst> : private detail::VariantAttorney {
 
   static JsonArrayConst fromJson(JsonVariantConst src) {
     auto data = getData(src);
-    auto array = data ? data->asArray() : nullptr;
-    return JsonArrayConst(array, getResourceManager(src));
+    auto resources = getResourceManager(src);
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (data && data->isPackedArray())
+      return JsonArrayConst(data, resources);
+#endif
+    return JsonArrayConst(data ? data->asArray() : nullptr, resources);
   }
 
   static bool checkJson(JsonVariantConst src) {
     auto data = getData(src);
-    return data && data->isArray();
+    return data && (data->isArray() || data->isPackedArray());
   }
 };
 
@@ -351,7 +355,7 @@ struct Converter<JsonArray> : private detail::VariantAttorney {
   static JsonArray fromJson(JsonVariant src) {
     auto data = getData(src);
     auto resources = getResourceManager(src);
-    return JsonArray(data != 0 ? data->asArray() : 0, resources);
+    return JsonArray(data != 0 ? data->asArray(resources) : 0, resources);
   }
 
   static detail::InvalidConversion<JsonVariantConst, JsonArray> fromJson(
@@ -363,7 +367,7 @@ struct Converter<JsonArray> : private detail::VariantAttorney {
 
   static bool checkJson(JsonVariant src) {
     auto data = getData(src);
-    return data && data->isArray();
+    return data && (data->isArray() || data->isPackedArray());
   }
 };
 
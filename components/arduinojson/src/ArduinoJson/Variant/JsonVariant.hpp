@@ -73,7 +73,7 @@ struct Converter<JsonVariantConst> : private detail::VariantAttorney {
   }
 
   static JsonVariantConst fromJson(JsonVariantConst src) {
-    return JsonVariantConst(getData(src), getResourceManager(src));
+    return src;  // keeps the copy of the element of a packed array
   }
 
   static bool checkJson(JsonVariantConst src) {
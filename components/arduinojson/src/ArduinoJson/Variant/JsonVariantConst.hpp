@@ -36,7 +36,31 @@ class JsonVariantConst : public detail::VariantTag,
                             const detail::ResourceManager* resources)
       : data_(data), resources_(resources) {}
 
-  // Returns true if the value is null or the reference is unbound.
+  // INTERNAL USE ONLY
+  // Refers to an element of the array; the element of a packed array is
+  // copied in the reference (see VariantData::getElement()).
+  JsonVariantConst(const detail::VariantData* array, size_t index,
+                   const detail::ResourceManager* resources)
+      : resources_(resources) {
+    data_ = detail::VariantData::getElement(array, index, resources,
+                                            packedElement());
+  }
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  JsonVariantConst(const JsonVariantConst& src)
+      : element_(src.element_), resources_(src.resources_) {
+    data_ = src.data_ == &src.element_ ? &element_ : src.data_;
+  }
+
+  JsonVariantConst& operator=(const JsonVariantConst& src) {
+    element_ = src.element_;
+    data_ = src.data_ == &src.element_ ? &element_ : src.data_;
+    resources_ = src.resources_;
+    return *this;
+  }
+#endif
+
+  // Returns true if the value or the reference is unbound.
   // https://arduinojson.org/v7/api/jsonvariantconst/isnull/
   bool isNull() const {
     return detail::VariantData::isNull(data_);
@@ -87,8 +111,7 @@ class JsonVariantConst : public detail::VariantTag,
   // Gets array's element at specified index.
   // https://arduinojson.org/v7/api/jsonvariantconst/subscript/
   JsonVariantConst operator[](size_t index) const {
-    return JsonVariantConst(
-        detail::VariantData::getElement(data_, index, resources_), resources_);
+    return JsonVariantConst(data_, index, resources_);
   }
 
   // Gets object's member with specified key.
@@ -149,6 +172,17 @@ class JsonVariantConst : public detail::VariantTag,
   }
 
  private:
+  detail::VariantData* packedElement() {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    return &element_;
+#else
+    return nullptr;
+#endif
+  }
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  detail::VariantData element_;  // a copy of an element of a packed array
+#endif
   const detail::VariantData* data_;
   const detail::ResourceManager* resources_;
 };
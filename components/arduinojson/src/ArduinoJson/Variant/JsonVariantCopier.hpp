@@ -27,6 +27,19 @@ class JsonVariantCopier {
 inline bool copyVariant(JsonVariant dst, JsonVariantConst src) {
   if (dst.isUnbound())
     return false;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // copy the packed arrays as they are, instead of unpacking the source
+  auto srcData = VariantAttorney::getData(src);
+  if (srcData && srcData->isPackedArray()) {
+    auto dstData = VariantAttorney::getOrCreateData(dst);
+    if (!dstData)
+      return false;
+    if (dstData == srcData)
+      return true;
+    return dstData->setPackedArray(*srcData->asPackedArray(),
+                                   VariantAttorney::getResourceManager(dst));
+  }
+#endif
   JsonVariantCopier copier(dst);
   return accept(src, copier);
 }
@@ -37,6 +37,13 @@ class VisitorAdapter {
     return visitor_->visit(JsonObjectConst(&value, resources_));
   }
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // accept() passes the packed arrays as a JsonArrayConst instead
+  result_type visit(const PackedArray&) {
+    return visitor_->visit(nullptr);
+  }
+#endif
+
   template <typename T>
   result_type visit(const T& value) {
     return visitor_->visit(value);
@@ -54,6 +61,10 @@ typename TVisitor::result_type accept(JsonVariantConst variant,
   if (!data)
     return visit.visit(nullptr);
   auto resources = VariantAttorney::getResourceManager(variant);
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  if (data->isPackedArray())  // read in place, see VariantData::getElement()
+    return visit.visit(JsonArrayConst(data, resources));
+#endif
   VisitorAdapter<TVisitor> adapter(visit, resources);
   return data->accept(adapter);
 }
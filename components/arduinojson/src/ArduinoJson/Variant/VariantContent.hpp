@@ -10,6 +10,7 @@
 #include <ArduinoJson/Numbers/JsonFloat.hpp>
 #include <ArduinoJson/Numbers/JsonInteger.hpp>
 #include <ArduinoJson/Object/ObjectData.hpp>
+#include <ArduinoJson/Polyfills/mpl/max.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
@@ -18,6 +19,7 @@ enum {
 
   OWNED_VALUE_BIT = 0x01,
   VALUE_IS_NULL = 0,
+  VALUE_IS_TINY_STRING = 0x02,  // stored in the variant, not owned
   VALUE_IS_RAW_STRING = 0x03,
   VALUE_IS_LINKED_STRING = 0x04,
   VALUE_IS_OWNED_STRING = 0x05,
@@ -31,6 +33,8 @@ enum {
   VALUE_IS_SIGNED_INTEGER = 0x0A,
   VALUE_IS_FLOAT = 0x0C,
 
+  VALUE_IS_PACKED_ARRAY = 0x10,  // see ARDUINOJSON_ENABLE_PACKED_ARRAYS
+
   COLLECTION_MASK = 0x60,
   VALUE_IS_OBJECT = 0x20,
   VALUE_IS_ARRAY = 0x40,
@@ -38,6 +42,12 @@ enum {
   OWNED_KEY_BIT = 0x80
 };
 
+// The size of the other members of VariantContent, which the tiny strings
+// reuse (see ARDUINOJSON_ENABLE_TINY_STRINGS)
+const size_t tinyStringSize =
+    Max<Max<sizeof(JsonFloat), sizeof(JsonUInt)>::value,
+        Max<sizeof(CollectionData), sizeof(const char*)>::value>::value;
+
 union VariantContent {
   VariantContent() {}
 
@@ -50,6 +60,11 @@ union VariantContent {
   CollectionData asCollection;
   const char* asLinkedString;
   struct StringNode* asOwnedString;
+  struct PackedArray* asPackedArray;
+  // The characters, then the terminator, and in the last byte, the number of
+  // characters that could be added; so, when the string is full, the last
+  // byte is also the terminator.
+  char asTinyString[tinyStringSize];
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
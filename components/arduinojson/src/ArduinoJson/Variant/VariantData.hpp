@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Memory/PackedArray.hpp>
 #include <ArduinoJson/Memory/StringNode.hpp>
 #include <ArduinoJson/Misc/SerializedValue.hpp>
 #include <ArduinoJson/Numbers/convertNumber.hpp>
@@ -36,6 +37,11 @@ class VariantData {
       case VALUE_IS_OBJECT:
         return visit.visit(content_.asObject);
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+      case VALUE_IS_PACKED_ARRAY:
+        return visit.visit(*content_.asPackedArray);
+#endif
+
       case VALUE_IS_LINKED_STRING:
         return visit.visit(JsonString(content_.asLinkedString));
 
@@ -44,6 +50,9 @@ class VariantData {
                                       content_.asOwnedString->length,
                                       JsonString::Copied));
 
+      case VALUE_IS_TINY_STRING:
+        return visit.visit(asTinyString());
+
       case VALUE_IS_RAW_STRING:
         return visit.visit(RawString(content_.asOwnedString->data,
                                      content_.asOwnedString->length));
@@ -72,7 +81,7 @@ class VariantData {
   }
 
   VariantData* addElement(ResourceManager* resources) {
-    auto array = isNull() ? &toArray() : asArray();
+    auto array = isNull() ? &toArray() : asArray(resources);
     return detail::ArrayData::addElement(array, resources);
   }
 
@@ -106,6 +115,16 @@ class VariantData {
     return const_cast<VariantData*>(this)->asArray();
   }
 
+  // Same as asArray(), but accepts the packed arrays, which it unpacks
+  ArrayData* asArray(ResourceManager* resources) {
+    unpackArray(resources);
+    return asArray();
+  }
+
+  const PackedArray* asPackedArray() const {
+    return isPackedArray() ? content_.asPackedArray : nullptr;
+  }
+
   CollectionData* asCollection() {
     return isCollection() ? &content_.asCollection : 0;
   }
@@ -125,8 +144,11 @@ class VariantData {
       case VALUE_IS_SIGNED_INTEGER:
         return static_cast<T>(content_.asSignedInteger);
       case VALUE_IS_LINKED_STRING:
+        return parseNumber<T>(content_.asLinkedString);
       case VALUE_IS_OWNED_STRING:
         return parseNumber<T>(content_.asOwnedString->data);
+      case VALUE_IS_TINY_STRING:
+        return parseNumber<T>(content_.asTinyString);
       case VALUE_IS_FLOAT:
         return static_cast<T>(content_.asFloat);
       default:
@@ -148,6 +170,8 @@ class VariantData {
         return parseNumber<T>(content_.asLinkedString);
       case VALUE_IS_OWNED_STRING:
         return parseNumber<T>(content_.asOwnedString->data);
+      case VALUE_IS_TINY_STRING:
+        return parseNumber<T>(content_.asTinyString);
       case VALUE_IS_FLOAT:
         return convertNumber<T>(content_.asFloat);
       default:
@@ -180,19 +204,48 @@ class VariantData {
       case VALUE_IS_OWNED_STRING:
         return JsonString(content_.asOwnedString->data,
                           content_.asOwnedString->length, JsonString::Copied);
+      case VALUE_IS_TINY_STRING:
+        return asTinyString();
       default:
         return JsonString();
     }
   }
 
-  VariantData* getElement(size_t index,
-                          const ResourceManager* resources) const {
+  // Returns the element at the specified index. The elements of a packed
+  // array aren't stored in slots, so it copies them to packedElement, which
+  // must outlive the returned pointer; the array stays packed.
+  VariantData* getElement(size_t index, const ResourceManager* resources,
+                          VariantData* packedElement) const {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (isPackedArray()) {
+      auto packed = content_.asPackedArray;
+      if (index >= packed->size)
+        return nullptr;
+      NumberSetter setter = {packedElement};
+      packed->accept(index, setter);
+      return packedElement;
+    }
+#else
+    (void)packedElement;
+#endif
     return ArrayData::getElement(asArray(), index, resources);
   }
 
   static VariantData* getElement(const VariantData* var, size_t index,
-                                 const ResourceManager* resources) {
-    return var != 0 ? var->getElement(index, resources) : 0;
+                                 const ResourceManager* resources,
+                                 VariantData* packedElement) {
+    return var != 0 ? var->getElement(index, resources, packedElement) : 0;
+  }
+
+  // Same as getElement(), but unpacks a packed array, to return the slot of
+  // the element, which can then be modified
+  VariantData* getUnpackedElement(size_t index, ResourceManager* resources) {
+    return ArrayData::getElement(asArray(resources), index, resources);
+  }
+
+  static VariantData* getUnpackedElement(VariantData* var, size_t index,
+                                         ResourceManager* resources) {
+    return var != 0 ? var->getUnpackedElement(index, resources) : 0;
   }
 
   template <typename TAdaptedString>
@@ -210,7 +263,7 @@ class VariantData {
   }
 
   VariantData* getOrAddElement(size_t index, ResourceManager* resources) {
-    auto array = isNull() ? &toArray() : asArray();
+    auto array = isNull() ? &toArray() : asArray(resources);
     if (!array)
       return nullptr;
     return array->getOrAddElement(index, resources);
@@ -260,6 +313,10 @@ class VariantData {
     return type() == VALUE_IS_NULL;
   }
 
+  bool isPackedArray() const {
+    return ARDUINOJSON_ENABLE_PACKED_ARRAYS && type() == VALUE_IS_PACKED_ARRAY;
+  }
+
   static bool isNull(const VariantData* var) {
     if (!var)
       return true;
@@ -271,13 +328,16 @@ class VariantData {
   }
 
   bool isString() const {
-    return type() == VALUE_IS_LINKED_STRING || type() == VALUE_IS_OWNED_STRING;
+    return type() == VALUE_IS_LINKED_STRING ||
+           type() == VALUE_IS_OWNED_STRING || type() == VALUE_IS_TINY_STRING;
   }
 
   size_t nesting(const ResourceManager* resources) const {
     auto collection = asCollection();
     if (collection)
       return collection->nesting(resources);
+    else if (isPackedArray())
+      return 1;
     else
       return 0;
   }
@@ -290,7 +350,7 @@ class VariantData {
   }
 
   void removeElement(size_t index, ResourceManager* resources) {
-    ArrayData::removeElement(asArray(), index, resources);
+    ArrayData::removeElement(asArray(resources), index, resources);
   }
 
   static void removeElement(VariantData* var, size_t index,
@@ -406,6 +466,9 @@ class VariantData {
       return;
     }
 
+    if (setTinyString(value))
+      return;
+
     auto dup = resources->saveString(value);
     if (dup)
       setOwnedString(dup);
@@ -431,7 +494,29 @@ class VariantData {
     content_.asOwnedString = s;
   }
 
+  // Returns true if setTinyString() accepts a string of this length
+  static bool fitsTinyString(size_t length) {
+    return ARDUINOJSON_ENABLE_TINY_STRINGS && length < tinyStringSize;
+  }
+
+  // Copies the string in the variant, if it's short enough.
+  // Returns false if it's not.
+  template <typename TAdaptedString>
+  bool setTinyString(TAdaptedString value) {
+    const size_t capacity = tinyStringSize - 1;
+    size_t n = value.size();
+    if (!fitsTinyString(n))
+      return false;
+    setType(VALUE_IS_TINY_STRING);
+    stringGetChars(value, content_.asTinyString, n);
+    content_.asTinyString[n] = 0;
+    content_.asTinyString[capacity] = char(capacity - n);
+    return true;
+  }
+
   size_t size(const ResourceManager* resources) const {
+    if (isPackedArray())
+      return content_.asPackedArray->size;
     return isCollection() ? content_.asCollection.size(resources) : 0;
   }
 
@@ -477,7 +562,180 @@ class VariantData {
     return flags_ & VALUE_MASK;
   }
 
+  // Moves the elements of a packed array to slots, so that they can be
+  // modified like the elements of the other arrays; does nothing if the
+  // variant isn't a packed array. The reads don't need it (see getElement()).
+  // Returns false if the allocation fails, in which case the array stays
+  // packed.
+  bool unpackArray(ResourceManager* resources) {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (!isPackedArray())
+      return true;
+    auto packed = content_.asPackedArray;
+    ArrayData array;
+    for (size_t i = 0; i < packed->size; i++) {
+      auto element = array.addElement(resources);
+      if (!element) {
+        array.clear(resources);
+        return false;
+      }
+      NumberSetter setter = {element};
+      packed->accept(i, setter);
+    }
+    resources->destroyPackedArray(packed);
+    setType(VALUE_IS_ARRAY);
+    new (&content_.asArray) ArrayData(array);
+#else
+    (void)resources;
+#endif
+    return true;
+  }
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // Moves the elements of the array to a packed array, if they are numbers
+  // of the same kind; otherwise, or if the allocation fails, returns false
+  // and leaves the array unchanged.
+  bool packArray(ResourceManager* resources) {
+    auto array = asArray();
+    ARDUINOJSON_ASSERT(array != nullptr);
+    auto it = array->createIterator(resources);
+    if (it.done())
+      return false;
+    uint8_t type = it->packedType();
+    size_t n = 0;
+    for (; !it.done(); it.next(resources)) {
+      type = PackedArray::merge(type, it->packedType());
+      n++;
+    }
+    if (type == PackedArray::Invalid)
+      return false;
+    auto packed = resources->createPackedArray(type, n * 2);
+    if (!packed)
+      return false;
+    for (it = array->createIterator(resources); !it.done(); it.next(resources))
+      it->addTo(packed);
+    array->clear(resources);
+    setType(VALUE_IS_PACKED_ARRAY);
+    content_.asPackedArray = packed;
+    return true;
+  }
+
+  // Appends a number to a packed array, widening or growing it if needed.
+  // If the packed array can't store the value, it's unpacked first, so the
+  // caller must check isArray() before adding another element.
+  // Returns false if the allocation fails.
+  bool addPackedElement(const VariantData& value, ResourceManager* resources) {
+    ARDUINOJSON_ASSERT(isPackedArray());
+    auto packed = content_.asPackedArray;
+    uint8_t type = PackedArray::merge(packed->type, value.packedType());
+    if (type == PackedArray::Invalid) {
+      if (!unpackArray(resources))
+        return false;
+      auto element = content_.asArray.addElement(resources);
+      if (!element)
+        return false;
+      element->content_ = value.content_;
+      element->setType(value.type());
+      return true;
+    }
+    if (type != packed->type || packed->full()) {
+      size_t capacity = packed->capacity;
+      if (packed->full())
+        capacity *= 2;
+      packed = resources->resizePackedArray(packed, type, capacity);
+      if (!packed)
+        return false;
+      content_.asPackedArray = packed;
+    }
+    value.addTo(packed);
+    return true;
+  }
+
+  // Releases the unused capacity of a packed array
+  void shrinkPackedArray(ResourceManager* resources) {
+    ARDUINOJSON_ASSERT(isPackedArray());
+    auto packed = content_.asPackedArray;
+    if (packed->full())
+      return;
+    packed = resources->resizePackedArray(packed, packed->type, packed->size);
+    if (packed)
+      content_.asPackedArray = packed;
+  }
+
+  // Returns the type of packed array that can store this value
+  uint8_t packedType() const {
+    switch (type()) {
+      case VALUE_IS_SIGNED_INTEGER:
+        return PackedArray::typeOf(content_.asSignedInteger);
+      case VALUE_IS_UNSIGNED_INTEGER:
+        return PackedArray::typeOf(content_.asUnsignedInteger);
+      case VALUE_IS_FLOAT:
+        return PackedArray::typeOf(content_.asFloat);
+      default:
+        return PackedArray::Invalid;
+    }
+  }
+
+  // Copies a packed array from another document
+  bool setPackedArray(const PackedArray& src, ResourceManager* resources) {
+    release(resources);
+    setNull();
+    auto packed = resources->createPackedArray(src.type, src.size);
+    if (!packed)
+      return false;
+    memcpy(packed->elements, src.elements,
+           src.size * PackedArray::elementSize(src.type));
+    packed->size = src.size;
+    setType(VALUE_IS_PACKED_ARRAY);
+    content_.asPackedArray = packed;
+    return true;
+  }
+#endif
+
  private:
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // Sets a variant to the elements of a PackedArray (see unpackArray())
+  struct NumberSetter {
+    typedef void result_type;
+
+    VariantData* variant;
+
+    void visit(JsonFloat value) {
+      variant->setFloat(value);
+    }
+
+    void visit(JsonInteger value) {
+      variant->setInteger(value);
+    }
+
+    void visit(JsonUInt value) {
+      variant->setInteger(value);
+    }
+  };
+
+  // The array must be able to store the value (see packedType())
+  void addTo(PackedArray* array) const {
+    switch (type()) {
+      case VALUE_IS_SIGNED_INTEGER:
+        array->add(content_.asSignedInteger);
+        break;
+      case VALUE_IS_UNSIGNED_INTEGER:
+        array->add(JsonInteger(content_.asUnsignedInteger));
+        break;
+      default:
+        array->add(content_.asFloat);
+        break;
+    }
+  }
+#endif
+
+  JsonString asTinyString() const {
+    const size_t capacity = tinyStringSize - 1;
+    return JsonString(content_.asTinyString,
+                      capacity - size_t(content_.asTinyString[capacity]),
+                      JsonString::Copied);
+  }
+
   void release(ResourceManager* resources) {
     if (flags_ & OWNED_VALUE_BIT)
       resources->dereferenceString(content_.asOwnedString->data);
@@ -485,6 +743,11 @@ class VariantData {
     auto collection = asCollection();
     if (collection)
       collection->clear(resources);
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (isPackedArray())
+      resources->destroyPackedArray(content_.asPackedArray);
+#endif
   }
 
   void setType(uint8_t t) {
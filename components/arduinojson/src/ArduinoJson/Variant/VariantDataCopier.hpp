@@ -0,0 +1,107 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2024, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Misc/SerializedValue.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+#include <ArduinoJson/Variant/VariantDataVisitor.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Copies a VariantData to another ResourceManager, allocating the slots in
+// the order of a depth-first traversal (see JsonDocument::compact()).
+// Unlike JsonVariant::set(), it appends the members without looking them up,
+// so it's linear and keeps the duplicate keys.
+class VariantDataCopier : public VariantDataVisitor<bool> {
+ public:
+  VariantDataCopier(VariantData* dst, const ResourceManager* srcResources,
+                    ResourceManager* dstResources)
+      : dst_(dst), srcResources_(srcResources), dstResources_(dstResources) {}
+
+  bool visit(const ArrayData& src) {
+    auto& array = dst_->toArray();
+    for (auto it = src.createIterator(srcResources_); !it.done();
+         it.next(srcResources_)) {
+      auto element = array.addElement(dstResources_);
+      if (!element || !copy(element, *it))
+        return false;
+    }
+    return true;
+  }
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  bool visit(const PackedArray& src) {
+    return dst_->setPackedArray(src, dstResources_);
+  }
+#endif
+
+  bool visit(const ObjectData& src) {
+    auto& object = dst_->toObject();
+    for (auto it = src.createIterator(srcResources_); !it.done();
+         it.next(srcResources_)) {
+      auto key = JsonString(it.key(), keyOwnership(it));
+      auto member = object.addMember(adaptString(key), dstResources_);
+      if (!member || !copy(member, *it))
+        return false;
+    }
+    return true;
+  }
+
+  bool visit(JsonString src) {
+    dst_->setString(adaptString(src), dstResources_);
+    return dst_->isString();
+  }
+
+  bool visit(RawString src) {
+    dst_->setRawString(src, dstResources_);
+    return !dst_->isNull();
+  }
+
+  bool visit(JsonFloat src) {
+    dst_->setFloat(src);
+    return true;
+  }
+
+  bool visit(JsonInteger src) {
+    dst_->setInteger(src);
+    return true;
+  }
+
+  bool visit(JsonUInt src) {
+    dst_->setInteger(src);
+    return true;
+  }
+
+  bool visit(bool src) {
+    dst_->setBoolean(src);
+    return true;
+  }
+
+  bool visit(nullptr_t) {
+    return true;
+  }
+
+ private:
+  // Links the keys of the SymbolTable only if both documents share it
+  JsonString::Ownership keyOwnership(ObjectData::iterator it) const {
+    if (it.ownsKey())
+      return JsonString::Copied;
+    if (srcResources_->symbolTable() == dstResources_->symbolTable())
+      return JsonString::Linked;
+    return srcResources_->unownedKeyOwnership();
+  }
+
+  bool copy(VariantData* dst, const VariantData& src) {
+    VariantDataCopier copier(dst, srcResources_, dstResources_);
+    return src.accept(copier);
+  }
+
+  VariantData* dst_;
+  const ResourceManager* srcResources_;
+  ResourceManager* dstResources_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
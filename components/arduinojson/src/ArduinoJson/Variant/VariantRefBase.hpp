@@ -49,7 +49,7 @@ class VariantRefBase : public VariantTag {
 
   typename enable_if<!ConverterNeedsWriteableRef<T>::value, T>::type as()
       const {
-    return Converter<T>::fromJson(getVariantConst());
+    return Converter<T>::fromJson(derived().getVariantConst());
   }
 
   // Casts the value to the specified type.
@@ -93,7 +93,7 @@ class VariantRefBase : public VariantTag {
   FORCE_INLINE
       typename enable_if<!ConverterNeedsWriteableRef<T>::value, bool>::type
       is() const {
-    return Converter<T>::checkJson(getVariantConst());
+    return Converter<T>::checkJson(derived().getVariantConst());
   }
 
   // Copies the specified value.
@@ -264,12 +264,18 @@ class VariantRefBase : public VariantTag {
     return VariantAttorney::getOrCreateData(derived());
   }
 
-  FORCE_INLINE ArduinoJson::JsonVariant getVariant() const;
+  // ElementProxy hides the two functions below, because its getData() returns
+  // a copy of the elements of the packed arrays.
+  VariantData* getWritableData() const {
+    return getData();
+  }
 
   FORCE_INLINE ArduinoJson::JsonVariantConst getVariantConst() const {
     return ArduinoJson::JsonVariantConst(getData(), getResourceManager());
   }
 
+  FORCE_INLINE ArduinoJson::JsonVariant getVariant() const;
+
   ArduinoJson::JsonVariant getOrCreateVariant() const;
 };
 
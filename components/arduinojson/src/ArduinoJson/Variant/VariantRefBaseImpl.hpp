@@ -92,7 +92,7 @@ VariantRefBase<TDerived>::containsKey(TChar* key) const {
 
 template <typename TDerived>
 inline JsonVariant VariantRefBase<TDerived>::getVariant() const {
-  return JsonVariant(getData(), getResourceManager());
+  return JsonVariant(derived().getWritableData(), getResourceManager());
 }
 
 template <typename TDerived>